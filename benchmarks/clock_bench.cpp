@@ -0,0 +1,94 @@
+#include <nitro/log/attribute/timestamp.hpp>
+#include <nitro/log/clock/coarse.hpp>
+#include <nitro/log/clock/tsc.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace detail
+{
+
+// keeps the compiler from dropping the reads of the clocks
+inline void clobber()
+{
+#ifdef _MSC_VER
+    _ReadWriteBarrier();
+#else
+    asm volatile("" : : : "memory");
+#endif
+}
+
+template <typename T>
+inline void use(const T& value)
+{
+#ifdef _MSC_VER
+    volatile T sink = value;
+    (void)sink;
+#else
+    asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+} // namespace detail
+
+template <typename F>
+void run(const char* name, std::size_t iterations, F f)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0; i < iterations; ++i)
+    {
+        f();
+        detail::clobber();
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+    std::printf("%-44s %10.2f\n", name, static_cast<double>(ns) / iterations);
+}
+
+template <typename Clock>
+void run_attribute(const char* name, std::size_t iterations)
+{
+    nitro::log::timestamp_clock_attribute<Clock> attribute;
+    run(name, iterations, [&attribute]() {
+        attribute.timestamp_clock_set_time();
+        detail::use(attribute);
+    });
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+    using nitro::log::clock::coarse_steady_clock;
+    using nitro::log::clock::coarse_system_clock;
+    using nitro::log::clock::tsc_clock;
+
+    // calibrates the tsc_clock outside of the measurements
+    tsc_clock::now();
+
+    std::printf("%-44s %10s\n", "timestamp capture", "ns/call");
+
+    run_attribute<std::chrono::high_resolution_clock>("high_resolution_clock", iterations);
+    run_attribute<std::chrono::system_clock>("system_clock", iterations);
+    run_attribute<std::chrono::steady_clock>("steady_clock", iterations);
+    run_attribute<coarse_system_clock>("clock::coarse_system_clock", iterations);
+    run_attribute<coarse_steady_clock>("clock::coarse_steady_clock", iterations);
+    run_attribute<tsc_clock>("clock::tsc_clock", iterations);
+
+    std::printf("\n%-44s %10s\n", "conversion at formatting", "ns/call");
+
+    nitro::log::timestamp_clock_attribute<tsc_clock> attribute;
+    attribute.timestamp_clock_set_time();
+    run("clock::tsc_clock ticks to system_clock", iterations,
+        [&attribute]() { detail::use(attribute.timestamp()); });
+
+    return 0;
+}
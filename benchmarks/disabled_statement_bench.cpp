@@ -0,0 +1,119 @@
+#include <nitro/log/attribute/severity.hpp>
+#include <nitro/log/attribute/timestamp.hpp>
+#include <nitro/log/filter/severity_filter.hpp>
+#include <nitro/log/filter/tag_severity_filter.hpp>
+#include <nitro/log/log.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace detail
+{
+
+typedef nitro::log::record<nitro::log::tag_attribute, nitro::log::message_attribute,
+                           nitro::log::severity_attribute, nitro::log::timestamp_attribute>
+    record;
+
+template <typename Record>
+class message_formater
+{
+public:
+    std::string format(Record& r)
+    {
+        return r.message();
+    }
+};
+
+class null_sink
+{
+public:
+    void sink(nitro::log::severity_level, nitro::lang::string_ref)
+    {
+    }
+};
+
+template <typename Record>
+using log_filter = nitro::log::filter::severity_filter<Record>;
+
+template <typename Record>
+using tag_filter = nitro::log::filter::tag_severity_filter<Record>;
+
+// keeps the compiler from hoisting the filter checks out of the loop
+inline void clobber()
+{
+#ifdef _MSC_VER
+    _ReadWriteBarrier();
+#else
+    asm volatile("" : : : "memory");
+#endif
+}
+
+std::string expensive(std::size_t i)
+{
+    return std::to_string(i) + std::string(100, 'x');
+}
+} // namespace detail
+
+using logging = nitro::log::logger<detail::record, detail::message_formater, detail::null_sink,
+                                   detail::log_filter>;
+
+using tag_logging = nitro::log::logger<detail::record, detail::message_formater,
+                                       detail::null_sink, detail::tag_filter>;
+
+template <typename F>
+void run(const char* name, std::size_t iterations, F f)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0; i < iterations; ++i)
+    {
+        f(i);
+        detail::clobber();
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+    std::printf("%-42s %10.2f\n", name, static_cast<double>(ns) / iterations);
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+    detail::log_filter<detail::record>::set_severity(nitro::log::severity_level::info);
+    detail::tag_filter<detail::record>::configure("info,net=trace");
+
+    std::printf("%-42s %10s\n", "disabled statement", "ns/call");
+
+    run("logging::debug() << i", iterations, [](std::size_t i) { logging::debug() << i; });
+
+    run("logging::debug(\"tag\") << expensive(i)", iterations / 10,
+        [](std::size_t i) { logging::debug("tag") << detail::expensive(i); });
+
+    run("NITRO_LOG(logging, debug) << expensive(i)", iterations,
+        [](std::size_t i) { NITRO_LOG(logging, debug) << detail::expensive(i); });
+
+    run("NITRO_LOG_TAG(tag_logging, debug, \"db\")", iterations, [](std::size_t i) {
+        NITRO_LOG_TAG(tag_logging, debug, "db") << detail::expensive(i);
+    });
+
+    run("tag_logging::debug(\"db\") << i", iterations,
+        [](std::size_t i) { tag_logging::debug("db") << i; });
+
+    // disables the statement below by its call site
+    nitro::log::call_site_registry::instance().set_mode(std::string(__FILE__) + ":" +
+                                                            std::to_string(__LINE__ + 4),
+                                                        nitro::log::call_site_mode::disabled);
+
+    run("NITRO_LOG(logging, info), call site off", iterations,
+        [](std::size_t i) { NITRO_LOG(logging, info) << detail::expensive(i); });
+
+    return 0;
+}
@@ -0,0 +1,74 @@
+#include <nitro/log/attribute/severity.hpp>
+#include <nitro/log/attribute/timestamp.hpp>
+#include <nitro/log/filter/null_filter.hpp>
+#include <nitro/log/log.hpp>
+#include <nitro/log/sink/logfile.hpp>
+#include <nitro/log/sink/mmap_ring.hpp>
+#include <nitro/log/sink/rotating_file.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ostream>
+#include <string>
+
+namespace detail
+{
+
+typedef nitro::log::record<nitro::log::message_attribute, nitro::log::severity_attribute,
+                           nitro::log::timestamp_attribute>
+    record;
+
+template <typename Record>
+class line_formater
+{
+public:
+    void format(Record& r, std::ostream& s)
+    {
+        s << r.message() << '\n';
+    }
+};
+
+template <typename Sink>
+using logging =
+    nitro::log::logger<record, line_formater, Sink, nitro::log::filter::null_filter>;
+} // namespace detail
+
+template <typename Logging>
+void run(const char* name, std::size_t iterations)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0; i < iterations; ++i)
+    {
+        Logging::info() << "a typical log line with a number " << i << " and some more text";
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+    std::printf("%-24s %12.1f\n", name, static_cast<double>(ns) / iterations);
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    std::string directory = argc > 2 ? argv[2] : ".";
+
+    nitro::log::sink::Logfile::log_file() = directory + "/file_sink_bench_logfile.log";
+
+    using rotating = nitro::log::sink::rotating_file<>;
+    rotating::config().path = directory + "/file_sink_bench_rotating.log";
+    rotating::config().max_file_size = 64 << 20;
+
+    using ring = nitro::log::sink::mmap_ring<>;
+    ring::config().path = directory + "/file_sink_bench.ring";
+
+    std::printf("%-24s %12s\n", "sink", "ns/record");
+
+    run<detail::logging<nitro::log::sink::Logfile>>("sink::Logfile", iterations);
+    run<detail::logging<rotating>>("sink::rotating_file", iterations);
+    run<detail::logging<ring>>("sink::mmap_ring", iterations);
+
+    return 0;
+}
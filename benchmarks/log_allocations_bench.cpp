@@ -0,0 +1,172 @@
+#include <nitro/log/attribute/severity.hpp>
+#include <nitro/log/attribute/timestamp.hpp>
+#include <nitro/log/filter/severity_filter.hpp>
+#include <nitro/log/log.hpp>
+
+#ifndef NITRO_BENCH_LEGACY
+#include <nitro/log/filter/metered.hpp>
+#include <nitro/log/formatter/binary.hpp>
+#include <nitro/log/formatter/json.hpp>
+#include <nitro/log/formatter/metered.hpp>
+#include <nitro/log/formatter/text.hpp>
+#include <nitro/log/sink/metered.hpp>
+#endif
+
+#include <nitro/format.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <ostream>
+#include <string>
+
+// GCC does not see that the replaced operator new below uses malloc() and warns about the free()
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+namespace
+{
+std::atomic<std::size_t> allocations{ 0 };
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace detail
+{
+
+typedef nitro::log::record<nitro::log::tag_attribute, nitro::log::message_attribute,
+                           nitro::log::severity_attribute, nitro::log::timestamp_attribute>
+    record;
+
+// formats like the formatters in the tests, returning a new std::string per record
+template <typename Record>
+class string_formater
+{
+public:
+    std::string format(Record& r)
+    {
+        return nitro::format("[{}][{}]: {}\n") % r.timestamp().time_since_epoch().count() %
+               r.severity() % r.message();
+    }
+};
+
+// writes the record into the reused buffer of the logger
+template <typename Record>
+class stream_formater
+{
+public:
+    void format(Record& r, std::ostream& s)
+    {
+        s << '[' << r.timestamp().time_since_epoch().count() << "][" << r.severity()
+          << "]: " << r.message() << '\n';
+    }
+};
+
+class null_sink
+{
+public:
+    template <typename String>
+    void sink(nitro::log::severity_level, const String&)
+    {
+    }
+};
+
+template <typename Record>
+using log_filter = nitro::log::filter::severity_filter<Record>;
+} // namespace detail
+
+template <typename Logging>
+void run(const char* name, std::size_t iterations)
+{
+    auto log_once = [](std::size_t i) { Logging::info() << "iteration " << i << " of " << 42; };
+
+    for (std::size_t i = 0; i < 1000; ++i)
+    {
+        log_once(i);
+    }
+
+    auto before = allocations.load();
+    auto start = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0; i < iterations; ++i)
+    {
+        log_once(i);
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    auto after = allocations.load();
+
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+    std::printf("%-28s %12.2f %12.1f\n", name, static_cast<double>(after - before) / iterations,
+                static_cast<double>(ns) / iterations);
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+    using string_logging = nitro::log::logger<detail::record, detail::string_formater,
+                                              detail::null_sink, detail::log_filter>;
+
+    std::printf("%-28s %12s %12s\n", "formatter", "allocs/call", "ns/call");
+
+    run<string_logging>("std::string format(r)", iterations);
+
+#ifndef NITRO_BENCH_LEGACY
+    using stream_logging = nitro::log::logger<detail::record, detail::stream_formater,
+                                              detail::null_sink, detail::log_filter>;
+
+    run<stream_logging>("format(r, std::ostream&)", iterations);
+
+    using text_logging =
+        nitro::log::logger<detail::record, nitro::log::formatter::text_formatter,
+                           detail::null_sink, detail::log_filter>;
+
+    run<text_logging>("formatter::text_formatter", iterations);
+
+    using binary_logging =
+        nitro::log::logger<detail::record, nitro::log::formatter::binary_formatter,
+                           detail::null_sink, detail::log_filter>;
+
+    run<binary_logging>("formatter::binary_formatter", iterations);
+
+    using json_logging =
+        nitro::log::logger<detail::record, nitro::log::formatter::json_formatter,
+                           detail::null_sink, detail::log_filter>;
+
+    run<json_logging>("formatter::json_formatter", iterations);
+
+    using metered_logging =
+        nitro::log::logger<detail::record,
+                           nitro::log::formatter::metered<
+                               nitro::log::formatter::text_formatter>::type,
+                           nitro::log::sink::metered<detail::null_sink>,
+                           nitro::log::filter::metered<detail::log_filter>::type>;
+
+    run<metered_logging>("metered text_formatter", iterations);
+#endif
+
+    return 0;
+}
@@ -0,0 +1,519 @@
+// Throughput and latency of log statements for every shipped sink and 1..N threads
+//
+// usage: Nitro.log_throughput_bench [--records=N] [--threads=N] [--sinks=LIST] [--json=FILE]
+//                                   [--csv=FILE] [--logfile=FILE]
+//
+//   --records  records each thread logs per measurement (default 100000)
+//   --threads  the highest thread count, it runs 1, 2, 4, ... up to this (default 4)
+//   --sinks    comma separated list of null, stdout, stdout_mt, logfile, syslog and
+//              syslog_datagram, or "all". The default is all but the syslog sinks, as they fill
+//              the system log.
+//   --json     writes the results as an array of JSON objects to FILE, "-" for stderr
+//   --csv      writes the results as CSV to FILE, "-" for stderr
+//   --logfile  the file of the logfile sink, it is removed at the end (default
+//              log_throughput_bench.log)
+//
+// Every statement is measured three times: enabled, filtered at runtime by the severity filter
+// and filtered at compile-time by NITRO_LOG_MIN_SEVERITY. The table goes to stderr, stdout is
+// redirected to the null device, so the stdout sinks do not measure the terminal.
+//
+// Records/second are measured without timing single calls. The latency percentiles come from a
+// second pass, in which every call is timed with std::chrono::steady_clock, whose overhead is
+// included in them.
+
+// the build defines it from NITRO_LOG_LEVEL, but the compile-time case needs trace to be removed
+#undef NITRO_LOG_MIN_SEVERITY
+#define NITRO_LOG_MIN_SEVERITY debug
+
+#include <nitro/log/attribute/severity.hpp>
+#include <nitro/log/attribute/timestamp.hpp>
+#include <nitro/log/filter/severity_filter.hpp>
+#include <nitro/log/formatter/text.hpp>
+#include <nitro/log/log.hpp>
+#include <nitro/log/sink/logfile.hpp>
+#include <nitro/log/sink/null.hpp>
+#include <nitro/log/sink/stdout.hpp>
+#include <nitro/log/sink/stdout_mt.hpp>
+
+#ifndef _WIN32
+#include <nitro/log/sink/syslog.hpp>
+#include <nitro/log/sink/syslog_datagram.hpp>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+// GCC does not see that the replaced operator new below uses malloc() and warns about the free()
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+namespace
+{
+std::atomic<std::size_t> allocations{ 0 };
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace detail
+{
+
+typedef nitro::log::record<nitro::log::tag_attribute, nitro::log::message_attribute,
+                           nitro::log::severity_attribute, nitro::log::timestamp_attribute>
+    record;
+
+template <typename Record>
+using log_filter = nitro::log::filter::severity_filter<Record>;
+
+template <typename Sink>
+using logging =
+    nitro::log::logger<record, nitro::log::formatter::text_formatter, Sink, log_filter>;
+
+struct options
+{
+    std::size_t records = 100000;
+    std::size_t max_threads = 4;
+    std::set<std::string> sinks = { "null", "stdout", "stdout_mt", "logfile" };
+    std::string json;
+    std::string csv;
+    std::string logfile = "log_throughput_bench.log";
+};
+
+struct result
+{
+    std::string statement;
+    std::string sink;
+    std::size_t threads;
+    std::size_t records;
+    double records_per_second;
+    double allocations_per_record;
+    double p50_ns;
+    double p99_ns;
+    double p999_ns;
+};
+
+enum class statement
+{
+    enabled,
+    runtime_filtered,
+    compile_time_filtered
+};
+
+const char* name(statement s)
+{
+    switch (s)
+    {
+    case statement::enabled:
+        return "enabled";
+    case statement::runtime_filtered:
+        return "runtime_filtered";
+    default:
+        return "compile_time_filtered";
+    }
+}
+
+// the severity filter lets info through, so debug is filtered at runtime and trace at
+// compile-time, as it is below NITRO_LOG_MIN_SEVERITY
+template <typename Logging>
+inline void log_once(statement s, std::size_t i)
+{
+    switch (s)
+    {
+    case statement::enabled:
+        NITRO_LOG(Logging, info) << "a typical log line with a number " << i << " and "
+                                 << 3.25 << " in it";
+        break;
+    case statement::runtime_filtered:
+        NITRO_LOG(Logging, debug) << "a typical log line with a number " << i << " and "
+                                  << 3.25 << " in it";
+        break;
+    default:
+        NITRO_LOG(Logging, trace) << "a typical log line with a number " << i << " and "
+                                  << 3.25 << " in it";
+        break;
+    }
+}
+
+// runs f(thread) on the given number of threads, which start at the same time
+template <typename F>
+double on_threads(std::size_t thread_count, F f)
+{
+    std::atomic<std::size_t> ready{ 0 };
+    std::atomic<bool> go{ false };
+
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < thread_count; ++t)
+    {
+        threads.emplace_back([&, t]() {
+            ready.fetch_add(1);
+            while (!go.load())
+            {
+                std::this_thread::yield();
+            }
+            f(t);
+        });
+    }
+
+    while (ready.load() != thread_count)
+    {
+        std::this_thread::yield();
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    go.store(true);
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+double percentile(std::vector<std::int64_t>& latencies, double p)
+{
+    if (latencies.empty())
+    {
+        return 0;
+    }
+
+    auto index = static_cast<std::size_t>(p * (latencies.size() - 1));
+    std::nth_element(latencies.begin(), latencies.begin() + index, latencies.end());
+    return static_cast<double>(latencies[index]);
+}
+
+template <typename Logging>
+result measure(statement s, const char* sink, std::size_t thread_count, std::size_t records)
+{
+    // warms up the thread-local buffers of the main thread and the static state of the sink
+    for (std::size_t i = 0; i < 1000; ++i)
+    {
+        log_once<Logging>(s, i);
+    }
+
+    auto allocations_before = allocations.load();
+
+    auto seconds = on_threads(thread_count, [s, records](std::size_t) {
+        for (std::size_t i = 0; i < records; ++i)
+        {
+            log_once<Logging>(s, i);
+        }
+    });
+
+    auto allocations_after = allocations.load();
+
+    std::vector<std::vector<std::int64_t>> latencies(thread_count,
+                                                     std::vector<std::int64_t>(records));
+
+    on_threads(thread_count, [s, records, &latencies](std::size_t t) {
+        auto& mine = latencies[t];
+        for (std::size_t i = 0; i < records; ++i)
+        {
+            auto start = std::chrono::steady_clock::now();
+            log_once<Logging>(s, i);
+            auto end = std::chrono::steady_clock::now();
+
+            mine[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        }
+    });
+
+    std::vector<std::int64_t> all;
+    all.reserve(thread_count * records);
+    for (const auto& l : latencies)
+    {
+        all.insert(all.end(), l.begin(), l.end());
+    }
+
+    auto total = static_cast<double>(thread_count * records);
+
+    result res;
+    res.statement = name(s);
+    res.sink = sink;
+    res.threads = thread_count;
+    res.records = thread_count * records;
+    res.records_per_second = total / seconds;
+    res.allocations_per_record =
+        static_cast<double>(allocations_after - allocations_before) / total;
+    res.p50_ns = percentile(all, 0.5);
+    res.p99_ns = percentile(all, 0.99);
+    res.p999_ns = percentile(all, 0.999);
+    return res;
+}
+
+template <typename Sink>
+void measure_sink(const char* sink, const options& opts, std::vector<result>& results)
+{
+    if (!opts.sinks.count(sink))
+    {
+        return;
+    }
+
+    for (auto s : { statement::enabled, statement::runtime_filtered,
+                    statement::compile_time_filtered })
+    {
+        for (std::size_t threads = 1;; threads = std::min(threads * 2, opts.max_threads))
+        {
+            results.push_back(measure<logging<Sink>>(s, sink, threads, opts.records));
+
+            const auto& r = results.back();
+            std::fprintf(stderr, "%-22s %-15s %8zu %14.0f %10.2f %10.0f %10.0f %10.0f\n",
+                         r.statement.c_str(), r.sink.c_str(), r.threads, r.records_per_second,
+                         r.allocations_per_record, r.p50_ns, r.p99_ns, r.p999_ns);
+
+            if (threads == opts.max_threads)
+            {
+                break;
+            }
+        }
+    }
+}
+
+std::FILE* open_report(const std::string& path)
+{
+    if (path == "-")
+    {
+        return stderr;
+    }
+    return std::fopen(path.c_str(), "w");
+}
+
+void close_report(std::FILE* file)
+{
+    if (file != stderr)
+    {
+        std::fclose(file);
+    }
+}
+
+bool write_json(const std::string& path, const std::vector<result>& results)
+{
+    auto file = open_report(path);
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    std::fprintf(file, "[\n");
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        const auto& r = results[i];
+        std::fprintf(file,
+                     "  {\"statement\": \"%s\", \"sink\": \"%s\", \"threads\": %zu, "
+                     "\"records\": %zu, \"records_per_second\": %.1f, "
+                     "\"allocations_per_record\": %.3f, \"p50_ns\": %.0f, \"p99_ns\": %.0f, "
+                     "\"p999_ns\": %.0f}%s\n",
+                     r.statement.c_str(), r.sink.c_str(), r.threads, r.records,
+                     r.records_per_second, r.allocations_per_record, r.p50_ns, r.p99_ns,
+                     r.p999_ns, i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(file, "]\n");
+
+    close_report(file);
+    return true;
+}
+
+bool write_csv(const std::string& path, const std::vector<result>& results)
+{
+    auto file = open_report(path);
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    std::fprintf(file, "statement,sink,threads,records,records_per_second,"
+                       "allocations_per_record,p50_ns,p99_ns,p999_ns\n");
+    for (const auto& r : results)
+    {
+        std::fprintf(file, "%s,%s,%zu,%zu,%.1f,%.3f,%.0f,%.0f,%.0f\n", r.statement.c_str(),
+                     r.sink.c_str(), r.threads, r.records, r.records_per_second,
+                     r.allocations_per_record, r.p50_ns, r.p99_ns, r.p999_ns);
+    }
+
+    close_report(file);
+    return true;
+}
+
+bool parse_size(const char* value, std::size_t& out)
+{
+    char* end;
+    auto parsed = std::strtoull(value, &end, 10);
+    if (*value == '\0' || *end != '\0' || parsed == 0)
+    {
+        return false;
+    }
+    out = static_cast<std::size_t>(parsed);
+    return true;
+}
+
+bool parse_sinks(const std::string& value, std::set<std::string>& sinks)
+{
+    static const std::set<std::string> known = { "null",    "stdout", "stdout_mt",
+                                                 "logfile", "syslog", "syslog_datagram" };
+
+    sinks.clear();
+    if (value == "all")
+    {
+        sinks = known;
+        return true;
+    }
+
+    std::size_t begin = 0;
+    while (begin <= value.size())
+    {
+        auto end = std::min(value.find(',', begin), value.size());
+        auto sink = value.substr(begin, end - begin);
+        if (!known.count(sink))
+        {
+            return false;
+        }
+        sinks.insert(sink);
+        begin = end + 1;
+    }
+    return true;
+}
+
+bool parse_options(int argc, char** argv, options& opts)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* arg = argv[i];
+        auto value_of = [arg](const char* key) -> const char* {
+            auto length = std::strlen(key);
+            if (std::strncmp(arg, key, length) == 0 && arg[length] == '=')
+            {
+                return arg + length + 1;
+            }
+            return nullptr;
+        };
+
+        const char* value;
+        if ((value = value_of("--records")))
+        {
+            if (!parse_size(value, opts.records))
+            {
+                return false;
+            }
+        }
+        else if ((value = value_of("--threads")))
+        {
+            if (!parse_size(value, opts.max_threads))
+            {
+                return false;
+            }
+        }
+        else if ((value = value_of("--sinks")))
+        {
+            if (!parse_sinks(value, opts.sinks))
+            {
+                return false;
+            }
+        }
+        else if ((value = value_of("--json")))
+        {
+            opts.json = value;
+        }
+        else if ((value = value_of("--csv")))
+        {
+            opts.csv = value;
+        }
+        else if ((value = value_of("--logfile")))
+        {
+            opts.logfile = value;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace detail
+
+int main(int argc, char** argv)
+{
+    detail::options opts;
+    if (!detail::parse_options(argc, argv, opts))
+    {
+        std::fprintf(stderr, "usage: %s [--records=N] [--threads=N] [--sinks=LIST] "
+                             "[--json=FILE] [--csv=FILE] [--logfile=FILE]\n",
+                     argv[0]);
+        return 1;
+    }
+
+#ifdef _WIN32
+    const char* null_device = "NUL";
+#else
+    const char* null_device = "/dev/null";
+#endif
+    if (std::freopen(null_device, "w", stdout) == nullptr)
+    {
+        std::fprintf(stderr, "could not redirect stdout to %s\n", null_device);
+        return 1;
+    }
+
+    nitro::log::sink::Logfile::log_file() = opts.logfile;
+    detail::log_filter<detail::record>::set_severity(nitro::log::severity_level::info);
+
+    std::vector<detail::result> results;
+
+    std::fprintf(stderr, "%-22s %-15s %8s %14s %10s %10s %10s %10s\n", "statement", "sink",
+                 "threads", "records/s", "allocs/rec", "p50 ns", "p99 ns", "p99.9 ns");
+
+    detail::measure_sink<nitro::log::sink::Null>("null", opts, results);
+    detail::measure_sink<nitro::log::sink::StdOut>("stdout", opts, results);
+    detail::measure_sink<nitro::log::sink::stdout_mt>("stdout_mt", opts, results);
+    detail::measure_sink<nitro::log::sink::Logfile>("logfile", opts, results);
+#ifndef _WIN32
+    detail::measure_sink<nitro::log::sink::Syslog>("syslog", opts, results);
+    detail::measure_sink<nitro::log::sink::syslog_datagram>("syslog_datagram", opts, results);
+#endif
+
+    if (opts.sinks.count("logfile"))
+    {
+        nitro::log::sink::Logfile::log_stream().close();
+        std::remove(opts.logfile.c_str());
+    }
+
+    if (!opts.json.empty() && !detail::write_json(opts.json, results))
+    {
+        std::fprintf(stderr, "could not write %s\n", opts.json.c_str());
+        return 1;
+    }
+
+    if (!opts.csv.empty() && !detail::write_csv(opts.csv, results))
+    {
+        std::fprintf(stderr, "could not write %s\n", opts.csv.c_str());
+        return 1;
+    }
+
+    return 0;
+}
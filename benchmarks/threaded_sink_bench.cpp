@@ -0,0 +1,110 @@
+#include <nitro/log/attribute/severity.hpp>
+#include <nitro/log/attribute/timestamp.hpp>
+#include <nitro/log/filter/null_filter.hpp>
+#include <nitro/log/log.hpp>
+#include <nitro/log/sink/thread_buffered.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+namespace detail
+{
+
+typedef nitro::log::record<nitro::log::message_attribute, nitro::log::severity_attribute,
+                           nitro::log::timestamp_attribute>
+    record;
+
+template <typename Record>
+class line_formater
+{
+public:
+    void format(Record& r, std::ostream& s)
+    {
+        s << r.message() << '\n';
+    }
+};
+
+std::FILE* output()
+{
+    static std::FILE* file = std::fopen("/dev/null", "w");
+    return file;
+}
+
+// like sink::stdout_mt, every record takes the same lock
+class locked_sink
+{
+public:
+    void sink(nitro::log::severity_level, nitro::lang::string_ref formatted_record)
+    {
+        static std::mutex mutex;
+        std::lock_guard<std::mutex> lock(mutex);
+
+        std::fwrite(formatted_record.get(), 1, formatted_record.size(), output());
+        std::fflush(output());
+    }
+};
+
+class unlocked_sink
+{
+public:
+    void sink(nitro::log::severity_level, nitro::lang::string_ref formatted_record)
+    {
+        std::fwrite(formatted_record.get(), 1, formatted_record.size(), output());
+        std::fflush(output());
+    }
+};
+
+template <typename Sink>
+using logging =
+    nitro::log::logger<record, line_formater, Sink, nitro::log::filter::null_filter>;
+} // namespace detail
+
+template <typename Logging>
+double run(std::size_t thread_count, std::size_t iterations)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < thread_count; ++t)
+    {
+        threads.emplace_back([iterations]() {
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                Logging::info() << "a typical log line with a number " << i << " and some text";
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+    return static_cast<double>(ns) / (iterations * thread_count);
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+
+    using buffered = nitro::log::sink::thread_buffered<detail::unlocked_sink>;
+
+    std::printf("%-8s %18s %26s\n", "threads", "locked ns/record", "thread_buffered ns/record");
+
+    for (std::size_t threads : { 1, 2, 4, 8, 16, 64 })
+    {
+        auto locked = run<detail::logging<detail::locked_sink>>(threads, iterations / threads);
+        auto thread_buffered = run<detail::logging<buffered>>(threads, iterations / threads);
+
+        std::printf("%-8zu %18.1f %26.1f\n", threads, locked, thread_buffered);
+    }
+
+    return 0;
+}
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_FORMAT_DETAIL_ISO8601_HPP
+#define INCLUDE_NITRO_FORMAT_DETAIL_ISO8601_HPP
+
+#include <nitro/format/detail/kernels.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace nitro
+{
+namespace detail
+{
+    struct civil_date
+    {
+        std::int64_t year;
+        unsigned month;
+        unsigned day;
+    };
+
+    /**
+     * \brief converts days since 1970-01-01 to a date of the proleptic Gregorian calendar
+     *
+     * See http://howardhinnant.github.io/date_algorithms.html#civil_from_days
+     */
+    inline civil_date civil_from_days(std::int64_t days)
+    {
+        days += 719468;
+        const std::int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+        const auto day_of_era = static_cast<unsigned>(days - era * 146097);
+        const unsigned year_of_era =
+            (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+        const unsigned day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 -
+                                                   year_of_era / 100);
+        const unsigned month_index = (5 * day_of_year + 2) / 153;
+
+        civil_date date;
+        date.day = day_of_year - (153 * month_index + 2) / 5 + 1;
+        date.month = month_index < 10 ? month_index + 3 : month_index - 9;
+        date.year = static_cast<std::int64_t>(year_of_era) + era * 400 + (date.month <= 2);
+
+        return date;
+    }
+
+    template <typename T>
+    struct is_system_time_point : std::false_type
+    {
+    };
+
+    template <typename Duration>
+    struct is_system_time_point<std::chrono::time_point<std::chrono::system_clock, Duration>>
+        : std::true_type
+    {
+    };
+
+    /// large enough for any result of format_iso8601()
+    constexpr std::size_t iso8601_max_size = 48;
+
+    /**
+     * \brief writes "YYYY-MM-DDTHH:MM:SS" for the given seconds since the epoch, returns the
+     * number of characters written
+     */
+    inline std::size_t format_iso8601_seconds(char* buffer, std::int64_t seconds)
+    {
+        std::int64_t days = seconds / 86400;
+        std::int64_t second_of_day = seconds % 86400;
+        if (second_of_day < 0)
+        {
+            second_of_day += 86400;
+            --days;
+        }
+
+        const auto date = civil_from_days(days);
+        char* out = buffer;
+
+        auto two_digits = [&out](unsigned value) {
+            const char* pairs = digit_pairs() + value * 2;
+            *out++ = pairs[0];
+            *out++ = pairs[1];
+        };
+
+        if (date.year >= 0 && date.year <= 9999)
+        {
+            two_digits(static_cast<unsigned>(date.year / 100));
+            two_digits(static_cast<unsigned>(date.year % 100));
+        }
+        else
+        {
+            char digits[max_digits<std::int64_t>()];
+            char* end = digits + sizeof(digits);
+            auto magnitude = static_cast<std::uint64_t>(date.year);
+            if (date.year < 0)
+            {
+                *out++ = '-';
+                magnitude = 0u - magnitude;
+            }
+            char* begin = format_decimal(end, magnitude);
+            std::memcpy(out, begin, static_cast<std::size_t>(end - begin));
+            out += end - begin;
+        }
+
+        *out++ = '-';
+        two_digits(date.month);
+        *out++ = '-';
+        two_digits(date.day);
+        *out++ = 'T';
+        two_digits(static_cast<unsigned>(second_of_day / 3600));
+        *out++ = ':';
+        two_digits(static_cast<unsigned>(second_of_day / 60 % 60));
+        *out++ = ':';
+        two_digits(static_cast<unsigned>(second_of_day % 60));
+
+        return static_cast<std::size_t>(out - buffer);
+    }
+
+    /**
+     * \brief writes time_point as an ISO-8601 UTC timestamp, e.g. "2026-10-18T08:15:42.123456Z"
+     *
+     * The date and time part only changes once per second, so the last one is cached per
+     * thread. Returns the number of characters written, which is at most iso8601_max_size.
+     *
+     * \param fraction_digits number of digits for the fraction of the second, between 0 and 9
+     */
+    template <typename Duration>
+    inline std::size_t
+    format_iso8601(char* buffer,
+                   std::chrono::time_point<std::chrono::system_clock, Duration> time_point,
+                   int fraction_digits = 6)
+    {
+        using std::chrono::duration_cast;
+
+        struct cached_prefix
+        {
+            std::int64_t seconds = 0;
+            std::size_t size = 0;
+            char data[iso8601_max_size];
+        };
+
+        static thread_local cached_prefix cache;
+
+        const auto since_epoch = time_point.time_since_epoch();
+        auto seconds = duration_cast<std::chrono::seconds>(since_epoch);
+        if (seconds > since_epoch)
+        {
+            seconds -= std::chrono::seconds(1);
+        }
+
+        if (cache.size == 0 || cache.seconds != seconds.count())
+        {
+            cache.size = format_iso8601_seconds(cache.data, seconds.count());
+            cache.seconds = seconds.count();
+        }
+
+        std::memcpy(buffer, cache.data, cache.size);
+        char* out = buffer + cache.size;
+
+        if (fraction_digits > 0)
+        {
+            if (fraction_digits > 9)
+            {
+                fraction_digits = 9;
+            }
+
+            auto nanoseconds = static_cast<std::uint32_t>(
+                duration_cast<std::chrono::nanoseconds>(since_epoch - seconds).count());
+
+            char digits[9];
+            char* begin = format_decimal(digits + 9, nanoseconds);
+            std::memset(digits, '0', static_cast<std::size_t>(begin - digits));
+
+            *out++ = '.';
+            std::memcpy(out, digits, static_cast<std::size_t>(fraction_digits));
+            out += fraction_digits;
+        }
+
+        *out++ = 'Z';
+
+        return static_cast<std::size_t>(out - buffer);
+    }
+} // namespace detail
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_FORMAT_DETAIL_ISO8601_HPP
@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_FORMAT_DETAIL_KERNELS_HPP
+#define INCLUDE_NITRO_FORMAT_DETAIL_KERNELS_HPP
+
+#include <clocale>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <type_traits>
+
+namespace nitro
+{
+namespace detail
+{
+    /**
+     * \brief Locale-free conversion of numbers to characters
+     *
+     * The integer kernels write backwards from the end of a buffer and return the first written
+     * character. Use max_digits<T>() to size that buffer.
+     */
+    template <typename T>
+    constexpr std::size_t max_digits()
+    {
+        // enough for binary, which is the longest representation
+        return std::numeric_limits<std::make_unsigned_t<T>>::digits + 1;
+    }
+
+    inline const char* digit_pairs()
+    {
+        static const char pairs[] = "00010203040506070809"
+                                    "10111213141516171819"
+                                    "20212223242526272829"
+                                    "30313233343536373839"
+                                    "40414243444546474849"
+                                    "50515253545556575859"
+                                    "60616263646566676869"
+                                    "70717273747576777879"
+                                    "80818283848586878889"
+                                    "90919293949596979899";
+        return pairs;
+    }
+
+    template <typename UInt>
+    inline char* format_decimal(char* end, UInt value)
+    {
+        static_assert(std::is_unsigned<UInt>::value, "format_decimal expects an unsigned type");
+
+        const char* pairs = digit_pairs();
+
+        while (value >= 100)
+        {
+            auto index = static_cast<std::size_t>(value % 100) * 2;
+            value /= 100;
+            *--end = pairs[index + 1];
+            *--end = pairs[index];
+        }
+
+        if (value >= 10)
+        {
+            auto index = static_cast<std::size_t>(value) * 2;
+            *--end = pairs[index + 1];
+            *--end = pairs[index];
+        }
+        else
+        {
+            *--end = static_cast<char>('0' + value);
+        }
+
+        return end;
+    }
+
+    /**
+     * \brief writes value in base 2, 8 or 16
+     */
+    template <unsigned Bits, typename UInt>
+    inline char* format_power_of_two(char* end, UInt value, bool upper = false)
+    {
+        static_assert(std::is_unsigned<UInt>::value,
+                      "format_power_of_two expects an unsigned type");
+
+        const char* digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+
+        do
+        {
+            *--end = digits[value & ((1u << Bits) - 1)];
+            value >>= Bits;
+        } while (value != 0);
+
+        return end;
+    }
+
+    template <typename UInt>
+    inline char* format_hex(char* end, UInt value, bool upper = false)
+    {
+        return format_power_of_two<4>(end, value, upper);
+    }
+
+    /**
+     * \brief replaces the decimal point of the C locale, in case someone called setlocale()
+     */
+    inline void fix_decimal_point(char* begin, char* end)
+    {
+        const char point = *std::localeconv()->decimal_point;
+
+        if (point == '.')
+        {
+            return;
+        }
+
+        for (; begin != end; ++begin)
+        {
+            if (*begin == point)
+            {
+                *begin = '.';
+                return;
+            }
+        }
+    }
+
+    inline double parse_floating(const char* str, double)
+    {
+        return std::strtod(str, nullptr);
+    }
+
+    inline float parse_floating(const char* str, float)
+    {
+        return std::strtof(str, nullptr);
+    }
+
+    inline long double parse_floating(const char* str, long double)
+    {
+        return std::strtold(str, nullptr);
+    }
+
+    inline int print_floating(char* buffer, std::size_t size, const char* format, int precision,
+                              double value)
+    {
+        return std::snprintf(buffer, size, format, precision, value);
+    }
+
+    inline int print_floating(char* buffer, std::size_t size, const char* format, int precision,
+                              long double value)
+    {
+        return std::snprintf(buffer, size, format, precision, value);
+    }
+
+    /**
+     * \brief prints value with the given printf conversion ('f', 'e' or 'g') and precision
+     *
+     * A negative precision selects the shortest representation, which parses back to the same
+     * value. Returns the number of characters the result needs, which may exceed size, just
+     * like snprintf().
+     */
+    template <typename Float>
+    inline int format_floating(char* buffer, std::size_t size, Float value, char conversion,
+                               int precision)
+    {
+        static_assert(std::is_floating_point<Float>::value,
+                      "format_floating expects a floating point type");
+
+        constexpr bool is_long = std::is_same<Float, long double>::value;
+        using wide_type = std::conditional_t<is_long, long double, double>;
+
+        const char format[] = { '%', '.', '*', is_long ? 'L' : conversion,
+                                is_long ? conversion : '\0', '\0' };
+        const auto wide_value = static_cast<wide_type>(value);
+
+        int length;
+
+        if (precision < 0)
+        {
+            // try the digits that are always exact first, then add digits until it round-trips
+            precision = std::numeric_limits<Float>::digits10;
+
+            while (true)
+            {
+                length = print_floating(buffer, size, format, precision, wide_value);
+
+                if (precision >= std::numeric_limits<Float>::max_digits10 || length < 0 ||
+                    static_cast<std::size_t>(length) >= size ||
+                    parse_floating(buffer, value) == value || value != value)
+                {
+                    break;
+                }
+
+                ++precision;
+            }
+        }
+        else
+        {
+            length = print_floating(buffer, size, format, precision, wide_value);
+        }
+
+        if (length > 0 && static_cast<std::size_t>(length) < size)
+        {
+            fix_decimal_point(buffer, buffer + length);
+        }
+
+        return length;
+    }
+} // namespace detail
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_FORMAT_DETAIL_KERNELS_HPP
@@ -30,17 +30,180 @@
 #define INCLUDE_NITRO_FORMAT_FORMAT_HPP
 
 #include <nitro/except/raise.hpp>
+#include <nitro/format/detail/iso8601.hpp>
+#include <nitro/format/detail/kernels.hpp>
 
-#include <cstdio>
-#include <regex>
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <ostream>
 #include <sstream>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 namespace nitro
 {
 
 namespace detail
 {
+    /**
+     * \brief finds the placeholder starting at format_str, which is either "{}" or "{:spec}"
+     *
+     * \returns the length of the placeholder, or 0 if there is none
+     */
+    template <class Char>
+    constexpr std::size_t placeholder_length(const Char* format_str, const Char* end)
+    {
+        if (end - format_str < 2 || format_str[0] != Char('{'))
+        {
+            return 0;
+        }
+
+        if (format_str[1] == Char('}'))
+        {
+            return 2;
+        }
+
+        if (format_str[1] != Char(':'))
+        {
+            return 0;
+        }
+
+        for (auto it = format_str + 2; it != end && *it != Char('{'); ++it)
+        {
+            if (*it == Char('}'))
+            {
+                return static_cast<std::size_t>(it - format_str) + 1;
+            }
+        }
+
+        return 0;
+    }
+
+    template <class Char>
+    constexpr const Char* find_end(const Char* format_str)
+    {
+        while (*format_str != Char())
+        {
+            ++format_str;
+        }
+
+        return format_str;
+    }
+
+    /**
+     * \brief counts the placeholders in a format string
+     *
+     * Usable in constant expressions, which is what NITRO_FORMAT builds on.
+     */
+    template <class Char>
+    constexpr std::size_t count_placeholders(const Char* format_str)
+    {
+        std::size_t count = 0;
+        const Char* end = find_end(format_str);
+
+        while (format_str != end)
+        {
+            if (auto length = placeholder_length(format_str, end))
+            {
+                ++count;
+                format_str += length;
+            }
+            else
+            {
+                ++format_str;
+            }
+        }
+
+        return count;
+    }
+
+    /**
+     * \brief the parsed [fill][align][width][.precision][type] part of a "{:spec}" placeholder
+     *
+     * align is one of '<', '>', '^' or '\0' for the default of the argument type. The type
+     * depends on the argument:
+     *  - integers: 'd', 'x', 'X', 'o', 'b'
+     *  - floating point: 'f', 'e', 'g' and their upper case variants, or 'r' for the shortest
+     *    representation which parses back to the same value
+     *  - strings: 's', the precision limits the number of characters
+     *  - std::chrono::system_clock time points are printed as ISO-8601 timestamps in UTC, the
+     *    precision is the number of digits for the fraction of the second
+     */
+    template <class Char>
+    struct format_spec
+    {
+        Char fill = Char(' ');
+        char align = '\0';
+        std::size_t width = 0;
+        int precision = -1;
+        char type = '\0';
+
+        bool empty() const
+        {
+            return width == 0 && precision < 0 && type == '\0';
+        }
+
+        static bool is_align(Char c)
+        {
+            return c == Char('<') || c == Char('>') || c == Char('^');
+        }
+
+        static bool is_digit(Char c)
+        {
+            return c >= Char('0') && c <= Char('9');
+        }
+
+        static format_spec parse(const Char* begin, const Char* end)
+        {
+            format_spec spec;
+
+            if (end - begin >= 2 && is_align(begin[1]))
+            {
+                spec.fill = begin[0];
+                spec.align = static_cast<char>(begin[1]);
+                begin += 2;
+            }
+            else if (begin != end && is_align(*begin))
+            {
+                spec.align = static_cast<char>(*begin++);
+            }
+
+            for (; begin != end && is_digit(*begin); ++begin)
+            {
+                spec.width = spec.width * 10 + static_cast<std::size_t>(*begin - Char('0'));
+            }
+
+            if (begin != end && *begin == Char('.'))
+            {
+                ++begin;
+                if (begin == end || !is_digit(*begin))
+                {
+                    raise("Missing precision in format specification");
+                }
+
+                spec.precision = 0;
+                for (; begin != end && is_digit(*begin); ++begin)
+                {
+                    spec.precision = spec.precision * 10 + static_cast<int>(*begin - Char('0'));
+                }
+            }
+
+            if (begin != end)
+            {
+                spec.type = static_cast<char>(*begin++);
+            }
+
+            if (begin != end || spec.width > 4096 || spec.precision > 4096)
+            {
+                raise("Invalid format specification");
+            }
+
+            return spec;
+        }
+    };
+
     template <class Char, class Traits = std::char_traits<Char>>
     class formatter
     {
@@ -48,19 +211,69 @@ namespace detail
 
     public:
         using string_type = std::basic_string<Char, Traits>;
-        using stream_type = std::basic_stringstream<Char, Traits>;
+        using stream_type = std::basic_ostringstream<Char, Traits>;
+        using spec_type = format_spec<Char>;
+
+        formatter(const string_type& format) : format_(format), literal_(nullptr), size_(0)
+        {
+        }
 
-        formatter(const string_type& format) : format_(format)
+        formatter(const Char* format) : format_(format), literal_(nullptr), size_(0)
         {
         }
 
+        /**
+         * \brief refers to a format string with static storage duration instead of copying it
+         *
+         * Used by the _nf literals and NITRO_FORMAT.
+         */
+        struct literal_tag
+        {
+        };
+
+        formatter(literal_tag, const Char* format, std::size_t size)
+        : literal_(format), size_(size)
+        {
+        }
+
+        /**
+         * \brief renders arg in place of the next placeholder
+         *
+         * The format string is consumed up to that placeholder and both are appended to the
+         * result directly, so no argument is kept around until str() is called.
+         */
         template <typename T>
         self& operator%(T&& arg)
         {
-            stream_type str;
-            str << std::forward<T>(arg);
+            if (cursor_ == 0 && result_.empty())
+            {
+                result_.reserve(format_size() + 64);
+            }
 
-            args_.emplace_back(str.str());
+            std::size_t length;
+            auto placeholder = next_placeholder(length);
+
+            if (placeholder == npos)
+            {
+                ++excess_args_;
+                return *this;
+            }
+
+            auto data = format_data();
+            result_.append(data + cursor_, placeholder - cursor_);
+            cursor_ = placeholder + length;
+
+            if (length == 2)
+            {
+                write(std::forward<T>(arg), spec_type());
+            }
+            else
+            {
+                auto spec = spec_type::parse(data + placeholder + 2, data + cursor_ - 1);
+                auto start = result_.size();
+                auto align = write(std::forward<T>(arg), spec);
+                pad(start, spec, align);
+            }
 
             return *this;
         }
@@ -80,51 +293,370 @@ namespace detail
 
         string_type str() const
         {
+            check();
+
             string_type result;
+            result.reserve(result_.size() + format_size() - cursor_);
+            result.append(result_);
+            result.append(format_data() + cursor_, format_size() - cursor_);
+
+            return result;
+        }
+
+        operator string_type() const
+        {
+            return str();
+        }
+
+        template <class C, class T>
+        friend std::basic_ostream<C, T>& operator<<(std::basic_ostream<C, T>& s,
+                                                    const formatter<C, T>& f);
+
+    private:
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+        const Char* format_data() const
+        {
+            return literal_ != nullptr ? literal_ : format_.data();
+        }
 
-            std::regex r("\\{\\}");
+        std::size_t format_size() const
+        {
+            return literal_ != nullptr ? size_ : format_.size();
+        }
 
-            auto input = format_.begin();
-            auto placeholders_begin = std::sregex_iterator(format_.begin(), format_.end(), r);
-            auto placeholders_end = std::sregex_iterator();
-            auto placeholder = placeholders_begin;
+        std::size_t next_placeholder(std::size_t& length) const
+        {
+            auto data = format_data();
+            auto end = data + format_size();
 
-            for (auto it = args_.begin(); it != args_.end(); ++it, ++placeholder)
+            for (auto it = data + cursor_; it != end; ++it)
             {
-                if (placeholder == placeholders_end)
+                if (*it == Char('{'))
                 {
-                    raise("Provided more arguments than placeholders available in format string");
+                    length = placeholder_length(it, end);
+                    if (length != 0)
+                    {
+                        return static_cast<std::size_t>(it - data);
+                    }
                 }
-
-                result.append(input, format_.begin() + placeholder->position());
-                input = format_.begin() + placeholder->position() + placeholder->length();
-                result.append(it->begin(), it->end());
             }
 
-            result.append(input, format_.end());
+            return npos;
+        }
 
-            if (placeholder != placeholders_end)
+        void check() const
+        {
+            if (excess_args_ > 0)
+            {
+                raise("Provided more arguments than placeholders available in format string");
+            }
+
+            std::size_t length;
+            if (next_placeholder(length) != npos)
             {
                 raise("Provided less arguments than placeholders needed in format string");
             }
+        }
 
-            return result;
+        [[noreturn]] static void invalid_type()
+        {
+            raise("Format specification type does not match the argument");
         }
 
-        operator string_type() const
+        void pad(std::size_t start, const spec_type& spec, char default_align)
         {
-            return str();
+            auto length = result_.size() - start;
+            if (spec.width <= length)
+            {
+                return;
+            }
+
+            auto padding = spec.width - length;
+            auto align = spec.align != '\0' ? spec.align : default_align;
+            std::size_t before = align == '>' ? padding : align == '^' ? padding / 2 : 0;
+
+            result_.insert(start, before, spec.fill);
+            result_.append(padding - before, spec.fill);
+        }
+
+        template <typename T>
+        using is_char_type =
+            std::integral_constant<bool, std::is_same<T, char>::value ||
+                                             std::is_same<T, signed char>::value ||
+                                             std::is_same<T, unsigned char>::value ||
+                                             std::is_same<T, wchar_t>::value ||
+                                             std::is_same<T, char16_t>::value ||
+                                             std::is_same<T, char32_t>::value>;
+
+        template <typename T>
+        using is_string = std::integral_constant<bool, std::is_same<T, const Char*>::value ||
+                                                           std::is_same<T, Char*>::value ||
+                                                           std::is_same<T, string_type>::value>;
+
+        template <typename T>
+        using is_integer =
+            std::integral_constant<bool, std::is_integral<T>::value &&
+                                             !std::is_same<T, bool>::value &&
+                                             !is_char_type<T>::value>;
+
+        template <typename T>
+        using is_other = std::integral_constant<
+            bool, !is_string<T>::value && !std::is_same<T, Char>::value &&
+                      !std::is_same<T, bool>::value && !is_integer<T>::value &&
+                      !std::is_floating_point<T>::value && !is_system_time_point<T>::value>;
+
+        // The writers below print exactly what an unmodified std::basic_ostream would for an
+        // empty spec. They return the default alignment for their type.
+
+        char write(const Char* str, const spec_type& spec)
+        {
+            if (str != nullptr)
+            {
+                write_string(str, Traits::length(str), spec);
+            }
+            return '<';
+        }
+
+        char write(const string_type& str, const spec_type& spec)
+        {
+            write_string(str.data(), str.size(), spec);
+            return '<';
+        }
+
+        void write_string(const Char* str, std::size_t size, const spec_type& spec)
+        {
+            if (spec.type != '\0' && spec.type != 's')
+            {
+                invalid_type();
+            }
+
+            if (spec.precision >= 0 && static_cast<std::size_t>(spec.precision) < size)
+            {
+                size = static_cast<std::size_t>(spec.precision);
+            }
+
+            result_.append(str, size);
+        }
+
+        template <typename T>
+        std::enable_if_t<std::is_same<std::decay_t<T>, Char>::value, char>
+        write(T c, const spec_type& spec)
+        {
+            if (spec.type == '\0' || spec.type == 'c')
+            {
+                result_.push_back(c);
+                return '<';
+            }
+
+            return write_integer(static_cast<std::make_unsigned_t<Char>>(c), spec);
+        }
+
+        template <typename T>
+        std::enable_if_t<std::is_same<std::decay_t<T>, bool>::value, char>
+        write(T b, const spec_type& spec)
+        {
+            return write_integer(b ? 1u : 0u, spec);
+        }
+
+        template <typename T>
+        std::enable_if_t<is_integer<std::decay_t<T>>::value, char> write(T value,
+                                                                          const spec_type& spec)
+        {
+            return write_integer(value, spec);
+        }
+
+        template <typename T>
+        char write_integer(T value, const spec_type& spec)
+        {
+            using unsigned_type = std::make_unsigned_t<T>;
+
+            char buffer[max_digits<T>()];
+            char* end = buffer + sizeof(buffer);
+            char* begin;
+
+            const bool negative = is_negative(value);
+
+            auto magnitude = static_cast<unsigned_type>(value);
+            if (negative)
+            {
+                magnitude = static_cast<unsigned_type>(0u - magnitude);
+            }
+
+            switch (spec.type)
+            {
+            case '\0':
+            case 'd':
+                begin = format_decimal(end, magnitude);
+                break;
+            case 'x':
+                begin = format_hex(end, magnitude);
+                break;
+            case 'X':
+                begin = format_hex(end, magnitude, true);
+                break;
+            case 'o':
+                begin = format_power_of_two<3>(end, magnitude);
+                break;
+            case 'b':
+                begin = format_power_of_two<1>(end, magnitude);
+                break;
+            default:
+                invalid_type();
+            }
+
+            if (negative)
+            {
+                result_.push_back(Char('-'));
+            }
+
+            append_narrow(begin, end);
+            return '>';
+        }
+
+        template <typename T>
+        std::enable_if_t<std::is_floating_point<std::decay_t<T>>::value, char>
+        write(T value, const spec_type& spec)
+        {
+            char conversion = spec.type;
+            int precision = spec.precision;
+
+            switch (spec.type)
+            {
+            case '\0':
+                // same as the defaults of std::ostream
+                conversion = 'g';
+                precision = precision < 0 ? 6 : precision;
+                break;
+            case 'f':
+            case 'F':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+                precision = precision < 0 ? 6 : precision;
+                break;
+            case 'r':
+                conversion = 'g';
+                precision = -1;
+                break;
+            default:
+                invalid_type();
+            }
+
+            char buffer[128];
+            auto length = format_floating(buffer, sizeof(buffer), value, conversion, precision);
+
+            if (length < 0)
+            {
+                return '>';
+            }
+
+            if (static_cast<std::size_t>(length) < sizeof(buffer))
+            {
+                append_narrow(buffer, buffer + length);
+            }
+            else
+            {
+                std::vector<char> large(static_cast<std::size_t>(length) + 1);
+                format_floating(large.data(), large.size(), value, conversion, precision);
+                append_narrow(large.data(), large.data() + length);
+            }
+
+            return '>';
+        }
+
+        template <typename T>
+        std::enable_if_t<is_system_time_point<std::decay_t<T>>::value, char>
+        write(T time_point, const spec_type& spec)
+        {
+            if (spec.type != '\0')
+            {
+                invalid_type();
+            }
+
+            char buffer[iso8601_max_size];
+            auto length =
+                format_iso8601(buffer, time_point, spec.precision < 0 ? 6 : spec.precision);
+
+            append_narrow(buffer, buffer + length);
+            return '<';
+        }
+
+        template <typename T>
+        std::enable_if_t<is_other<std::decay_t<T>>::value, char> write(T&& arg,
+                                                                        const spec_type& spec)
+        {
+            if (spec.type != '\0')
+            {
+                invalid_type();
+            }
+
+            stream_type str;
+            if (spec.precision >= 0)
+            {
+                str.precision(spec.precision);
+            }
+            str << std::forward<T>(arg);
+
+            result_.append(str.str());
+            return '<';
+        }
+
+        template <typename T>
+        static std::enable_if_t<std::is_signed<T>::value, bool> is_negative(T value)
+        {
+            return value < 0;
+        }
+
+        template <typename T>
+        static std::enable_if_t<!std::is_signed<T>::value, bool> is_negative(T)
+        {
+            return false;
+        }
+
+        void append_narrow(const char* begin, const char* end)
+        {
+            result_.append(begin, end);
         }
 
     private:
         string_type format_;
-        std::vector<string_type> args_;
+        const Char* literal_;
+        std::size_t size_;
+        std::size_t cursor_ = 0;
+        std::size_t excess_args_ = 0;
+        string_type result_;
     };
 
-    template <class Char, class Traits = std::char_traits<Char>>
-    std::ostream& operator<<(std::ostream& s, const formatter<Char, Traits>& f)
+    template <class Char, class Traits>
+    constexpr std::size_t formatter<Char, Traits>::npos;
+
+    template <class Char, class Traits>
+    std::basic_ostream<Char, Traits>& operator<<(std::basic_ostream<Char, Traits>& s,
+                                                 const formatter<Char, Traits>& f)
     {
-        return s << f.str();
+        f.check();
+
+        s.write(f.result_.data(), static_cast<std::streamsize>(f.result_.size()));
+        s.write(f.format_data() + f.cursor_,
+                static_cast<std::streamsize>(f.format_size() - f.cursor_));
+
+        return s;
+    }
+
+    template <std::size_t Placeholders, class Char, typename... Args>
+    inline auto checked_format(const Char* format_str, Args&&... args) -> formatter<Char>
+    {
+        static_assert(Placeholders == sizeof...(Args),
+                      "The number of arguments does not match the placeholders in the format "
+                      "string");
+
+        formatter<Char> result(typename formatter<Char>::literal_tag(), format_str,
+                               std::char_traits<Char>::length(format_str));
+        result.args(std::forward<Args>(args)...);
+
+        return result;
     }
 } // namespace detail
 
@@ -143,24 +675,40 @@ inline auto format(const Char* format_str) -> detail::formatter<Char>
 
 } // namespace nitro
 
-inline nitro::detail::formatter<char> operator""_nf(const char* format_str, std::size_t)
+#define NITRO_DETAIL_FORMAT_FIRST(...) NITRO_DETAIL_FORMAT_FIRST_IMPL((__VA_ARGS__, ))
+#define NITRO_DETAIL_FORMAT_FIRST_IMPL(args) NITRO_DETAIL_FORMAT_FIRST_ARG args
+#define NITRO_DETAIL_FORMAT_FIRST_ARG(first, ...) first
+
+/**
+ * \brief formats a string literal, checking the number of arguments at compile time
+ *
+ * NITRO_FORMAT("{} of {}", i, n) is equivalent to nitro::format("{} of {}") % i % n, but fails
+ * to compile if the number of arguments does not match the number of placeholders.
+ */
+#define NITRO_FORMAT(...)                                                                          \
+    ::nitro::detail::checked_format<::nitro::detail::count_placeholders(                          \
+        NITRO_DETAIL_FORMAT_FIRST(__VA_ARGS__))>(__VA_ARGS__)
+
+inline nitro::detail::formatter<char> operator""_nf(const char* format_str, std::size_t size)
 {
-    return nitro::detail::formatter<char>(format_str);
+    return { nitro::detail::formatter<char>::literal_tag(), format_str, size };
 }
 
-inline nitro::detail::formatter<char16_t> operator""_nf(const char16_t* format_str, std::size_t)
+inline nitro::detail::formatter<char16_t> operator""_nf(const char16_t* format_str,
+                                                        std::size_t size)
 {
-    return nitro::detail::formatter<char16_t>(format_str);
+    return { nitro::detail::formatter<char16_t>::literal_tag(), format_str, size };
 }
 
-inline nitro::detail::formatter<char32_t> operator""_nf(const char32_t* format_str, std::size_t)
+inline nitro::detail::formatter<char32_t> operator""_nf(const char32_t* format_str,
+                                                        std::size_t size)
 {
-    return nitro::detail::formatter<char32_t>(format_str);
+    return { nitro::detail::formatter<char32_t>::literal_tag(), format_str, size };
 }
 
-inline nitro::detail::formatter<wchar_t> operator""_nf(const wchar_t* format_str, std::size_t)
+inline nitro::detail::formatter<wchar_t> operator""_nf(const wchar_t* format_str, std::size_t size)
 {
-    return nitro::detail::formatter<wchar_t>(format_str);
+    return { nitro::detail::formatter<wchar_t>::literal_tag(), format_str, size };
 }
 
 #endif // INCLUDE_NITRO_FORMAT_FORMAT_HPP
@@ -31,6 +31,7 @@
 
 #include <nitro/except/raise.hpp>
 
+#include <ostream>
 #include <string>
 
 #include <cstring>
@@ -45,14 +46,25 @@ namespace lang
 
         using pointer_type = const char*;
 
+        static constexpr std::size_t unknown_size = static_cast<std::size_t>(-1);
+
     public:
         using iterator = const char*;
 
-        string_ref(const std::string& str) : ptr_(str.c_str())
+        string_ref(const std::string& str) : ptr_(str.c_str()), size_(str.size())
+        {
+        }
+
+        string_ref(const char* const pstr) : ptr_(pstr), size_(unknown_size)
         {
         }
 
-        string_ref(const char* const pstr) : ptr_(pstr)
+        /**
+         * \brief construct with a known length, which saves the strlen() in size()
+         *
+         * pstr[size] still has to be '\0'.
+         */
+        string_ref(const char* const pstr, std::size_t size) : ptr_(pstr), size_(size)
         {
         }
 
@@ -74,7 +86,12 @@ namespace lang
 
         std::size_t size() const noexcept
         {
-            return std::strlen(const_cast<pointer_type>(ptr_));
+            if (size_ != unknown_size)
+            {
+                return size_;
+            }
+
+            return ptr_ == nullptr ? 0 : std::strlen(ptr_);
         }
 
         bool empty() const
@@ -94,7 +111,12 @@ namespace lang
 
         std::string str() const
         {
-            return { ptr_ };
+            if (ptr_ == nullptr)
+            {
+                return {};
+            }
+
+            return { ptr_, size() };
         }
 
         pointer_type get() const
@@ -119,6 +141,7 @@ namespace lang
 
     private:
         pointer_type ptr_;
+        std::size_t size_;
     };
 
     inline bool operator==(const string_ref& a, const string_ref& b)
@@ -127,7 +150,9 @@ namespace lang
         {
             return false;
         }
-        return std::strcmp(a.ptr_, b.ptr_) == 0;
+
+        auto size = a.size();
+        return size == b.size() && std::memcmp(a.ptr_, b.ptr_, size) == 0;
     }
 
     inline bool operator!=(const string_ref& a, const string_ref& b)
@@ -137,7 +162,11 @@ namespace lang
 
     inline std::ostream& operator<<(std::ostream& s, const string_ref& str)
     {
-        return s << str.ptr_;
+        if (str.ptr_ != nullptr)
+        {
+            s.write(str.ptr_, static_cast<std::streamsize>(str.size()));
+        }
+        return s;
     }
 } // namespace lang
 } // namespace nitro
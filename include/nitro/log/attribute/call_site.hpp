@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_CALL_SITE_ATTRIBUTE_HPP
+#define INCLUDE_NITRO_LOG_CALL_SITE_ATTRIBUTE_HPP
+
+#include <nitro/log/call_site.hpp>
+
+namespace nitro
+{
+namespace log
+{
+    /**
+     * \brief The source location of the log statement, which created the record
+     *
+     * Stored as a pointer to the call_site of the statement, so setting it does not copy any
+     * strings. Records of statements without a call site, e.g. logging::info() without
+     * NITRO_LOG_CALL_SITE(), have none.
+     */
+    class call_site_attribute
+    {
+        const log::call_site* m_call_site = nullptr;
+
+    public:
+        call_site_attribute() = default;
+
+        /// the call site, or nullptr if there is none
+        const log::call_site* call_site() const
+        {
+            return m_call_site;
+        }
+
+        void set_call_site(const log::call_site* site)
+        {
+            m_call_site = site;
+        }
+    };
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_CALL_SITE_ATTRIBUTE_HPP
@@ -29,7 +29,7 @@
 #ifndef INCLUDE_NITRO_LOG_HOSTNAME_ATTRIBUTE_HPP
 #define INCLUDE_NITRO_LOG_HOSTNAME_ATTRIBUTE_HPP
 
-#include <nitro/env/hostname.hpp>
+#include <nitro/log/detail/process_identity.hpp>
 
 #include <string>
 
@@ -37,18 +37,17 @@ namespace nitro
 {
 namespace log
 {
+    /**
+     * \brief The name of the host
+     *
+     * The name is queried once per process and not copied into the record.
+     */
     class hostname_attribute
     {
-        std::string hostname_;
-
     public:
-        hostname_attribute() : hostname_(env::hostname())
-        {
-        }
-
-        std::string hostname() const
+        const std::string& hostname() const
         {
-            return hostname_;
+            return detail::cached_hostname();
         }
     };
 } // namespace log
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_INTERNED_TAG_ATTRIBUTE_HPP
+#define INCLUDE_NITRO_LOG_INTERNED_TAG_ATTRIBUTE_HPP
+
+#include <nitro/log/detail/tag_table.hpp>
+
+#include <nitro/lang/string_ref.hpp>
+
+#include <string>
+
+namespace nitro
+{
+namespace log
+{
+    /**
+     * \brief A tag, which is stored as the id of the interned string
+     *
+     * Use it instead of tag_attribute, if the tags are a small set of strings. Setting the tag
+     * looks it up in the tag table without taking a lock, once it was interned. Filters and
+     * formatters work with the id and do not need to compare strings.
+     *
+     * If the tag table is full, further tags are dropped, see detail::tag_table.
+     */
+    class interned_tag_attribute
+    {
+        tag_id m_tag = invalid_tag_id;
+
+    public:
+        interned_tag_attribute() = default;
+
+        /// the tag, or an empty string if there is none
+        const std::string& tag() const
+        {
+            return detail::tag_table::instance().str(m_tag);
+        }
+
+        /// the id of the tag, or invalid_tag_id if there is none
+        tag_id interned_tag() const
+        {
+            return m_tag;
+        }
+
+        void set_tag(lang::string_ref tag)
+        {
+            m_tag = intern_tag(tag);
+        }
+
+        void set_interned_tag(tag_id id)
+        {
+            m_tag = id;
+        }
+    };
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_INTERNED_TAG_ATTRIBUTE_HPP
@@ -29,26 +29,33 @@
 #ifndef INCLUDE_NITRO_LOG_MESSAGE_ATTRIBUTE_HPP
 #define INCLUDE_NITRO_LOG_MESSAGE_ATTRIBUTE_HPP
 
-#include <string>
+#include <nitro/lang/string_ref.hpp>
 
 namespace nitro
 {
 namespace log
 {
 
+    /**
+     * \brief The streamed message of a record
+     *
+     * The message is not owned by the record, it refers to the buffer of the log statement and is
+     * only valid while the record is formatted and written. Sinks, which keep records around, have
+     * to copy it.
+     */
     class message_attribute
     {
-        std::string m_message;
+        lang::string_ref m_message = nullptr;
 
     public:
         message_attribute() = default;
 
-        std::string message() const
+        lang::string_ref message() const
         {
             return m_message;
         }
 
-        std::string& message()
+        lang::string_ref& message()
         {
             return m_message;
         }
@@ -29,20 +29,26 @@
 #ifndef INCLUDE_NITRO_LOG_PID_ATTRIBUTE_HPP
 #define INCLUDE_NITRO_LOG_PID_ATTRIBUTE_HPP
 
-#include <nitro/env/process.hpp>
+#include <nitro/log/detail/process_identity.hpp>
 
 namespace nitro
 {
 namespace log
 {
 
+    /**
+     * \brief The process and thread id of the thread creating the record
+     *
+     * Both are cached, so creating the record does not make a system call.
+     */
     class pid_attribute
     {
         int my_pid;
         int my_tid;
 
     public:
-        pid_attribute() : my_pid(nitro::env::get_pid()), my_tid(nitro::env::get_tid())
+        pid_attribute()
+        : my_pid(detail::process_identity::pid()), my_tid(detail::process_identity::tid())
         {
         }
 
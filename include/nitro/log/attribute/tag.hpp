@@ -43,7 +43,7 @@ namespace log
     public:
         tag_attribute() = default;
 
-        std::string tag() const
+        const std::string& tag() const
         {
             return m_tag;
         }
@@ -47,6 +47,11 @@ namespace log
             return Clock::now();
         }
 
+        void timestamp_clock_set_time()
+        {
+            my_timestamp = Clock::now();
+        }
+
         timestamp_clock_attribute() = default;
 
         typename Clock::time_point timestamp() const
@@ -0,0 +1,516 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_CALL_SITE_HPP
+#define INCLUDE_NITRO_LOG_CALL_SITE_HPP
+
+#include <nitro/except/raise.hpp>
+#include <nitro/lang/string_ref.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace nitro
+{
+namespace log
+{
+    /**
+     * \brief How the log statement of a call site is filtered, see call_site_registry
+     */
+    enum class call_site_mode : unsigned char
+    {
+        /// the filter of the logger decides, the default
+        filtered,
+        /// always logged, regardless of the filter of the logger, only post filters still apply
+        enabled,
+        /// never logged
+        disabled
+    };
+
+    class call_site_registry;
+
+    using call_site_id = std::uint32_t;
+
+    /// the id of call sites, which are not registered yet
+    constexpr call_site_id invalid_call_site_id = static_cast<call_site_id>(-1);
+
+    namespace detail
+    {
+        struct call_site_state;
+    } // namespace detail
+
+    /**
+     * \brief The source location of a log statement
+     *
+     * There is one call_site for every log statement, see NITRO_LOG_CALL_SITE(). It is never
+     * destroyed, so records refer to it with a plain pointer, see call_site_attribute, and
+     * filters can use its address as key.
+     *
+     * Call sites register themselves in the call_site_registry, when their statement is executed
+     * first. From then on, the statement can be enabled or disabled at runtime.
+     */
+    class call_site
+    {
+    public:
+        constexpr call_site(const char* file, unsigned line, const char* function = nullptr)
+        : file_(file), file_name_(base_name(file)), line_(line), function_(function)
+        {
+        }
+
+        call_site(const call_site&) = delete;
+        call_site& operator=(const call_site&) = delete;
+
+        /// the file as given by __FILE__
+        constexpr const char* file() const
+        {
+            return file_;
+        }
+
+        /// the file without its directories
+        constexpr const char* file_name() const
+        {
+            return file_name_;
+        }
+
+        constexpr unsigned line() const
+        {
+            return line_;
+        }
+
+        /// the function as given by __func__, empty until the call site is registered
+        const char* function() const
+        {
+            return function_ != nullptr ? function_ : "";
+        }
+
+        call_site_mode mode() const;
+
+        /**
+         * \brief a dense id, given in the order the call sites register
+         *
+         * Filters use it to keep state per statement in arrays. It is invalid_call_site_id until
+         * the call site is registered.
+         */
+        call_site_id id() const
+        {
+            return id_.load(std::memory_order_relaxed);
+        }
+
+    private:
+        friend class call_site_registry;
+        friend struct detail::call_site_state;
+
+        static constexpr const char* base_name(const char* path)
+        {
+            const char* name = path;
+            for (const char* c = path; *c != '\0'; ++c)
+            {
+                if (*c == '/' || *c == '\\')
+                {
+                    name = c + 1;
+                }
+            }
+            return name;
+        }
+
+        const char* file_;
+        const char* file_name_;
+        unsigned line_;
+        const char* function_;
+
+        // a call_site_mode, or detail::call_site_state::unregistered
+        std::atomic<unsigned char> mode_{ 3 };
+        std::atomic<call_site_id> id_{ invalid_call_site_id };
+        // the id of the tag last used by the statement, see detail::call_site_tag_id()
+        mutable std::atomic<std::uint32_t> tag_id_{ static_cast<std::uint32_t>(-1) };
+        call_site* next_ = nullptr;
+    };
+
+    namespace detail
+    {
+        struct call_site_state
+        {
+            static constexpr unsigned char unregistered = 3;
+
+            /// the mode of the call site or unregistered, with a single relaxed load
+            static unsigned char load(const call_site& site)
+            {
+                return site.mode_.load(std::memory_order_relaxed);
+            }
+
+            static std::atomic<std::uint32_t>& tag_id(const call_site& site)
+            {
+                return site.tag_id_;
+            }
+        };
+    } // namespace detail
+
+    inline call_site_mode call_site::mode() const
+    {
+        auto mode = detail::call_site_state::load(*this);
+        return mode == detail::call_site_state::unregistered ? call_site_mode::filtered
+                                                              : static_cast<call_site_mode>(mode);
+    }
+
+    /**
+     * \brief All call sites, whose log statements were executed, and their modes
+     *
+     * Every log statement can be enabled, so it is logged regardless of the filter of the
+     * logger, or disabled at runtime, e.g. to see a single debug statement in a running process.
+     * Post filters, like filter::dedupe, still apply to enabled statements.
+     * The modes are set for locations:
+     *
+     *  - "file:line" for a single statement, where file is the path as given by __FILE__, a
+     *    trailing part of it, or just the file name
+     *  - "file" for all statements in a file
+     *  - "*" for all statements
+     *
+     * The modes of all locations are kept and applied to call sites registered later, if
+     * several locations match, the one set last wins. Statements filtered at compile-time with
+     * NITRO_LOG_MIN_SEVERITY cannot be enabled.
+     *
+     * The modes can be configured with a string like "net.cpp:42=on,db.cpp=off", from a control
+     * file with the same entries on separate lines, or from the environment variable
+     * NITRO_LOG_CALL_SITES. See also reload_call_sites_on_signal().
+     */
+    class call_site_registry
+    {
+    public:
+        static call_site_registry& instance()
+        {
+            // never destroyed, so statements in static destructors can still register
+            static call_site_registry* instance_ = new call_site_registry();
+            return *instance_;
+        }
+
+        /// sets the mode of all statements at the location, now and when they register later
+        void set_mode(lang::string_ref location, call_site_mode mode)
+        {
+            auto r = parse_location(location);
+            r.mode = mode;
+
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            rules_.erase(std::remove_if(rules_.begin(), rules_.end(),
+                                        [&r](const rule& other) {
+                                            return other.file == r.file && other.line == r.line;
+                                        }),
+                         rules_.end());
+            rules_.push_back(r);
+
+            for (auto site = first_; site != nullptr; site = site->next_)
+            {
+                if (matches(r, *site))
+                {
+                    site->mode_.store(static_cast<unsigned char>(mode), std::memory_order_release);
+                }
+            }
+        }
+
+        /// forgets the modes of all locations, all statements are filtered by their logger again
+        void reset()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            rules_.clear();
+            for (auto site = first_; site != nullptr; site = site->next_)
+            {
+                site->mode_.store(static_cast<unsigned char>(call_site_mode::filtered),
+                                  std::memory_order_release);
+            }
+        }
+
+        /**
+         * \brief sets the modes from a comma separated list of "location=mode" entries
+         *
+         * The modes are "on", "off" and "default". Throws on malformed entries, without applying
+         * any of the entries then.
+         */
+        void configure(const std::string& config)
+        {
+            parse(config, ',', false);
+            parse(config, ',', true);
+        }
+
+        /**
+         * \brief sets the modes from a control file with one "location=mode" entry per line
+         *
+         * Empty lines and lines starting with '#' are ignored.
+         */
+        void configure_from_file(const std::string& path)
+        {
+            std::ifstream file(path);
+            if (!file)
+            {
+                raise("Cannot open the call site configuration: " + path);
+            }
+
+            std::stringstream config;
+            config << file.rdbuf();
+
+            parse(config.str(), '\n', false);
+            parse(config.str(), '\n', true);
+        }
+
+        /**
+         * \brief sets the modes from the given environment variable, if it is set
+         */
+        void configure_from_env(const char* name = "NITRO_LOG_CALL_SITES")
+        {
+            if (const char* config = std::getenv(name))
+            {
+                configure(config);
+            }
+        }
+
+        /// calls f(const call_site&) for every registered call site
+        template <typename F>
+        void for_each(F f) const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            for (auto site = first_; site != nullptr; site = site->next_)
+            {
+                f(static_cast<const call_site&>(*site));
+            }
+        }
+
+        /**
+         * \brief registers the call site, which is executed for the first time
+         *
+         * Called by NITRO_LOG_CALL_SITE(), there is no need to call it directly.
+         */
+        void add(call_site& site, const char* function)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            if (detail::call_site_state::load(site) != detail::call_site_state::unregistered)
+            {
+                return;
+            }
+
+            if (site.function_ == nullptr)
+            {
+                site.function_ = function;
+            }
+            site.next_ = first_;
+            first_ = &site;
+            site.id_.store(next_id_++, std::memory_order_relaxed);
+
+            auto mode = call_site_mode::filtered;
+            for (const auto& r : rules_)
+            {
+                if (matches(r, site))
+                {
+                    mode = r.mode;
+                }
+            }
+
+            // publishes the function name to threads, which see the site registered
+            site.mode_.store(static_cast<unsigned char>(mode), std::memory_order_release);
+        }
+
+    private:
+        call_site_registry() = default;
+
+        struct rule
+        {
+            std::string file;
+            // 0 for all lines
+            unsigned line;
+            call_site_mode mode;
+        };
+
+        static bool matches(const rule& r, const call_site& site)
+        {
+            if (r.line != 0 && r.line != site.line())
+            {
+                return false;
+            }
+
+            if (r.file == "*" || r.file == site.file() || r.file == site.file_name())
+            {
+                return true;
+            }
+
+            // a trailing part of the path, which starts at a directory
+            auto file_size = std::strlen(site.file());
+            if (r.file.size() >= file_size)
+            {
+                return false;
+            }
+            const char* tail = site.file() + file_size - r.file.size();
+            return (tail[-1] == '/' || tail[-1] == '\\') && r.file == tail;
+        }
+
+        static std::string trim(const std::string& str)
+        {
+            auto begin = str.find_first_not_of(" \t\r");
+            if (begin == std::string::npos)
+            {
+                return {};
+            }
+            auto end = str.find_last_not_of(" \t\r");
+            return str.substr(begin, end - begin + 1);
+        }
+
+        static rule parse_location(lang::string_ref location)
+        {
+            auto text = trim(std::string(location));
+            if (text.empty())
+            {
+                raise("Missing location in call site configuration");
+            }
+
+            rule r{ text, 0, call_site_mode::filtered };
+
+            auto colon = text.rfind(':');
+            if (colon != std::string::npos && colon + 1 < text.size() &&
+                std::all_of(text.begin() + colon + 1, text.end(),
+                            [](unsigned char c) { return std::isdigit(c) != 0; }))
+            {
+                r.file = text.substr(0, colon);
+                r.line = static_cast<unsigned>(std::strtoul(text.c_str() + colon + 1, nullptr, 10));
+            }
+
+            return r;
+        }
+
+        static call_site_mode parse_mode(const std::string& text)
+        {
+            std::string lower = text;
+            std::transform(lower.begin(), lower.end(), lower.begin(),
+                           [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+            if (lower == "on")
+            {
+                return call_site_mode::enabled;
+            }
+            if (lower == "off")
+            {
+                return call_site_mode::disabled;
+            }
+            if (lower == "default")
+            {
+                return call_site_mode::filtered;
+            }
+
+            raise("Unknown mode in call site configuration: " + text);
+        }
+
+        void parse(const std::string& config, char separator, bool apply)
+        {
+            std::string::size_type begin = 0;
+
+            while (begin <= config.size())
+            {
+                auto end = config.find(separator, begin);
+                if (end == std::string::npos)
+                {
+                    end = config.size();
+                }
+
+                auto entry = trim(config.substr(begin, end - begin));
+                begin = end + 1;
+
+                if (entry.empty() || entry[0] == '#')
+                {
+                    continue;
+                }
+
+                auto equals = entry.find('=');
+                if (equals == std::string::npos)
+                {
+                    raise("Missing mode in call site configuration: " + entry);
+                }
+
+                auto location = trim(entry.substr(0, equals));
+                auto mode = parse_mode(trim(entry.substr(equals + 1)));
+                parse_location(location);
+
+                if (apply)
+                {
+                    set_mode(location, mode);
+                }
+            }
+        }
+
+        mutable std::mutex mutex_;
+        std::vector<rule> rules_;
+        call_site* first_ = nullptr;
+        call_site_id next_id_ = 0;
+    };
+
+    namespace detail
+    {
+        /// registers the call site, the first time its statement is executed
+        inline const call_site& registered_call_site(call_site& site, const char* function)
+        {
+            if (call_site_state::load(site) == call_site_state::unregistered)
+            {
+                call_site_registry::instance().add(site, function);
+            }
+            return site;
+        }
+    } // namespace detail
+} // namespace log
+} // namespace nitro
+
+/**
+ * \brief The static call_site of the statement it is used in, which is not registered yet
+ */
+#define NITRO_LOG_STATIC_CALL_SITE()                                                               \
+    ([]() -> ::nitro::log::call_site& {                                                            \
+        static ::nitro::log::call_site nitro_log_call_site(__FILE__, __LINE__);                    \
+        return nitro_log_call_site;                                                                \
+    }())
+
+/**
+ * \brief The call_site of the log statement, in which it is used
+ *
+ *     logging::info(NITRO_LOG_CALL_SITE(), "net") << "connected";
+ *
+ * Evaluates to a const nitro::log::call_site&, which is the same object every time the statement
+ * is executed. The descriptor is a constant-initialized static variable of a lambda, so using it
+ * does not check a guard variable. As __func__ in a lambda is the name of the lambda, the name of
+ * the function is only stored when the call site registers. NITRO_LOG and NITRO_LOG_TAG use it
+ * for every statement.
+ */
+#define NITRO_LOG_CALL_SITE()                                                                      \
+    (::nitro::log::detail::registered_call_site(NITRO_LOG_STATIC_CALL_SITE(), __func__))
+
+#endif // INCLUDE_NITRO_LOG_CALL_SITE_HPP
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_CALL_SITE_SIGNAL_HPP
+#define INCLUDE_NITRO_LOG_CALL_SITE_SIGNAL_HPP
+
+#include <nitro/log/call_site.hpp>
+
+#include <nitro/except/raise.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <semaphore.h>
+#include <signal.h>
+
+namespace nitro
+{
+namespace log
+{
+    namespace detail
+    {
+        // waits for the signal in a thread of its own, as a signal handler may not read files
+        class call_site_reloader
+        {
+        public:
+            static call_site_reloader& instance()
+            {
+                // never destroyed, so the thread and the handler can use it until the very end
+                static call_site_reloader* instance_ = new call_site_reloader();
+                return *instance_;
+            }
+
+            void set_path(const std::string& path)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                path_ = path;
+            }
+
+            static void handler(int)
+            {
+                // sem_post() is async-signal-safe
+                sem_post(&instance().semaphore_);
+            }
+
+            /// the number of reloads so far
+            unsigned long reloads() const
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                return reloads_;
+            }
+
+            /// the file of the last successful reload or the error of the last failed one
+            std::string last_result() const
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                return result_;
+            }
+
+        private:
+            call_site_reloader()
+            {
+                if (sem_init(&semaphore_, 0, 0) != 0)
+                {
+                    raise("Cannot create the semaphore for call site reloads: ",
+                          std::strerror(errno));
+                }
+
+                std::thread([this]() { run(); }).detach();
+            }
+
+            void run()
+            {
+                while (true)
+                {
+                    if (sem_wait(&semaphore_) != 0)
+                    {
+                        continue;
+                    }
+
+                    std::string path;
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        path = path_;
+                    }
+
+                    std::string result = path;
+                    try
+                    {
+                        call_site_registry::instance().configure_from_file(path);
+                    }
+                    catch (std::exception& e)
+                    {
+                        result = e.what();
+                    }
+
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    result_ = result;
+                    ++reloads_;
+                }
+            }
+
+            mutable std::mutex mutex_;
+            std::string path_;
+            std::string result_;
+            unsigned long reloads_ = 0;
+            sem_t semaphore_;
+        };
+    } // namespace detail
+
+    /**
+     * \brief Reloads the call site configuration from the control file, whenever the process
+     * gets the signal
+     *
+     * The file is read by a background thread with call_site_registry::configure_from_file().
+     * A file, which cannot be read or parsed, is ignored. Calling it again changes the file and
+     * installs the handler for the new signal as well.
+     *
+     *     nitro::log::reload_call_sites_on_signal(SIGUSR1, "/tmp/app.log-sites");
+     *     // echo "net.cpp:42=on" > /tmp/app.log-sites; kill -USR1 <pid>
+     */
+    inline void reload_call_sites_on_signal(int signal, const std::string& path)
+    {
+        auto& reloader = detail::call_site_reloader::instance();
+        reloader.set_path(path);
+
+        struct sigaction action;
+        std::memset(&action, 0, sizeof(action));
+        action.sa_handler = &detail::call_site_reloader::handler;
+        sigemptyset(&action.sa_mask);
+        action.sa_flags = SA_RESTART;
+
+        if (sigaction(signal, &action, nullptr) != 0)
+        {
+            raise("Cannot install the signal handler for call site reloads: ",
+                  std::strerror(errno));
+        }
+    }
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_CALL_SITE_SIGNAL_HPP
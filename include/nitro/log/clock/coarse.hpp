@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_CLOCK_COARSE_HPP
+#define INCLUDE_NITRO_LOG_CLOCK_COARSE_HPP
+
+#include <chrono>
+
+#ifndef _WIN32
+extern "C"
+{
+#include <time.h>
+}
+#endif
+
+namespace nitro
+{
+namespace log
+{
+    namespace clock
+    {
+        /**
+         * \brief Wall clock, which is cheap to read, but only advances with the timer tick
+         *
+         * On Linux, it reads CLOCK_REALTIME_COARSE, whose resolution is typically 1 to 4 ms.
+         * Elsewhere, it is std::chrono::system_clock. The time points are the ones of
+         * std::chrono::system_clock, so formatters print them as wall time.
+         */
+        class coarse_system_clock
+        {
+        public:
+            using duration = std::chrono::system_clock::duration;
+            using rep = duration::rep;
+            using period = duration::period;
+            using time_point = std::chrono::system_clock::time_point;
+
+            static constexpr bool is_steady = false;
+
+            static time_point now() noexcept
+            {
+#ifdef CLOCK_REALTIME_COARSE
+                timespec ts;
+                clock_gettime(CLOCK_REALTIME_COARSE, &ts);
+                return time_point(std::chrono::duration_cast<duration>(
+                    std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec)));
+#else
+                return std::chrono::system_clock::now();
+#endif
+            }
+        };
+
+        /**
+         * \brief Monotonic clock, which is cheap to read, but only advances with the timer tick
+         *
+         * On Linux, it reads CLOCK_MONOTONIC_COARSE, whose resolution is typically 1 to 4 ms.
+         * Elsewhere, it is std::chrono::steady_clock.
+         */
+        class coarse_steady_clock
+        {
+        public:
+            using duration = std::chrono::nanoseconds;
+            using rep = duration::rep;
+            using period = duration::period;
+            using time_point = std::chrono::time_point<coarse_steady_clock, duration>;
+
+            static constexpr bool is_steady = true;
+
+            static time_point now() noexcept
+            {
+#ifdef CLOCK_MONOTONIC_COARSE
+                timespec ts;
+                clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+                return time_point(std::chrono::seconds(ts.tv_sec) +
+                                  std::chrono::nanoseconds(ts.tv_nsec));
+#else
+                return time_point(std::chrono::duration_cast<duration>(
+                    std::chrono::steady_clock::now().time_since_epoch()));
+#endif
+            }
+        };
+    } // namespace clock
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_CLOCK_COARSE_HPP
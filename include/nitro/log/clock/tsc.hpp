@@ -0,0 +1,336 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_CLOCK_TSC_HPP
+#define INCLUDE_NITRO_LOG_CLOCK_TSC_HPP
+
+#include <nitro/log/attribute/timestamp.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define NITRO_LOG_TSC_X86
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define NITRO_LOG_TSC_X86
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+#define NITRO_LOG_TSC_AARCH64
+#endif
+
+namespace nitro
+{
+namespace log
+{
+    namespace clock
+    {
+        struct tsc_clock_config
+        {
+            /// how long the first conversion measures the tick rate
+            std::chrono::microseconds calibration_time{ 5000 };
+
+            /// how often the tick rate and offset are measured again against the system clock
+            std::chrono::milliseconds recalibration_interval{ 1000 };
+        };
+
+        namespace detail
+        {
+            // a pair of tick count and system time taken at the same moment
+            struct tsc_sample
+            {
+                std::uint64_t ticks;
+                std::int64_t system_ns;
+            };
+
+            /**
+             * \brief Converts ticks to system time with a rate measured against the system clock
+             *
+             * The rate is measured anew from the last sample every recalibration interval, so it
+             * follows the adjustments of the system clock, e.g. by NTP. If the system clock was
+             * set in between, i.e. the rate changed by more than a percent, only the offset is
+             * taken over. Ticks before a recalibration may thus be converted to slightly different
+             * times, than they would have been before it.
+             *
+             * Readers use a sequence lock and never wait for a recalibration.
+             */
+            class tsc_calibration
+            {
+            public:
+                template <typename Ticks>
+                tsc_calibration(Ticks ticks, const tsc_clock_config& config)
+                : recalibration_ns_(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                        config.recalibration_interval)
+                                        .count())
+                {
+                    auto first = sample(ticks);
+
+                    auto end = std::chrono::steady_clock::now() + config.calibration_time;
+                    while (std::chrono::steady_clock::now() < end)
+                    {
+                    }
+
+                    auto second = sample(ticks);
+                    publish(second, rate(first, second, 1.0));
+                }
+
+                template <typename Ticks>
+                std::int64_t to_system_ns(std::uint64_t ticks, Ticks read_ticks)
+                {
+                    tsc_sample anchor;
+                    double ns_per_tick;
+                    std::uint64_t recalibration_ticks;
+                    read(anchor, ns_per_tick, recalibration_ticks);
+
+                    auto delta = static_cast<std::int64_t>(ticks - anchor.ticks);
+                    if (delta > static_cast<std::int64_t>(recalibration_ticks) &&
+                        recalibrate(anchor, ns_per_tick, read_ticks))
+                    {
+                        read(anchor, ns_per_tick, recalibration_ticks);
+                        delta = static_cast<std::int64_t>(ticks - anchor.ticks);
+                    }
+
+                    return anchor.system_ns +
+                           static_cast<std::int64_t>(static_cast<double>(delta) * ns_per_tick);
+                }
+
+            private:
+                template <typename Ticks>
+                static tsc_sample sample(Ticks ticks)
+                {
+                    // the system time is taken between two tick counts, the closest pair wins
+                    tsc_sample best{ 0, 0 };
+                    std::uint64_t best_spread = static_cast<std::uint64_t>(-1);
+
+                    for (int i = 0; i < 3; ++i)
+                    {
+                        auto before = ticks();
+                        auto system = std::chrono::system_clock::now();
+                        auto after = ticks();
+
+                        if (after - before < best_spread)
+                        {
+                            best_spread = after - before;
+                            best.ticks = before + (after - before) / 2;
+                            best.system_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                 system.time_since_epoch())
+                                                 .count();
+                        }
+                    }
+
+                    return best;
+                }
+
+                static double rate(const tsc_sample& from, const tsc_sample& to, double fallback)
+                {
+                    if (to.ticks <= from.ticks)
+                    {
+                        return fallback;
+                    }
+                    return static_cast<double>(to.system_ns - from.system_ns) /
+                           static_cast<double>(to.ticks - from.ticks);
+                }
+
+                template <typename Ticks>
+                bool recalibrate(const tsc_sample& anchor, double ns_per_tick, Ticks ticks)
+                {
+                    std::unique_lock<std::mutex> lock(recalibration_mutex_, std::try_to_lock);
+                    if (!lock.owns_lock())
+                    {
+                        // someone else recalibrates, until then the current values are good enough
+                        return false;
+                    }
+                    if (anchor.ticks != anchor_ticks_.load(std::memory_order_relaxed))
+                    {
+                        // someone else just did
+                        return true;
+                    }
+
+                    auto next = sample(ticks);
+                    auto next_rate = rate(anchor, next, ns_per_tick);
+
+                    if (next_rate < ns_per_tick * 0.99 || next_rate > ns_per_tick * 1.01)
+                    {
+                        // the system clock was set, not adjusted
+                        next_rate = ns_per_tick;
+                    }
+
+                    publish(next, next_rate);
+                    return true;
+                }
+
+                void publish(const tsc_sample& anchor, double ns_per_tick)
+                {
+                    auto sequence = sequence_.load(std::memory_order_relaxed);
+                    sequence_.store(sequence + 1, std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_release);
+
+                    anchor_ticks_.store(anchor.ticks, std::memory_order_relaxed);
+                    anchor_ns_.store(anchor.system_ns, std::memory_order_relaxed);
+                    ns_per_tick_.store(ns_per_tick, std::memory_order_relaxed);
+                    recalibration_ticks_.store(
+                        static_cast<std::uint64_t>(static_cast<double>(recalibration_ns_) /
+                                                   ns_per_tick),
+                        std::memory_order_relaxed);
+
+                    sequence_.store(sequence + 2, std::memory_order_release);
+                }
+
+                void read(tsc_sample& anchor, double& ns_per_tick,
+                          std::uint64_t& recalibration_ticks) const
+                {
+                    while (true)
+                    {
+                        auto before = sequence_.load(std::memory_order_acquire);
+
+                        anchor.ticks = anchor_ticks_.load(std::memory_order_relaxed);
+                        anchor.system_ns = anchor_ns_.load(std::memory_order_relaxed);
+                        ns_per_tick = ns_per_tick_.load(std::memory_order_relaxed);
+                        recalibration_ticks = recalibration_ticks_.load(std::memory_order_relaxed);
+
+                        std::atomic_thread_fence(std::memory_order_acquire);
+                        if (before % 2 == 0 &&
+                            before == sequence_.load(std::memory_order_relaxed))
+                        {
+                            return;
+                        }
+                    }
+                }
+
+                const std::int64_t recalibration_ns_;
+
+                std::atomic<std::uint64_t> sequence_{ 0 };
+                std::atomic<std::uint64_t> anchor_ticks_{ 0 };
+                std::atomic<std::int64_t> anchor_ns_{ 0 };
+                std::atomic<double> ns_per_tick_{ 1.0 };
+                std::atomic<std::uint64_t> recalibration_ticks_{ 0 };
+
+                std::mutex recalibration_mutex_;
+            };
+        } // namespace detail
+
+        /**
+         * \brief Clock reading the time stamp counter of the CPU, converted to system time
+         *
+         * ticks() only reads the counter: rdtsc on x86, cntvct_el0 on AArch64 and
+         * std::chrono::steady_clock elsewhere. The conversion to system time is done separately by
+         * to_time_point(), so the timestamp_clock_attribute of this clock only stores the ticks
+         * and converts them, when the record is formatted.
+         *
+         * The tick rate is measured against std::chrono::system_clock during the first conversion,
+         * which therefore takes config().calibration_time, and again every
+         * config().recalibration_interval.
+         *
+         * The counter has to run at a constant rate and in sync on all cores, which is the case
+         * for CPUs with an invariant TSC.
+         */
+        class tsc_clock
+        {
+        public:
+            using duration = std::chrono::system_clock::duration;
+            using rep = duration::rep;
+            using period = duration::period;
+            using time_point = std::chrono::system_clock::time_point;
+
+            static constexpr bool is_steady = false;
+
+            static tsc_clock_config& config()
+            {
+                static tsc_clock_config config_;
+                return config_;
+            }
+
+            static std::uint64_t ticks() noexcept
+            {
+#if defined(NITRO_LOG_TSC_X86)
+                return __rdtsc();
+#elif defined(NITRO_LOG_TSC_AARCH64)
+                std::uint64_t value;
+                asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+                return value;
+#else
+                return static_cast<std::uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now().time_since_epoch())
+                        .count());
+#endif
+            }
+
+            static time_point to_time_point(std::uint64_t ticks)
+            {
+                auto ns = calibration().to_system_ns(ticks, &tsc_clock::ticks);
+                return time_point(
+                    std::chrono::duration_cast<duration>(std::chrono::nanoseconds(ns)));
+            }
+
+            static time_point now()
+            {
+                return to_time_point(ticks());
+            }
+
+        private:
+            static detail::tsc_calibration& calibration()
+            {
+                // never destroyed, so records can still be formatted while statics are destroyed
+                static detail::tsc_calibration* calibration_ =
+                    new detail::tsc_calibration(&tsc_clock::ticks, config());
+                return *calibration_;
+            }
+        };
+    } // namespace clock
+
+    /**
+     * \brief Stores the ticks of the tsc_clock and converts them, when the record is formatted
+     */
+    template <>
+    class timestamp_clock_attribute<clock::tsc_clock>
+    {
+        std::uint64_t my_ticks = 0;
+
+    public:
+        void timestamp_clock_set_time()
+        {
+            my_ticks = clock::tsc_clock::ticks();
+        }
+
+        std::uint64_t timestamp_ticks() const
+        {
+            return my_ticks;
+        }
+
+        clock::tsc_clock::time_point timestamp() const
+        {
+            return clock::tsc_clock::to_time_point(my_ticks);
+        }
+    };
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_CLOCK_TSC_HPP
@@ -0,0 +1,337 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_CRASH_HANDLER_HPP
+#define INCLUDE_NITRO_LOG_CRASH_HANDLER_HPP
+
+#include <nitro/log/detail/emergency_writers.hpp>
+
+#include <nitro/except/raise.hpp>
+#include <nitro/format/detail/iso8601.hpp>
+#include <nitro/format/detail/kernels.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+
+#include <pthread.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+
+#if defined(__GLIBC__)
+#include <execinfo.h>
+#endif
+
+namespace nitro
+{
+namespace log
+{
+    struct crash_handler_config
+    {
+        /// where the final record and the backtrace are written, next to the buffering sinks
+        int fd = STDERR_FILENO;
+
+        /// whether to write a backtrace after the final record, if the platform has one
+        bool backtrace = true;
+    };
+
+    namespace detail
+    {
+        /**
+         * \brief The handler of install_crash_handler()
+         *
+         * Everything the handler needs is allocated at installation, the handler itself only
+         * formats into a stack buffer and calls write(2).
+         */
+        class crash_handler
+        {
+        public:
+            static crash_handler& instance()
+            {
+                // never destroyed, so the handler can use it until the very end
+                static crash_handler* instance_ = new crash_handler();
+                return *instance_;
+            }
+
+            void install(const crash_handler_config& config)
+            {
+                fd_.store(config.fd, std::memory_order_relaxed);
+                backtrace_.store(config.backtrace, std::memory_order_relaxed);
+
+#if defined(__GLIBC__)
+                if (config.backtrace)
+                {
+                    // the first call loads libgcc, which must not happen in the handler
+                    void* frame;
+                    ::backtrace(&frame, 1);
+                }
+#endif
+
+                install_alternate_stack();
+
+                if (installed_)
+                {
+                    return;
+                }
+
+                struct sigaction action;
+                std::memset(&action, 0, sizeof(action));
+                action.sa_sigaction = &handler;
+                action.sa_flags = SA_SIGINFO | SA_ONSTACK;
+                sigemptyset(&action.sa_mask);
+
+                for (std::size_t i = 0; i < signal_count; ++i)
+                {
+                    if (::sigaction(signals()[i], &action, &previous_[i]) != 0)
+                    {
+                        raise("Cannot install the crash handler: ", std::strerror(errno));
+                    }
+                }
+                installed_ = true;
+            }
+
+            static const int* signals()
+            {
+                static const int signals_[] = { SIGSEGV, SIGABRT, SIGBUS, SIGFPE };
+                return signals_;
+            }
+
+            static constexpr std::size_t signal_count = 4;
+
+        private:
+            crash_handler() = default;
+
+            // a signal handler on the alternate stack also works after a stack overflow
+            void install_alternate_stack()
+            {
+                stack_t current;
+                if (::sigaltstack(nullptr, &current) == 0 && !(current.ss_flags & SS_DISABLE))
+                {
+                    return;
+                }
+
+                stack_t stack;
+                stack.ss_size = std::max<std::size_t>(SIGSTKSZ, 64 * 1024);
+                // never freed, the signal can arrive until the very end
+                stack.ss_sp = new char[stack.ss_size];
+                stack.ss_flags = 0;
+                ::sigaltstack(&stack, nullptr);
+            }
+
+            static void handler(int sig, siginfo_t* info, void*)
+            {
+                auto& self = instance();
+
+                if (self.crashing_.exchange(true))
+                {
+                    if (::pthread_equal(self.crashing_thread_, ::pthread_self()))
+                    {
+                        // crashed in the handler itself, give up on writing
+                        self.reraise(sig);
+                        return;
+                    }
+
+                    // another thread is already writing, and will end the process
+                    while (true)
+                    {
+                        ::pause();
+                    }
+                }
+                self.crashing_thread_ = ::pthread_self();
+
+                char record[256];
+                auto size = format_record(record, sig, info);
+
+                emergency_writers::write_all(record, size);
+
+                const int fd = self.fd_.load(std::memory_order_relaxed);
+                write_fd(fd, record, size);
+
+#if defined(__GLIBC__)
+                if (self.backtrace_.load(std::memory_order_relaxed))
+                {
+                    void* frames[64];
+                    ::backtrace_symbols_fd(frames, ::backtrace(frames, 64), fd);
+                }
+#endif
+
+                self.reraise(sig);
+            }
+
+            // restores the previous action, which gets the signal once the handler returns
+            void reraise(int sig)
+            {
+                for (std::size_t i = 0; i < signal_count; ++i)
+                {
+                    if (signals()[i] != sig)
+                    {
+                        continue;
+                    }
+
+                    struct sigaction action = previous_[i];
+                    if (!(action.sa_flags & SA_SIGINFO) && action.sa_handler == SIG_IGN)
+                    {
+                        action.sa_handler = SIG_DFL;
+                    }
+                    ::sigaction(sig, &action, nullptr);
+                }
+
+                ::raise(sig);
+            }
+
+            static void write_fd(int fd, const char* data, std::size_t size)
+            {
+                while (size > 0)
+                {
+                    auto written = ::write(fd, data, size);
+                    if (written < 0)
+                    {
+                        if (errno == EINTR)
+                        {
+                            continue;
+                        }
+                        return;
+                    }
+                    data += written;
+                    size -= static_cast<std::size_t>(written);
+                }
+            }
+
+            static const char* signal_name(int sig)
+            {
+                switch (sig)
+                {
+                case SIGSEGV:
+                    return "SIGSEGV";
+                case SIGABRT:
+                    return "SIGABRT";
+                case SIGBUS:
+                    return "SIGBUS";
+                case SIGFPE:
+                    return "SIGFPE";
+                default:
+                    return "signal";
+                }
+            }
+
+            // "[2026-10-18T08:15:42.123456Z][FATAL]: caught SIGSEGV at address 0x10\n"
+            static std::size_t format_record(char* buffer, int sig, siginfo_t* info)
+            {
+                char* out = buffer;
+
+                auto append = [&out](const char* str) {
+                    auto size = std::strlen(str);
+                    std::memcpy(out, str, size);
+                    out += size;
+                };
+
+                struct timespec now;
+                ::clock_gettime(CLOCK_REALTIME, &now);
+
+                *out++ = '[';
+                out += nitro::detail::format_iso8601_seconds(out, now.tv_sec);
+                char digits[9];
+                char* begin = nitro::detail::format_decimal(
+                    digits + 9, static_cast<std::uint32_t>(now.tv_nsec / 1000 + 1000000));
+                *out++ = '.';
+                std::memcpy(out, begin + 1, 6);
+                out += 6;
+                append("Z][FATAL]: caught ");
+                append(signal_name(sig));
+
+                // only faults detected by the kernel have an address, not raise() or kill()
+                if ((sig != SIGSEGV && sig != SIGBUS && sig != SIGFPE) || info == nullptr ||
+                    info->si_code <= 0)
+                {
+                    *out++ = '\n';
+                    return static_cast<std::size_t>(out - buffer);
+                }
+
+                append(" at address 0x");
+                auto address = reinterpret_cast<std::uintptr_t>(info->si_addr);
+                char hex[2 * sizeof(address)];
+                char* end = hex + sizeof(hex);
+                char* first = end;
+                do
+                {
+                    *--first = "0123456789abcdef"[address & 0xf];
+                    address >>= 4;
+                } while (address != 0);
+                std::memcpy(out, first, static_cast<std::size_t>(end - first));
+                out += end - first;
+
+                *out++ = '\n';
+                return static_cast<std::size_t>(out - buffer);
+            }
+
+            std::atomic<int> fd_{ STDERR_FILENO };
+            std::atomic<bool> backtrace_{ true };
+            std::atomic<bool> crashing_{ false };
+            pthread_t crashing_thread_;
+            bool installed_ = false;
+            struct sigaction previous_[signal_count];
+        };
+    } // namespace detail
+
+    /**
+     * \brief Writes buffered records and a final fatal record, if the process crashes
+     *
+     * On SIGSEGV, SIGABRT, SIGBUS and SIGFPE, every sink, which buffers records, e.g.
+     * sink::rotating_file, writes its buffer followed by a record like
+     * "[2026-10-18T08:15:42.123456Z][FATAL]: caught SIGSEGV at address 0x10". The record is
+     * also written to config.fd, together with a backtrace if config.backtrace is set and the
+     * platform has one. Then the signal is raised again with the handler, which was installed
+     * before, so core dumps and other crash reporters still work.
+     *
+     * The handler only uses async-signal-safe calls on memory allocated beforehand, and it runs
+     * on an alternate signal stack, so it also works after a stack overflow. The alternate
+     * stack is only set up for the calling thread, so call this early in the main thread. It
+     * does not stop the other threads, so records, which they are logging or flushing during the
+     * crash, may be written twice or torn.
+     *
+     * Sinks, which flush every record like sink::StdOut or sink::Logfile, have nothing to
+     * write. sink::mmap_ring keeps its records in the mapped file anyway. The records waiting in
+     * sink::async and sink::thread_buffered are lost on a crash, as the sinks they wrap cannot
+     * be called from a signal handler. Also, the lock-free queue of sink::async hands its slots
+     * to the logging threads, which may reallocate the strings in them while the handler would
+     * read them, and the buffers of sink::thread_buffered are guarded by mutexes. To keep the
+     * records of a buffering sink on a crash, use sink::rotating_file or sink::mmap_ring.
+     *
+     * Calling it again only changes the configuration.
+     */
+    inline void install_crash_handler(const crash_handler_config& config = crash_handler_config())
+    {
+        detail::crash_handler::instance().install(config);
+    }
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_CRASH_HANDLER_HPP
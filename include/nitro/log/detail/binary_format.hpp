@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_DETAIL_BINARY_FORMAT_HPP
+#define INCLUDE_NITRO_LOG_DETAIL_BINARY_FORMAT_HPP
+
+#include <nitro/log/detail/intern_table.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+
+namespace nitro
+{
+namespace log
+{
+    namespace detail
+    {
+        /*
+         * Encoding of formatter::binary_formatter, shared by the encoder and the decoder.
+         *
+         * A binary log is a sequence of frames. Every frame is a type byte, the length of the
+         * payload as varint and the payload. Varints are unsigned LEB128, signed values are
+         * zigzag encoded first.
+         *
+         * 'L' defines a literal:   varint id, the characters
+         * 'T' defines a tag:       varint id, the characters
+         * 'R' a record:            a byte of binary_field flags, the fields in the order of the
+         *                          flags, then the arguments of the message up to the end
+         *
+         * Every argument starts with a kind byte:
+         *
+         * 'l' literal:             varint id
+         * 's' string:              varint length, the characters
+         * 'c' character:           the character
+         * 'i' signed integer:      zigzag varint
+         * 'u' unsigned integer:    varint
+         * 'f' floating point:      8 byte IEEE 754 double in host byte order
+         *
+         * Literals and tags are defined before the first record, which uses them, is passed to
+         * the sink. Records of different threads may still overtake those definitions on their
+         * way to the file, so decoders read all definitions first.
+         *
+         * Sinks, which drop older data, i.e. start a new file or overwrite a ring buffer, call
+         * redefine_binary_dictionary(). All literals and tags are then defined again along with
+         * the next record, so the remaining data can still be decoded on its own.
+         */
+
+        constexpr char binary_literal_frame = 'L';
+        constexpr char binary_tag_frame = 'T';
+        constexpr char binary_record_frame = 'R';
+
+        constexpr char binary_literal_argument = 'l';
+        constexpr char binary_string_argument = 's';
+        constexpr char binary_char_argument = 'c';
+        constexpr char binary_signed_argument = 'i';
+        constexpr char binary_unsigned_argument = 'u';
+        constexpr char binary_floating_argument = 'f';
+
+        /// the fields of a record frame, in the order they are encoded
+        enum binary_field : unsigned char
+        {
+            binary_system_timestamp = 1, ///< zigzag varint, nanoseconds since the Unix epoch
+            binary_ticks_timestamp = 2,  ///< zigzag varint, ticks of another clock
+            binary_severity = 4,         ///< one byte severity_level
+            binary_tag = 8,              ///< varint tag id
+            binary_pid = 16,             ///< zigzag varints of process and thread id
+            binary_thread = 32           ///< varint pthread id
+        };
+
+        struct literal_domain;
+
+        /**
+         * \brief The dictionary of string literals streamed into binary log records
+         */
+        using literal_table = intern_table<literal_domain, 1 << 16>;
+
+        /// incremented whenever the dictionary must be defined again, see above
+        inline std::atomic<std::uint64_t>& binary_dictionary_epoch()
+        {
+            static std::atomic<std::uint64_t> epoch_{ 0 };
+            return epoch_;
+        }
+
+        inline void redefine_binary_dictionary()
+        {
+            binary_dictionary_epoch().fetch_add(1, std::memory_order_relaxed);
+        }
+
+        constexpr std::size_t max_varint_size = 10;
+
+        /// writes value as varint to out and returns the end of it
+        inline char* put_varint(char* out, std::uint64_t value)
+        {
+            while (value >= 0x80)
+            {
+                *out++ = static_cast<char>((value & 0x7f) | 0x80);
+                value >>= 7;
+            }
+            *out++ = static_cast<char>(value);
+            return out;
+        }
+
+        inline void write_varint(std::ostream& s, std::uint64_t value)
+        {
+            char buffer[max_varint_size];
+            s.write(buffer, put_varint(buffer, value) - buffer);
+        }
+
+        /// reads a varint, returns false if it is not complete before end
+        inline bool get_varint(const char*& in, const char* end, std::uint64_t& value)
+        {
+            value = 0;
+            for (unsigned shift = 0; in != end && shift < 64; shift += 7)
+            {
+                auto byte = static_cast<unsigned char>(*in++);
+                value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+                if (byte < 0x80)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        inline std::uint64_t zigzag_encode(std::int64_t value)
+        {
+            return (static_cast<std::uint64_t>(value) << 1) ^
+                   static_cast<std::uint64_t>(value >> 63);
+        }
+
+        inline std::int64_t zigzag_decode(std::uint64_t value)
+        {
+            return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+        }
+    } // namespace detail
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_DETAIL_BINARY_FORMAT_HPP
@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_DETAIL_BOUNDED_QUEUE_HPP
+#define INCLUDE_NITRO_LOG_DETAIL_BOUNDED_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace nitro
+{
+namespace log
+{
+    namespace detail
+    {
+        /**
+         * \brief A bounded, lock-free ring buffer for multiple producers and consumers
+         *
+         * Every slot carries a sequence number, which tells producers and consumers whether the
+         * slot is free to write or ready to read (D. Vyukov's bounded MPMC queue). Elements are
+         * never moved in or out of the queue, instead push and pop hand the slot to a callback.
+         * This way the slots keep their allocated storage (e.g. the capacity of a std::string)
+         * across reuse.
+         *
+         * The capacity is rounded up to the next power of two.
+         */
+        template <typename T>
+        class bounded_queue
+        {
+            struct cell
+            {
+                std::atomic<std::size_t> sequence;
+                T data;
+            };
+
+            class publish_guard
+            {
+            public:
+                publish_guard(std::atomic<std::size_t>& sequence, std::size_t value)
+                : sequence_(sequence), value_(value)
+                {
+                }
+
+                ~publish_guard()
+                {
+                    sequence_.store(value_, std::memory_order_release);
+                }
+
+            private:
+                std::atomic<std::size_t>& sequence_;
+                std::size_t value_;
+            };
+
+            static std::size_t round_up(std::size_t capacity)
+            {
+                std::size_t result = 2;
+                while (result < capacity)
+                {
+                    result <<= 1;
+                }
+                return result;
+            }
+
+        public:
+            explicit bounded_queue(std::size_t capacity)
+            : mask_(round_up(capacity) - 1), buffer_(new cell[mask_ + 1])
+            {
+                for (std::size_t i = 0; i <= mask_; ++i)
+                {
+                    buffer_[i].sequence.store(i, std::memory_order_relaxed);
+                }
+                enqueue_pos_.store(0, std::memory_order_relaxed);
+                dequeue_pos_.store(0, std::memory_order_relaxed);
+            }
+
+            bounded_queue(const bounded_queue&) = delete;
+            bounded_queue& operator=(const bounded_queue&) = delete;
+
+            /**
+             * \brief claims a free slot and lets fill(T&) write into it
+             *
+             * \param [out] position the position the element was enqueued at
+             * \returns false if the queue is full, fill is not called in that case
+             */
+            template <typename F>
+            bool try_push(F&& fill, std::size_t& position)
+            {
+                cell* c;
+                std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+
+                while (true)
+                {
+                    c = &buffer_[pos & mask_];
+                    std::size_t seq = c->sequence.load(std::memory_order_acquire);
+                    auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+
+                    if (diff == 0)
+                    {
+                        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                                               std::memory_order_relaxed))
+                        {
+                            break;
+                        }
+                    }
+                    else if (diff < 0)
+                    {
+                        return false;
+                    }
+                    else
+                    {
+                        pos = enqueue_pos_.load(std::memory_order_relaxed);
+                    }
+                }
+
+                position = pos;
+
+                // the slot is claimed, so it has to be published even if fill throws
+                publish_guard guard(c->sequence, pos + 1);
+                fill(c->data);
+
+                return true;
+            }
+
+            template <typename F>
+            bool try_push(F&& fill)
+            {
+                std::size_t position;
+                return try_push(std::forward<F>(fill), position);
+            }
+
+            /**
+             * \brief takes the oldest element and lets consume(T&) read it in place
+             *
+             * \returns false if the queue is empty, consume is not called in that case
+             */
+            template <typename F>
+            bool try_pop(F&& consume)
+            {
+                return try_pop_if([](const T&) { return true; }, std::forward<F>(consume));
+            }
+
+            /**
+             * \brief like try_pop(), but only takes the oldest element if accept(const T&) does
+             *
+             * accept is called before the element is claimed, so a concurrent consumer may take
+             * it and a producer may reuse the slot at the same time. It may therefore only read
+             * atomic members of T. If its answer was based on such a reused slot, the element is
+             * not taken anyway and accept is asked again about the new oldest element.
+             *
+             * \returns false if the queue is empty or accept declined the oldest element
+             */
+            template <typename Accept, typename F>
+            bool try_pop_if(Accept&& accept, F&& consume)
+            {
+                cell* c;
+                std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+
+                while (true)
+                {
+                    c = &buffer_[pos & mask_];
+                    std::size_t seq = c->sequence.load(std::memory_order_acquire);
+                    auto diff =
+                        static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+
+                    if (diff == 0)
+                    {
+                        if (!accept(static_cast<const T&>(c->data)))
+                        {
+                            return false;
+                        }
+
+                        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1,
+                                                               std::memory_order_relaxed))
+                        {
+                            break;
+                        }
+                    }
+                    else if (diff < 0)
+                    {
+                        return false;
+                    }
+                    else
+                    {
+                        pos = dequeue_pos_.load(std::memory_order_relaxed);
+                    }
+                }
+
+                publish_guard guard(c->sequence, pos + mask_ + 1);
+                consume(c->data);
+
+                return true;
+            }
+
+            /**
+             * \brief whether the oldest slot holds no published element
+             *
+             * This is only a snapshot, concurrent producers may have changed it by the time the
+             * result is used.
+             */
+            bool empty() const
+            {
+                std::size_t pos = dequeue_pos_.load(std::memory_order_acquire);
+                return buffer_[pos & mask_].sequence.load(std::memory_order_acquire) != pos + 1;
+            }
+
+            std::size_t capacity() const
+            {
+                return mask_ + 1;
+            }
+
+            std::size_t enqueue_position() const
+            {
+                return enqueue_pos_.load(std::memory_order_acquire);
+            }
+
+            std::size_t dequeue_position() const
+            {
+                return dequeue_pos_.load(std::memory_order_acquire);
+            }
+
+        private:
+            static constexpr std::size_t cache_line = 64;
+
+            const std::size_t mask_;
+            std::unique_ptr<cell[]> buffer_;
+
+            alignas(cache_line) std::atomic<std::size_t> enqueue_pos_;
+            alignas(cache_line) std::atomic<std::size_t> dequeue_pos_;
+        };
+    } // namespace detail
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_DETAIL_BOUNDED_QUEUE_HPP
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_DETAIL_CALL_SITE_TAG_HPP
+#define INCLUDE_NITRO_LOG_DETAIL_CALL_SITE_TAG_HPP
+
+#include <nitro/log/call_site.hpp>
+#include <nitro/log/detail/tag_table.hpp>
+
+#include <nitro/lang/string_ref.hpp>
+
+#include <atomic>
+
+namespace nitro
+{
+namespace log
+{
+    namespace detail
+    {
+        /**
+         * \brief the id cached in the call site of a statement, if it is still the one of tag
+         *
+         * Returns invalid_tag_id otherwise.
+         */
+        inline tag_id cached_tag_id(const call_site& site, lang::string_ref tag)
+        {
+            auto id = call_site_state::tag_id(site).load(std::memory_order_relaxed);
+            if (id == invalid_tag_id)
+            {
+                return invalid_tag_id;
+            }
+
+            // both are terminated, so this needs neither the size of tag nor memcmp()
+            const char* a = tag_table::instance().name(id).get();
+            const char* b = tag.get();
+            while (*a != '\0' && *a == *b)
+            {
+                ++a;
+                ++b;
+            }
+            return *a == *b ? id : invalid_tag_id;
+        }
+
+        /**
+         * \brief the id of the tag of a statement, interning it if needed
+         *
+         * The id is cached in the call site of the statement. As long as the statement keeps its
+         * tag, this costs a load of the cached id and a comparison of the tag with the interned
+         * one, instead of hashing the tag and probing the tag table. The comparison keeps
+         * statements with changing tags, e.g. from a variable, correct.
+         *
+         * Returns invalid_tag_id for statements without tag and if the tag table is full.
+         */
+        inline tag_id call_site_tag_id(const call_site& site, lang::string_ref tag)
+        {
+            if (!tag)
+            {
+                return invalid_tag_id;
+            }
+
+            auto id = cached_tag_id(site, tag);
+            if (id == invalid_tag_id)
+            {
+                id = intern_tag(tag);
+                call_site_state::tag_id(site).store(id, std::memory_order_relaxed);
+            }
+            return id;
+        }
+
+        /**
+         * \brief Like call_site_tag_id(), but only finds tags, which are interned already
+         *
+         * For filters, which only need the ids of tags they were configured with, so tags of
+         * other statements do not fill the tag table. Returns invalid_tag_id for tags, which are
+         * not interned, without caching it.
+         */
+        inline tag_id call_site_find_tag_id(const call_site& site, lang::string_ref tag)
+        {
+            if (!tag)
+            {
+                return invalid_tag_id;
+            }
+
+            auto id = cached_tag_id(site, tag);
+            if (id == invalid_tag_id)
+            {
+                id = tag_table::instance().find(tag);
+                if (id != invalid_tag_id)
+                {
+                    call_site_state::tag_id(site).store(id, std::memory_order_relaxed);
+                }
+            }
+            return id;
+        }
+    } // namespace detail
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_DETAIL_CALL_SITE_TAG_HPP
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_DETAIL_EMERGENCY_WRITERS_HPP
+#define INCLUDE_NITRO_LOG_DETAIL_EMERGENCY_WRITERS_HPP
+
+#include <atomic>
+#include <cstddef>
+
+namespace nitro
+{
+namespace log
+{
+    namespace detail
+    {
+        /**
+         * \brief Sinks, which can write their buffered records from a signal handler
+         *
+         * A sink, which keeps records in a buffer of its own, adds a function, which writes the
+         * buffer and then a final record using only async-signal-safe calls. The crash handler
+         * calls all of them before the process dies. The slots are preallocated and lock-free, so
+         * they can be walked from a signal handler.
+         */
+        class emergency_writers
+        {
+        public:
+            /// writes the buffered records of context, followed by final_record
+            using function = void (*)(void* context, const char* final_record, std::size_t size);
+
+            static constexpr std::size_t capacity = 32;
+
+            /// returns false, if all slots are taken
+            static bool add(function f, void* context)
+            {
+                for (auto& s : slots())
+                {
+                    if (!s.reserved.exchange(true, std::memory_order_acquire))
+                    {
+                        s.context = context;
+                        s.f.store(f, std::memory_order_release);
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            static void remove(function f, void* context)
+            {
+                for (auto& s : slots())
+                {
+                    if (s.f.load(std::memory_order_acquire) == f && s.context == context)
+                    {
+                        s.f.store(nullptr, std::memory_order_relaxed);
+                        s.reserved.store(false, std::memory_order_release);
+                    }
+                }
+            }
+
+            /// calls every function, async-signal-safe as long as the functions are
+            static void write_all(const char* final_record, std::size_t size)
+            {
+                for (auto& s : slots())
+                {
+                    if (auto f = s.f.load(std::memory_order_acquire))
+                    {
+                        f(s.context, final_record, size);
+                    }
+                }
+            }
+
+        private:
+            struct slot
+            {
+                std::atomic<bool> reserved{ false };
+                std::atomic<function> f{ nullptr };
+                void* context = nullptr;
+            };
+
+            using slot_array = slot[capacity];
+
+            static slot_array& slots()
+            {
+                // constant-initialized, so it is usable before and after static construction
+                static slot_array slots_;
+                return slots_;
+            }
+        };
+    } // namespace detail
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_DETAIL_EMERGENCY_WRITERS_HPP
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_DETAIL_FORMATS_INTO_STREAM_HPP
+#define INCLUDE_NITRO_LOG_DETAIL_FORMATS_INTO_STREAM_HPP
+
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+namespace nitro
+{
+namespace log
+{
+    namespace detail
+    {
+        /**
+         * \brief Whether the Formatter can write a record into a std::ostream
+         *
+         * Formatters can either return the formatted record as a std::string or provide
+         * void format(Record&, std::ostream&). The latter writes into a reused buffer and avoids
+         * the allocation of the string.
+         */
+        template <typename Formatter, typename Record, typename = void>
+        struct formats_into_stream : std::false_type
+        {
+        };
+
+        template <typename Formatter, typename Record>
+        struct formats_into_stream<Formatter, Record,
+                                   decltype(std::declval<Formatter&>().format(
+                                                std::declval<Record&>(),
+                                                std::declval<std::ostream&>()),
+                                            void())> : std::true_type
+        {
+        };
+    } // namespace detail
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_DETAIL_FORMATS_INTO_STREAM_HPP
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_DETAIL_INTERN_TABLE_HPP
+#define INCLUDE_NITRO_LOG_DETAIL_INTERN_TABLE_HPP
+
+#include <nitro/lang/string_ref.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace nitro
+{
+namespace log
+{
+    namespace detail
+    {
+        /**
+         * \brief Interns strings to dense integer ids
+         *
+         * Lookups are lock-free and can run concurrently to inserts, which take a mutex. Strings
+         * are never removed, so ids and names stay valid for the lifetime of the program. At most
+         * MaxSize strings can be interned, further strings and empty strings get invalid_id.
+         *
+         * \tparam Domain distinguishes tables of different kinds of strings
+         * \tparam MaxSize the maximum number of strings
+         */
+        template <typename Domain, std::size_t MaxSize>
+        class intern_table
+        {
+        public:
+            using id_type = std::uint32_t;
+
+            static constexpr id_type invalid_id = static_cast<id_type>(-1);
+            static constexpr std::size_t max_size = MaxSize;
+
+            static intern_table& instance()
+            {
+                // never destroyed, so strings can still be looked up while statics are destroyed
+                static intern_table* table = new intern_table();
+                return *table;
+            }
+
+            /// the id of an already interned string, or invalid_id
+            id_type find(lang::string_ref str) const
+            {
+                const auto size = str.size();
+                if (size == 0)
+                {
+                    return invalid_id;
+                }
+
+                const auto hash = hash_of(str.get(), size);
+
+                for (auto slot = hash % slot_count;; slot = (slot + 1) % slot_count)
+                {
+                    const entry* e = slots_[slot].load(std::memory_order_acquire);
+
+                    if (e == nullptr)
+                    {
+                        return invalid_id;
+                    }
+
+                    if (e->hash == hash && e->name.size() == size &&
+                        std::memcmp(e->name.data(), str.get(), size) == 0)
+                    {
+                        return e->id;
+                    }
+                }
+            }
+
+            /// the id of str, which is interned if it was not yet
+            id_type intern(lang::string_ref str)
+            {
+                auto id = find(str);
+                if (id != invalid_id)
+                {
+                    return id;
+                }
+
+                std::lock_guard<std::mutex> lock(mutex_);
+
+                id = find(str);
+                if (id != invalid_id || str.size() == 0 || size() == max_size)
+                {
+                    return id;
+                }
+
+                std::unique_ptr<entry> e(new entry);
+                e->name = str.str();
+                e->hash = hash_of(e->name.data(), e->name.size());
+                e->id = id = static_cast<id_type>(size());
+
+                auto slot = e->hash % slot_count;
+                while (slots_[slot].load(std::memory_order_relaxed) != nullptr)
+                {
+                    slot = (slot + 1) % slot_count;
+                }
+
+                names_[e->id].store(e.get(), std::memory_order_release);
+                slots_[slot].store(e.release(), std::memory_order_release);
+                size_.store(id + 1, std::memory_order_release);
+
+                return id;
+            }
+
+            /// the interned string, or nullptr for invalid ids
+            lang::string_ref name(id_type id) const
+            {
+                if (id >= max_size)
+                {
+                    return nullptr;
+                }
+
+                const entry* e = names_[id].load(std::memory_order_acquire);
+                if (e == nullptr)
+                {
+                    return nullptr;
+                }
+
+                return lang::string_ref(e->name);
+            }
+
+            /// the interned string, or an empty string for invalid ids
+            const std::string& str(id_type id) const
+            {
+                static const std::string empty;
+
+                if (id >= max_size)
+                {
+                    return empty;
+                }
+
+                const entry* e = names_[id].load(std::memory_order_acquire);
+                if (e == nullptr)
+                {
+                    return empty;
+                }
+
+                return e->name;
+            }
+
+            std::size_t size() const
+            {
+                return size_.load(std::memory_order_acquire);
+            }
+
+        private:
+            intern_table() = default;
+
+            struct entry
+            {
+                std::string name;
+                std::size_t hash;
+                id_type id;
+            };
+
+            // twice the maximum number of strings, so probe sequences stay short
+            static constexpr std::size_t slot_count = 2 * max_size;
+
+            static std::size_t hash_of(const char* data, std::size_t size)
+            {
+                // FNV-1a
+                std::uint64_t hash = 14695981039346656037ull;
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    hash ^= static_cast<unsigned char>(data[i]);
+                    hash *= 1099511628211ull;
+                }
+                return static_cast<std::size_t>(hash);
+            }
+
+            std::atomic<const entry*> slots_[slot_count] = {};
+            std::atomic<const entry*> names_[max_size] = {};
+            std::atomic<std::size_t> size_{ 0 };
+            std::mutex mutex_;
+        };
+    } // namespace detail
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_DETAIL_INTERN_TABLE_HPP
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_DETAIL_MMAP_RING_FORMAT_HPP
+#define INCLUDE_NITRO_LOG_DETAIL_MMAP_RING_FORMAT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace nitro
+{
+namespace log
+{
+    namespace detail
+    {
+        /*
+         * On-disk layout of the mmap_ring sink, shared by the sink and the reader. All integers
+         * are in host byte order.
+         *
+         * The file starts with a header of mmap_ring_header_size bytes:
+         *
+         *   offset  0: char[8]  "NITRORNG"
+         *   offset  8: uint32   format version
+         *   offset 12: uint32   header size
+         *   offset 16: uint64   capacity of the data area in bytes
+         *   offset 24: uint64   write position, the number of bytes ever reserved
+         *
+         * The write cursor into the data area is write position % capacity, the number of times
+         * the buffer wrapped around is write position / capacity. Keeping both in one counter
+         * lets writers reserve space with a single atomic fetch_add.
+         *
+         * The data area follows the header. Every record is a frame of a 16 byte frame header
+         *
+         *   offset  0: uint32   mmap_ring_frame_magic, written last
+         *   offset  4: uint32   length of the record
+         *   offset  8: uint64   write position of the frame
+         *
+         * and the record, padded to a multiple of mmap_ring_alignment. Frames start at multiples
+         * of mmap_ring_alignment, so frame headers are never split at the end of the data area,
+         * but records may be. A frame is only valid if its magic is set and its stored position
+         * matches the position it was found at, which rejects stale frames of earlier rounds and
+         * frames that were not completely written when the process died.
+         */
+
+        constexpr std::uint32_t mmap_ring_version = 1;
+
+        constexpr std::size_t mmap_ring_header_size = 64;
+        constexpr std::size_t mmap_ring_version_offset = 8;
+        constexpr std::size_t mmap_ring_header_size_offset = 12;
+        constexpr std::size_t mmap_ring_capacity_offset = 16;
+        constexpr std::size_t mmap_ring_position_offset = 24;
+
+        constexpr std::size_t mmap_ring_alignment = 16;
+        constexpr std::size_t mmap_ring_frame_header_size = 16;
+        constexpr std::uint32_t mmap_ring_frame_magic = 0x52465452; // "RTFR"
+
+        inline const char* mmap_ring_magic()
+        {
+            return "NITRORNG";
+        }
+
+        constexpr std::size_t mmap_ring_magic_size = 8;
+
+        constexpr std::uint64_t mmap_ring_frame_size(std::uint64_t length)
+        {
+            return (mmap_ring_frame_header_size + length + mmap_ring_alignment - 1) &
+                   ~static_cast<std::uint64_t>(mmap_ring_alignment - 1);
+        }
+
+        template <typename T>
+        T mmap_ring_load(const char* data)
+        {
+            T value;
+            std::memcpy(&value, data, sizeof(T));
+            return value;
+        }
+
+        template <typename T>
+        void mmap_ring_store(char* data, T value)
+        {
+            std::memcpy(data, &value, sizeof(T));
+        }
+    } // namespace detail
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_DETAIL_MMAP_RING_FORMAT_HPP
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_DETAIL_POST_FILTER_HPP
+#define INCLUDE_NITRO_LOG_DETAIL_POST_FILTER_HPP
+
+#include <nitro/lang/string_ref.hpp>
+
+#include <type_traits>
+#include <utility>
+
+namespace nitro
+{
+namespace log
+{
+    namespace detail
+    {
+        /**
+         * \brief Whether the Filter checks the record again, once its message is written
+         *
+         * Such filters provide bool post_filter(Record&, lang::string_ref& preceding) const. It is
+         * called for records passing filter(Record&), after the message was written and the
+         * timestamp was taken. It returns false, if the record is not to be written. If it sets
+         * preceding, a record with the same attributes, but preceding as message, is written
+         * before, whether the record passes or not. The filter has to keep the preceding message
+         * valid until its next call on the same thread.
+         */
+        template <typename Filter, typename Record, typename = void>
+        struct has_post_filter : std::false_type
+        {
+        };
+
+        template <typename Filter, typename Record>
+        struct has_post_filter<Filter, Record,
+                               decltype(std::declval<const Filter&>().post_filter(
+                                            std::declval<Record&>(),
+                                            std::declval<lang::string_ref&>()),
+                                        void())> : std::true_type
+        {
+        };
+
+        template <typename Filter, typename Record>
+        std::enable_if_t<has_post_filter<Filter, Record>::value, bool>
+        post_filter(const Filter& f, Record& r, lang::string_ref& preceding)
+        {
+            return f.post_filter(r, preceding);
+        }
+
+        template <typename Filter, typename Record>
+        std::enable_if_t<!has_post_filter<Filter, Record>::value, bool>
+        post_filter(const Filter&, Record&, lang::string_ref&)
+        {
+            return true;
+        }
+    } // namespace detail
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_DETAIL_POST_FILTER_HPP
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_DETAIL_PRE_FILTER_HPP
+#define INCLUDE_NITRO_LOG_DETAIL_PRE_FILTER_HPP
+
+#include <nitro/log/severity.hpp>
+
+#include <nitro/lang/string_ref.hpp>
+
+#include <type_traits>
+#include <utility>
+
+namespace nitro
+{
+namespace log
+{
+    class call_site;
+
+    namespace detail
+    {
+        /**
+         * \brief Whether the Filter can reject a log statement before its record is constructed
+         *
+         * Such filters provide bool pre_filter(severity_level, lang::string_ref tag) const. It
+         * returns false, if the filter would reject every record with this severity and tag.
+         * filter(Record&) is still called for records passing pre_filter.
+         */
+        template <typename Filter, typename = void>
+        struct has_pre_filter : std::false_type
+        {
+        };
+
+        template <typename Filter>
+        struct has_pre_filter<Filter, decltype(std::declval<const Filter&>().pre_filter(
+                                                   std::declval<severity_level>(),
+                                                   std::declval<lang::string_ref>()),
+                                               void())> : std::true_type
+        {
+        };
+
+        template <typename Filter>
+        std::enable_if_t<has_pre_filter<Filter>::value, bool>
+        pre_filter(const Filter& f, severity_level severity, lang::string_ref tag)
+        {
+            return f.pre_filter(severity, tag);
+        }
+
+        template <typename Filter>
+        std::enable_if_t<!has_pre_filter<Filter>::value, bool>
+        pre_filter(const Filter&, severity_level, lang::string_ref)
+        {
+            return true;
+        }
+
+        /**
+         * \brief Whether the Filter can make use of the call site of the log statement
+         *
+         * Such filters provide bool pre_filter(severity_level, lang::string_ref tag,
+         * const call_site&) const in addition, which is called instead for statements of
+         * NITRO_LOG and NITRO_LOG_TAG. The call site can cache per statement what the filter
+         * derives from the tag, see detail::call_site_tag_id().
+         */
+        template <typename Filter, typename = void>
+        struct has_call_site_pre_filter : std::false_type
+        {
+        };
+
+        template <typename Filter>
+        struct has_call_site_pre_filter<Filter,
+                                        decltype(std::declval<const Filter&>().pre_filter(
+                                                     std::declval<severity_level>(),
+                                                     std::declval<lang::string_ref>(),
+                                                     std::declval<const call_site&>()),
+                                                 void())> : std::true_type
+        {
+        };
+
+        template <typename Filter>
+        std::enable_if_t<has_call_site_pre_filter<Filter>::value, bool>
+        pre_filter(const Filter& f, severity_level severity, lang::string_ref tag,
+                   const call_site& site)
+        {
+            return f.pre_filter(severity, tag, site);
+        }
+
+        template <typename Filter>
+        std::enable_if_t<!has_call_site_pre_filter<Filter>::value, bool>
+        pre_filter(const Filter& f, severity_level severity, lang::string_ref tag,
+                   const call_site&)
+        {
+            return pre_filter(f, severity, tag);
+        }
+    } // namespace detail
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_DETAIL_PRE_FILTER_HPP
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_DETAIL_PROCESS_IDENTITY_HPP
+#define INCLUDE_NITRO_LOG_DETAIL_PROCESS_IDENTITY_HPP
+
+#include <nitro/env/hostname.hpp>
+#include <nitro/env/process.hpp>
+
+#include <string>
+
+#ifndef _WIN32
+extern "C"
+{
+#include <pthread.h>
+}
+#endif
+
+namespace nitro
+{
+namespace log
+{
+    namespace detail
+    {
+        /**
+         * \brief Process and thread ids, which are only queried once
+         *
+         * The pid is cached for the process, the tid for every thread. A handler registered with
+         * pthread_atfork updates both in the child process of a fork(). As only the forking
+         * thread exists in the child, the caches of other threads do not need to be updated.
+         */
+        class process_identity
+        {
+        public:
+            static int pid()
+            {
+                return instance().pid_;
+            }
+
+            static int tid()
+            {
+                auto& tid = thread_tid();
+                if (tid == 0)
+                {
+                    // makes sure the fork handler is registered, before the tid is cached
+                    instance();
+                    tid = env::get_tid();
+                }
+                return tid;
+            }
+
+        private:
+            process_identity() : pid_(env::get_pid())
+            {
+#ifndef _WIN32
+                pthread_atfork(nullptr, nullptr, &process_identity::after_fork_in_child);
+#endif
+            }
+
+            static process_identity& instance()
+            {
+                // never destroyed, so records can still be created while statics are destroyed
+                static process_identity* identity = new process_identity();
+                return *identity;
+            }
+
+            static int& thread_tid()
+            {
+                static thread_local int tid = 0;
+                return tid;
+            }
+
+            static void after_fork_in_child()
+            {
+                instance().pid_ = env::get_pid();
+                thread_tid() = env::get_tid();
+            }
+
+            int pid_;
+        };
+
+        /**
+         * \brief the name of the host, queried once per process
+         *
+         * A change of the host name while the process runs is not noticed.
+         */
+        inline const std::string& cached_hostname()
+        {
+            // never destroyed, for the same reason as process_identity
+            static const std::string* hostname = new std::string(env::hostname());
+            return *hostname;
+        }
+    } // namespace detail
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_DETAIL_PROCESS_IDENTITY_HPP
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_DETAIL_RECORD_KEY_HPP
+#define INCLUDE_NITRO_LOG_DETAIL_RECORD_KEY_HPP
+
+#include <nitro/log/attribute/call_site.hpp>
+#include <nitro/log/call_site.hpp>
+#include <nitro/log/detail/has_attribute.hpp>
+#include <nitro/log/detail/call_site_tag.hpp>
+#include <nitro/log/detail/record_tag_id.hpp>
+#include <nitro/log/detail/tag_table.hpp>
+
+#include <nitro/lang/string_ref.hpp>
+
+#include <cstddef>
+#include <type_traits>
+
+namespace nitro
+{
+namespace log
+{
+    namespace detail
+    {
+        /// the number of call sites with a key of their own, later ones are keyed by their tag
+        constexpr std::size_t call_site_keys = 1024;
+
+        /// the number of keys returned by record_key(), the last one is for untagged records
+        constexpr std::size_t record_keys = call_site_keys + tag_table::max_size + 1;
+
+        inline std::size_t tag_key(tag_id id)
+        {
+            return id == invalid_tag_id ? record_keys - 1 : call_site_keys + id;
+        }
+
+        template <typename Record>
+        std::size_t record_tag_key(Record& r)
+        {
+            return tag_key(record_tag_id(r));
+        }
+
+        template <typename Record>
+        std::size_t record_key(Record& r, std::true_type)
+        {
+            auto site = r.call_site();
+            if (site != nullptr && site->id() < call_site_keys)
+            {
+                return site->id();
+            }
+            return record_tag_key(r);
+        }
+
+        template <typename Record>
+        std::size_t record_key(Record& r, std::false_type)
+        {
+            return record_tag_key(r);
+        }
+
+        /**
+         * \brief the key of the per-statement or per-tag state of filters for the record
+         *
+         * Records of a registered call site, see call_site_attribute, are keyed by the call
+         * site, all others by their tag. The keys are below record_keys.
+         */
+        template <typename Record>
+        std::size_t record_key(Record& r)
+        {
+            using has_call_site =
+                std::integral_constant<bool, has_attribute<call_site_attribute, Record>::value>;
+
+            return record_key(r, has_call_site());
+        }
+
+        /**
+         * \brief the key record_key() returns for the records of a statement with tag
+         *
+         * For pre_filter(), before the record exists.
+         */
+        inline std::size_t statement_key(lang::string_ref tag)
+        {
+            return tag && !tag.empty() ? tag_key(intern_tag(tag)) : record_keys - 1;
+        }
+
+        /**
+         * \brief Like statement_key(tag), for a statement of the given call site
+         */
+        inline std::size_t statement_key(lang::string_ref tag, const call_site& site)
+        {
+            if (site.id() < call_site_keys)
+            {
+                return site.id();
+            }
+            return tag && !tag.empty() ? tag_key(call_site_tag_id(site, tag)) : record_keys - 1;
+        }
+    } // namespace detail
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_DETAIL_RECORD_KEY_HPP
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_DETAIL_RECORD_TAG_ID_HPP
+#define INCLUDE_NITRO_LOG_DETAIL_RECORD_TAG_ID_HPP
+
+#include <nitro/log/attribute/interned_tag.hpp>
+#include <nitro/log/attribute/tag.hpp>
+#include <nitro/log/detail/has_attribute.hpp>
+#include <nitro/log/detail/tag_table.hpp>
+
+#include <type_traits>
+
+namespace nitro
+{
+namespace log
+{
+    namespace detail
+    {
+        template <typename Record>
+        tag_id record_tag_id(Record& r, std::true_type, std::false_type)
+        {
+            return r.interned_tag();
+        }
+
+        template <typename Record>
+        tag_id record_tag_id(Record& r, std::false_type, std::true_type)
+        {
+            const auto& tag = r.tag();
+            if (tag.empty())
+            {
+                return invalid_tag_id;
+            }
+
+            auto id = tag_table::instance().find(tag);
+            return id != invalid_tag_id ? id : intern_tag(tag);
+        }
+
+        template <typename Record>
+        tag_id record_tag_id(Record&, std::false_type, std::false_type)
+        {
+            return invalid_tag_id;
+        }
+
+        /**
+         * \brief the id of the tag of the record, interning it if needed
+         *
+         * Returns invalid_tag_id for records without tag and if the tag table is full.
+         */
+        template <typename Record>
+        tag_id record_tag_id(Record& r)
+        {
+            using has_interned_tag =
+                std::integral_constant<bool, has_attribute<interned_tag_attribute, Record>::value>;
+            using has_tag =
+                std::integral_constant<bool, has_attribute<tag_attribute, Record>::value>;
+
+            return record_tag_id(r, has_interned_tag(), has_tag());
+        }
+    } // namespace detail
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_DETAIL_RECORD_TAG_ID_HPP
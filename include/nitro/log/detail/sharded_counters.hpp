@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_DETAIL_SHARDED_COUNTERS_HPP
+#define INCLUDE_NITRO_LOG_DETAIL_SHARDED_COUNTERS_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace nitro
+{
+namespace log
+{
+    namespace detail
+    {
+        /**
+         * \brief Size counters, which every thread increments on its own
+         *
+         * The counters of a thread are aligned to a cache line of their own, so an increment does
+         * not touch a cache line written by other threads. values() sums the counters of all
+         * threads, including exited ones. See thread_counter for a single counter.
+         *
+         * \tparam Domain distinguishes different sets of counters
+         */
+        template <typename Domain, std::size_t Size>
+        class sharded_counters
+        {
+            struct shared_state;
+
+        public:
+            class alignas(64) shard
+            {
+            public:
+                shard()
+                {
+                    auto& s = state();
+                    std::lock_guard<std::mutex> lock(s.mutex);
+                    s.live.push_back(this);
+                }
+
+                ~shard()
+                {
+                    auto& s = state();
+                    std::lock_guard<std::mutex> lock(s.mutex);
+                    for (std::size_t i = 0; i < Size; ++i)
+                    {
+                        s.retired[i] += values_[i].load(std::memory_order_relaxed);
+                    }
+                    s.live.erase(std::find(s.live.begin(), s.live.end(), this));
+                }
+
+                shard(const shard&) = delete;
+                shard& operator=(const shard&) = delete;
+
+                // only the owning thread writes, so this needs no read-modify-write
+                void add(std::size_t index, std::uint64_t n = 1)
+                {
+                    auto& value = values_[index];
+                    value.store(value.load(std::memory_order_relaxed) + n,
+                                std::memory_order_relaxed);
+                }
+
+            private:
+                friend class sharded_counters;
+
+                std::atomic<std::uint64_t> values_[Size] = {};
+            };
+
+            /// the counters of the calling thread, to add to several of them at once
+            static shard& local()
+            {
+                static thread_local shard shard_;
+                return shard_;
+            }
+
+            static void add(std::size_t index, std::uint64_t n = 1)
+            {
+                local().add(index, n);
+            }
+
+            static std::array<std::uint64_t, Size> values()
+            {
+                auto& s = state();
+                std::lock_guard<std::mutex> lock(s.mutex);
+
+                auto sums = s.retired;
+                for (auto shard : s.live)
+                {
+                    for (std::size_t i = 0; i < Size; ++i)
+                    {
+                        sums[i] += shard->values_[i].load(std::memory_order_relaxed);
+                    }
+                }
+                return sums;
+            }
+
+        private:
+            struct shared_state
+            {
+                std::mutex mutex;
+                std::vector<const shard*> live;
+                std::array<std::uint64_t, Size> retired = {};
+            };
+
+            static shared_state& state()
+            {
+                // never destroyed, so threads can still exit while statics are destroyed
+                static shared_state* state_ = new shared_state();
+                return *state_;
+            }
+        };
+    } // namespace detail
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_DETAIL_SHARDED_COUNTERS_HPP
@@ -0,0 +1,439 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_DETAIL_SHM_RING_HPP
+#define INCLUDE_NITRO_LOG_DETAIL_SHM_RING_HPP
+
+#include <nitro/log/severity.hpp>
+
+#include <nitro/except/raise.hpp>
+#include <nitro/lang/string_ref.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+extern "C"
+{
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+}
+
+namespace nitro
+{
+namespace log
+{
+    namespace detail
+    {
+        /*
+         * Layout of the shared memory segments of the shm_ring sink, shared by the sink and the
+         * collector. All integers are in host byte order.
+         *
+         * The segment starts with a header of shm_ring_header_size bytes:
+         *
+         *   offset   0: char[8]  "NITROSHM"
+         *   offset   8: uint32   format version
+         *   offset  12: uint32   header size
+         *   offset  16: uint64   capacity of the data area in bytes
+         *   offset  24: int64    pid of the process, which created the segment
+         *   offset  64: uint64   write position, the number of bytes ever reserved by producers
+         *   offset  72: uint64   number of records dropped, because the ring was full
+         *   offset 128: uint64   read position, the number of bytes ever consumed
+         *
+         * The positions are on cache lines of their own, as producers and the collector update
+         * them concurrently. Producers reserve space with a compare-and-swap of the write position
+         * and never get more than capacity bytes ahead of the read position, so nothing is
+         * overwritten before the collector consumed it.
+         *
+         * The data area follows the header. Every record is a frame of a 32 byte frame header
+         *
+         *   offset  0: uint32   shm_ring_frame_magic, written last
+         *   offset  4: uint32   length of the record
+         *   offset  8: uint64   write position of the frame
+         *   offset 16: int64    timestamp of the record in nanoseconds since the epoch
+         *   offset 24: uint32   severity of the record
+         *
+         * and the record, padded to a multiple of shm_ring_alignment. Frame headers are never
+         * split at the end of the data area, records may be. A frame is complete once its magic
+         * is set and its stored position matches the position it was found at. The collector
+         * clears the magic of every frame it consumed.
+         */
+
+        constexpr std::uint32_t shm_ring_version = 1;
+
+        constexpr std::size_t shm_ring_header_size = 192;
+        constexpr std::size_t shm_ring_version_offset = 8;
+        constexpr std::size_t shm_ring_header_size_offset = 12;
+        constexpr std::size_t shm_ring_capacity_offset = 16;
+        constexpr std::size_t shm_ring_pid_offset = 24;
+        constexpr std::size_t shm_ring_write_position_offset = 64;
+        constexpr std::size_t shm_ring_dropped_offset = 72;
+        constexpr std::size_t shm_ring_read_position_offset = 128;
+
+        constexpr std::size_t shm_ring_alignment = 32;
+        constexpr std::size_t shm_ring_frame_header_size = 32;
+        constexpr std::uint32_t shm_ring_frame_magic = 0x52464d53; // "SMFR"
+
+        inline const char* shm_ring_magic()
+        {
+            return "NITROSHM";
+        }
+
+        constexpr std::size_t shm_ring_magic_size = 8;
+
+        constexpr std::uint64_t shm_ring_frame_size(std::uint64_t length)
+        {
+            return (shm_ring_frame_header_size + length + shm_ring_alignment - 1) &
+                   ~static_cast<std::uint64_t>(shm_ring_alignment - 1);
+        }
+
+        /**
+         * \brief A mapped shared memory segment of the shm_ring sink
+         *
+         * Any number of threads and processes may push(), but only one may pop() at a time.
+         */
+        class shm_ring
+        {
+        public:
+            /**
+             * \brief creates the segment name, replacing an existing one
+             *
+             * \param capacity size of the data area, rounded up to a multiple of 32, at least
+             *                 4 KiB
+             */
+            static shm_ring create(const std::string& name, std::size_t capacity)
+            {
+                std::uint64_t rounded = std::max<std::uint64_t>(capacity, 4096);
+                rounded = (rounded + shm_ring_alignment - 1) &
+                          ~static_cast<std::uint64_t>(shm_ring_alignment - 1);
+
+                // a segment left behind by an earlier process with the same pid
+                ::shm_unlink(name.c_str());
+
+                int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+                if (fd == -1)
+                {
+                    raise("Cannot create shared memory segment ", name, ": ",
+                          std::strerror(errno));
+                }
+
+                const auto size = shm_ring_header_size + rounded;
+                if (::ftruncate(fd, static_cast<off_t>(size)) != 0)
+                {
+                    int error = errno;
+                    ::close(fd);
+                    ::shm_unlink(name.c_str());
+                    raise("Cannot resize shared memory segment ", name, ": ",
+                          std::strerror(error));
+                }
+
+                shm_ring ring(name, fd, size);
+
+                // the segment is zero-filled, so the positions need no initialization
+                std::uint32_t version = shm_ring_version;
+                std::memcpy(ring.base_ + shm_ring_version_offset, &version, 4);
+                std::uint32_t header_size = shm_ring_header_size;
+                std::memcpy(ring.base_ + shm_ring_header_size_offset, &header_size, 4);
+                std::memcpy(ring.base_ + shm_ring_capacity_offset, &rounded, 8);
+                std::int64_t pid = ::getpid();
+                std::memcpy(ring.base_ + shm_ring_pid_offset, &pid, 8);
+                ring.capacity_ = rounded;
+
+                // the magic is written last, so a collector never maps a half-initialized ring
+                std::atomic_thread_fence(std::memory_order_release);
+                std::memcpy(ring.base_, shm_ring_magic(), shm_ring_magic_size);
+
+                return ring;
+            }
+
+            /**
+             * \brief maps the existing segment name, e.g. in the collector
+             */
+            static shm_ring open(const std::string& name)
+            {
+                int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+                if (fd == -1)
+                {
+                    raise("Cannot open shared memory segment ", name, ": ", std::strerror(errno));
+                }
+
+                struct stat info;
+                if (::fstat(fd, &info) != 0 ||
+                    static_cast<std::size_t>(info.st_size) <= shm_ring_header_size)
+                {
+                    ::close(fd);
+                    raise("Not a log ring: ", name);
+                }
+
+                shm_ring ring(name, fd, static_cast<std::size_t>(info.st_size));
+
+                std::uint32_t version;
+                std::uint64_t capacity;
+                std::memcpy(&version, ring.base_ + shm_ring_version_offset, 4);
+                std::memcpy(&capacity, ring.base_ + shm_ring_capacity_offset, 8);
+
+                if (std::memcmp(ring.base_, shm_ring_magic(), shm_ring_magic_size) != 0 ||
+                    version != shm_ring_version ||
+                    capacity != ring.size_ - shm_ring_header_size)
+                {
+                    raise("Not a log ring: ", name);
+                }
+                std::atomic_thread_fence(std::memory_order_acquire);
+
+                ring.capacity_ = capacity;
+                return ring;
+            }
+
+            shm_ring(shm_ring&& other)
+            : name_(std::move(other.name_)), base_(other.base_), size_(other.size_),
+              capacity_(other.capacity_)
+            {
+                other.base_ = nullptr;
+            }
+
+            shm_ring& operator=(shm_ring&& other)
+            {
+                unmap();
+
+                name_ = std::move(other.name_);
+                base_ = other.base_;
+                size_ = other.size_;
+                capacity_ = other.capacity_;
+                other.base_ = nullptr;
+
+                return *this;
+            }
+
+            shm_ring(const shm_ring&) = delete;
+            shm_ring& operator=(const shm_ring&) = delete;
+
+            ~shm_ring()
+            {
+                unmap();
+            }
+
+            const std::string& name() const
+            {
+                return name_;
+            }
+
+            std::uint64_t capacity() const
+            {
+                return capacity_;
+            }
+
+            /// the process, which created the segment
+            pid_t pid() const
+            {
+                std::int64_t pid;
+                std::memcpy(&pid, base_ + shm_ring_pid_offset, 8);
+                return static_cast<pid_t>(pid);
+            }
+
+            std::uint64_t dropped() const
+            {
+                return position(shm_ring_dropped_offset).load(std::memory_order_relaxed);
+            }
+
+            /**
+             * \brief copies a record into the ring
+             *
+             * Records longer than the capacity are truncated. Returns false and counts the record
+             * as dropped, if the ring is full.
+             */
+            bool push(std::int64_t timestamp, severity_level sev, lang::string_ref record)
+            {
+                const std::uint64_t length = std::min<std::uint64_t>(
+                    record.size(), capacity_ - shm_ring_frame_header_size);
+                const auto frame_size = shm_ring_frame_size(length);
+
+                auto& write_position = position(shm_ring_write_position_offset);
+                auto& read_position = position(shm_ring_read_position_offset);
+
+                auto pos = write_position.load(std::memory_order_relaxed);
+                do
+                {
+                    // Acquire, so the collector is done with the space before it is reused. pos
+                    // may be stale and behind the read position, which must not underflow and
+                    // drop the record, the CAS fails then and reloads pos.
+                    if (pos + frame_size >
+                        read_position.load(std::memory_order_acquire) + capacity_)
+                    {
+                        position(shm_ring_dropped_offset).fetch_add(1, std::memory_order_relaxed);
+                        return false;
+                    }
+                } while (!write_position.compare_exchange_weak(pos, pos + frame_size,
+                                                               std::memory_order_relaxed));
+
+                char* frame = data() + pos % capacity_;
+
+                const auto size = static_cast<std::uint32_t>(length);
+                const auto severity = static_cast<std::uint32_t>(sev);
+                std::memcpy(frame + 4, &size, 4);
+                std::memcpy(frame + 8, &pos, 8);
+                std::memcpy(frame + 16, &timestamp, 8);
+                std::memcpy(frame + 24, &severity, 4);
+
+                auto offset = (pos + shm_ring_frame_header_size) % capacity_;
+                auto first = std::min<std::uint64_t>(length, capacity_ - offset);
+                std::memcpy(data() + offset, record.get(), first);
+                std::memcpy(data(), record.get() + first, length - first);
+
+                magic(frame).store(shm_ring_frame_magic, std::memory_order_release);
+                return true;
+            }
+
+            /**
+             * \brief passes all complete records to f and frees their space
+             *
+             * f is called as f(timestamp, severity, const char* first, size_t first_size,
+             * const char* second, size_t second_size), as records may wrap around the end of the
+             * ring. Stops at the first record, which is still being written. Returns the number of
+             * records passed.
+             */
+            template <typename F>
+            std::size_t pop(F&& f)
+            {
+                auto& read_position = position(shm_ring_read_position_offset);
+
+                auto read = read_position.load(std::memory_order_relaxed);
+                const auto write =
+                    position(shm_ring_write_position_offset).load(std::memory_order_acquire);
+
+                std::size_t count = 0;
+                while (read < write)
+                {
+                    char* frame = data() + read % capacity_;
+
+                    if (magic(frame).load(std::memory_order_acquire) != shm_ring_frame_magic)
+                    {
+                        break;
+                    }
+
+                    std::uint64_t pos;
+                    std::uint32_t length;
+                    std::int64_t timestamp;
+                    std::uint32_t severity;
+                    std::memcpy(&length, frame + 4, 4);
+                    std::memcpy(&pos, frame + 8, 8);
+                    std::memcpy(&timestamp, frame + 16, 8);
+                    std::memcpy(&severity, frame + 24, 4);
+
+                    if (pos != read || length > capacity_ - shm_ring_frame_header_size)
+                    {
+                        break;
+                    }
+
+                    auto offset = (read + shm_ring_frame_header_size) % capacity_;
+                    auto first = std::min<std::uint64_t>(length, capacity_ - offset);
+                    f(timestamp, static_cast<severity_level>(severity), data() + offset,
+                      static_cast<std::size_t>(first), data(),
+                      static_cast<std::size_t>(length - first));
+
+                    magic(frame).store(0, std::memory_order_relaxed);
+                    read += shm_ring_frame_size(length);
+                    ++count;
+                }
+
+                read_position.store(read, std::memory_order_release);
+                return count;
+            }
+
+            /// whether there are records, which were not popped yet
+            bool empty() const
+            {
+                return position(shm_ring_read_position_offset).load(std::memory_order_relaxed) ==
+                       position(shm_ring_write_position_offset).load(std::memory_order_acquire);
+            }
+
+            /// removes the name of the segment, it stays mapped until it is destroyed
+            void unlink()
+            {
+                ::shm_unlink(name_.c_str());
+            }
+
+        private:
+            shm_ring(const std::string& name, int fd, std::size_t size) : name_(name), size_(size)
+            {
+                void* base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                int error = errno;
+                ::close(fd);
+
+                if (base == MAP_FAILED)
+                {
+                    raise("Cannot map shared memory segment ", name, ": ", std::strerror(error));
+                }
+
+                base_ = static_cast<char*>(base);
+            }
+
+            void unmap()
+            {
+                if (base_ != nullptr)
+                {
+                    ::munmap(base_, size_);
+                    base_ = nullptr;
+                }
+            }
+
+            char* data() const
+            {
+                return base_ + shm_ring_header_size;
+            }
+
+            // the positions and the frame magic are plain integers in the segment
+            std::atomic<std::uint64_t>& position(std::size_t offset) const
+            {
+                static_assert(sizeof(std::atomic<std::uint64_t>) == sizeof(std::uint64_t),
+                              "The positions must be plain 64 bit integers in the segment");
+                return *reinterpret_cast<std::atomic<std::uint64_t>*>(base_ + offset);
+            }
+
+            static std::atomic<std::uint32_t>& magic(char* frame)
+            {
+                static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t),
+                              "The frame magic must be a plain 32 bit integer in the segment");
+                return *reinterpret_cast<std::atomic<std::uint32_t>*>(frame);
+            }
+
+            std::string name_;
+            char* base_ = nullptr;
+            std::size_t size_;
+            std::uint64_t capacity_ = 0;
+        };
+    } // namespace detail
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_DETAIL_SHM_RING_HPP
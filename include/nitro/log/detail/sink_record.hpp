@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_DETAIL_SINK_RECORD_HPP
+#define INCLUDE_NITRO_LOG_DETAIL_SINK_RECORD_HPP
+
+#include <nitro/log/severity.hpp>
+
+#include <nitro/lang/string_ref.hpp>
+
+#include <type_traits>
+#include <utility>
+
+namespace nitro
+{
+namespace log
+{
+    namespace detail
+    {
+        /**
+         * \brief Whether the Sink wants the record next to the formatted record
+         *
+         * Sinks can provide
+         * void sink(severity_level, lang::string_ref formatted_record, const Record& r)
+         * in addition to the usual two argument version, e.g. to get the timestamp of the record.
+         */
+        template <typename Sink, typename Record, typename = void>
+        struct accepts_record : std::false_type
+        {
+        };
+
+        template <typename Sink, typename Record>
+        struct accepts_record<Sink, Record,
+                              decltype(std::declval<Sink&>().sink(
+                                           std::declval<severity_level>(),
+                                           std::declval<lang::string_ref>(),
+                                           std::declval<const Record&>()),
+                                       void())> : std::true_type
+        {
+        };
+
+        /// passes a formatted record to sink, together with the record if it accepts it
+        template <typename Sink, typename Record>
+        std::enable_if_t<accepts_record<Sink, Record>::value>
+        sink_record(Sink& sink, severity_level sev, lang::string_ref formatted_record,
+                    const Record& r)
+        {
+            sink.sink(sev, formatted_record, r);
+        }
+
+        template <typename Sink, typename Record>
+        std::enable_if_t<!accepts_record<Sink, Record>::value>
+        sink_record(Sink& sink, severity_level sev, lang::string_ref formatted_record,
+                    const Record&)
+        {
+            sink.sink(sev, formatted_record);
+        }
+    } // namespace detail
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_DETAIL_SINK_RECORD_HPP
@@ -0,0 +1,339 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_DETAIL_STREAM_BUFFER_HPP
+#define INCLUDE_NITRO_LOG_DETAIL_STREAM_BUFFER_HPP
+
+#include <nitro/lang/string_ref.hpp>
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+
+namespace nitro
+{
+namespace log
+{
+    namespace detail
+    {
+        /**
+         * \brief A growable character buffer, which can be written to with a std::ostream
+         *
+         * Small contents are stored inline. If the buffer grows, the heap storage is kept after
+         * clear(), so a reused buffer stops allocating once it has seen its largest content.
+         * Storage larger than max_retained is released on clear() though.
+         */
+        class stream_buffer : public std::streambuf
+        {
+        public:
+            static constexpr std::size_t inline_capacity = 512;
+            static constexpr std::size_t max_retained = 64 * 1024;
+
+            stream_buffer()
+            {
+                reset_to_inline();
+            }
+
+            stream_buffer(const stream_buffer&) = delete;
+            stream_buffer& operator=(const stream_buffer&) = delete;
+
+            const char* data() const
+            {
+                return pbase();
+            }
+
+            std::size_t size() const
+            {
+                return static_cast<std::size_t>(pptr() - pbase());
+            }
+
+            void clear()
+            {
+                if (heap_ && capacity() > max_retained)
+                {
+                    heap_.reset();
+                    reset_to_inline();
+                }
+                else
+                {
+                    setp(pbase(), epptr());
+                }
+            }
+
+            void append(const char* str, std::size_t count)
+            {
+                if (static_cast<std::size_t>(epptr() - pptr()) < count)
+                {
+                    grow(count);
+                }
+
+                std::memcpy(pptr(), str, count);
+                advance(count);
+            }
+
+            void push_back(char c)
+            {
+                if (pptr() == epptr())
+                {
+                    grow(1);
+                }
+
+                *pptr() = c;
+                pbump(1);
+            }
+
+            /**
+             * \brief a view of the contents, which is valid until the buffer is modified
+             */
+            lang::string_ref str()
+            {
+                // there is always room for the terminator, see capacity()
+                *pptr() = '\0';
+                return lang::string_ref(pbase(), size());
+            }
+
+        protected:
+            int_type overflow(int_type ch) override
+            {
+                if (traits_type::eq_int_type(ch, traits_type::eof()))
+                {
+                    return traits_type::not_eof(ch);
+                }
+
+                push_back(traits_type::to_char_type(ch));
+                return ch;
+            }
+
+            std::streamsize xsputn(const char* str, std::streamsize count) override
+            {
+                append(str, static_cast<std::size_t>(count));
+                return count;
+            }
+
+        private:
+            // the usable capacity, the put area always ends one char before the storage does
+            std::size_t capacity() const
+            {
+                return static_cast<std::size_t>(epptr() - pbase());
+            }
+
+            void reset_to_inline()
+            {
+                setp(inline_, inline_ + inline_capacity - 1);
+            }
+
+            void grow(std::size_t extra)
+            {
+                auto used = size();
+                auto new_capacity = std::max(2 * (capacity() + 1), used + extra + 1);
+
+                std::unique_ptr<char[]> storage(new char[new_capacity]);
+                std::memcpy(storage.get(), pbase(), used);
+                heap_ = std::move(storage);
+
+                setp(heap_.get(), heap_.get() + new_capacity - 1);
+                advance(used);
+            }
+
+            void advance(std::size_t count)
+            {
+                // pbump() only takes an int
+                while (count > static_cast<std::size_t>(INT_MAX))
+                {
+                    pbump(INT_MAX);
+                    count -= INT_MAX;
+                }
+                pbump(static_cast<int>(count));
+            }
+
+            char inline_[inline_capacity];
+            std::unique_ptr<char[]> heap_;
+        };
+
+        /**
+         * \brief A stream_buffer together with a std::ostream writing into it
+         *
+         * Constructing a std::ostream is not cheap, so both are reused. reset() restores the
+         * formatting state, which the previous user might have changed with manipulators.
+         */
+        class stream_slot
+        {
+        public:
+            stream_slot() : stream_(&buffer_)
+            {
+                flags_ = stream_.flags();
+                precision_ = stream_.precision();
+                fill_ = stream_.fill();
+            }
+
+            stream_slot(const stream_slot&) = delete;
+            stream_slot& operator=(const stream_slot&) = delete;
+
+            void reset()
+            {
+                buffer_.clear();
+                stream_.clear();
+                stream_.flags(flags_);
+                stream_.precision(precision_);
+                stream_.fill(fill_);
+                stream_.width(0);
+            }
+
+            stream_buffer& buffer()
+            {
+                return buffer_;
+            }
+
+            std::ostream& stream()
+            {
+                return stream_;
+            }
+
+            bool in_use = false;
+
+        private:
+            stream_buffer buffer_;
+            std::ostream stream_;
+            std::ios_base::fmtflags flags_;
+            std::streamsize precision_;
+            char fill_;
+        };
+
+        /**
+         * \brief Exclusive use of one of the stream_slots of the current thread
+         *
+         * Each thread has a few slots, which covers a record being formatted while its message
+         * is still alive and a log statement nested into another one. Only if all of them are in
+         * use, a fresh slot is allocated.
+         *
+         * A default constructed lease is empty.
+         */
+        class stream_lease
+        {
+            static constexpr std::size_t pool_size = 3;
+
+            static stream_slot* pool()
+            {
+                static thread_local stream_slot slots[pool_size];
+                return slots;
+            }
+
+        public:
+            stream_lease() : slot_(nullptr)
+            {
+            }
+
+            static stream_lease acquire()
+            {
+                stream_lease lease;
+
+                auto slots = pool();
+                for (std::size_t i = 0; i < pool_size; ++i)
+                {
+                    if (!slots[i].in_use)
+                    {
+                        lease.slot_ = &slots[i];
+                        break;
+                    }
+                }
+
+                if (lease.slot_ == nullptr)
+                {
+                    lease.owned_.reset(new stream_slot());
+                    lease.slot_ = lease.owned_.get();
+                }
+
+                lease.slot_->in_use = true;
+                lease.slot_->reset();
+
+                return lease;
+            }
+
+            stream_lease(stream_lease&& other)
+            : slot_(other.slot_), owned_(std::move(other.owned_))
+            {
+                other.slot_ = nullptr;
+            }
+
+            stream_lease& operator=(stream_lease&& other)
+            {
+                release();
+
+                slot_ = other.slot_;
+                owned_ = std::move(other.owned_);
+                other.slot_ = nullptr;
+
+                return *this;
+            }
+
+            stream_lease(const stream_lease&) = delete;
+            stream_lease& operator=(const stream_lease&) = delete;
+
+            ~stream_lease()
+            {
+                release();
+            }
+
+            void release()
+            {
+                if (slot_ != nullptr)
+                {
+                    slot_->in_use = false;
+                    slot_ = nullptr;
+                }
+                owned_.reset();
+            }
+
+            explicit operator bool() const
+            {
+                return slot_ != nullptr;
+            }
+
+            stream_buffer& buffer()
+            {
+                return slot_->buffer();
+            }
+
+            std::ostream& stream()
+            {
+                return slot_->stream();
+            }
+
+        private:
+            stream_slot* slot_;
+            std::unique_ptr<stream_slot> owned_;
+        };
+    } // namespace detail
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_DETAIL_STREAM_BUFFER_HPP
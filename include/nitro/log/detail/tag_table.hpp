@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_DETAIL_TAG_TABLE_HPP
+#define INCLUDE_NITRO_LOG_DETAIL_TAG_TABLE_HPP
+
+#include <nitro/log/detail/intern_table.hpp>
+
+#include <nitro/lang/string_ref.hpp>
+
+#include <cstdint>
+
+namespace nitro
+{
+namespace log
+{
+    using tag_id = std::uint32_t;
+
+    /// returned for tags, which are not interned
+    constexpr tag_id invalid_tag_id = static_cast<tag_id>(-1);
+
+    namespace detail
+    {
+        struct tag_domain;
+
+        /**
+         * \brief Interns tags to dense integer ids, at most 1024 of them
+         */
+        using tag_table = intern_table<tag_domain, 1024>;
+    } // namespace detail
+
+    /**
+     * \brief interns tag and returns its id
+     */
+    inline tag_id intern_tag(lang::string_ref tag)
+    {
+        return detail::tag_table::instance().intern(tag);
+    }
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_DETAIL_TAG_TABLE_HPP
@@ -29,6 +29,9 @@
 #ifndef INCLUDE_NITRO_LOG_FILTER_AND_FILTER_HPP
 #define INCLUDE_NITRO_LOG_FILTER_AND_FILTER_HPP
 
+#include <nitro/log/detail/post_filter.hpp>
+#include <nitro/log/detail/pre_filter.hpp>
+
 #include <type_traits>
 
 namespace nitro
@@ -47,10 +50,29 @@ namespace log
             static_assert(std::is_same<typename F1::record_type, typename F2::record_type>::value,
                           "record_type must match for both filters");
 
+            bool pre_filter(severity_level severity, lang::string_ref tag) const
+            {
+                return detail::pre_filter(static_cast<const F1&>(*this), severity, tag) &&
+                       detail::pre_filter(static_cast<const F2&>(*this), severity, tag);
+            }
+
+            bool pre_filter(severity_level severity, lang::string_ref tag,
+                            const call_site& site) const
+            {
+                return detail::pre_filter(static_cast<const F1&>(*this), severity, tag, site) &&
+                       detail::pre_filter(static_cast<const F2&>(*this), severity, tag, site);
+            }
+
             bool filter(record_type& r) const
             {
                 return F1::filter(r) && F2::filter(r);
             }
+
+            bool post_filter(record_type& r, lang::string_ref& preceding) const
+            {
+                return detail::post_filter(static_cast<const F1&>(*this), r, preceding) &&
+                       detail::post_filter(static_cast<const F2&>(*this), r, preceding);
+            }
         };
     } // namespace filter
 } // namespace log
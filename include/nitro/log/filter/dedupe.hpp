@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_FILTER_DEDUPE_HPP
+#define INCLUDE_NITRO_LOG_FILTER_DEDUPE_HPP
+
+#include <nitro/log/clock/coarse.hpp>
+#include <nitro/log/detail/thread_counter.hpp>
+#include <nitro/log/severity.hpp>
+
+#include <nitro/lang/string_ref.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace nitro
+{
+namespace log
+{
+    namespace filter
+    {
+        /**
+         * \brief Collapses identical consecutive messages of a thread
+         *
+         * A record with the same severity and message as the previous record of the same thread
+         * is not written. Once a different record follows, a record with the message
+         * "last message repeated N times" is written before it. While the repetitions go on, such
+         * a record is also written every report interval, 10 seconds by default, so a flood does
+         * not go unnoticed. Repetitions at the end of a thread are not reported.
+         *
+         * The message is only known, once it is written, so the arguments of repeated log
+         * statements are still evaluated and the check is done in post_filter. The state is kept
+         * per thread, so the filter does not synchronize threads at all.
+         *
+         * \tparam Record the record type
+         * \tparam N distinguishes dedupe filters with separate configurations for the same Record
+         */
+        template <typename Record, unsigned N = 0>
+        class dedupe
+        {
+        public:
+            typedef Record record_type;
+
+            /// how often ongoing repetitions are reported, zero to report them only at their end
+            static void set_report_interval(std::chrono::milliseconds interval)
+            {
+                report_interval_ns().store(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(interval).count(),
+                    std::memory_order_relaxed);
+            }
+
+            /// the number of records suppressed so far
+            static std::uint64_t suppressed()
+            {
+                return detail::thread_counter<dedupe>::value();
+            }
+
+            bool filter(Record&) const
+            {
+                return true;
+            }
+
+            bool post_filter(Record& r, lang::string_ref& preceding) const
+            {
+                auto& s = state();
+                const auto message = r.message();
+                const auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     clock::coarse_steady_clock::now().time_since_epoch())
+                                     .count();
+
+                if (s.valid && r.severity() == s.severity && message == lang::string_ref(s.last))
+                {
+                    ++s.repeated;
+                    detail::thread_counter<dedupe>::add();
+
+                    auto interval = report_interval_ns().load(std::memory_order_relaxed);
+                    if (interval > 0 && now - s.reported >= interval)
+                    {
+                        preceding = report(s, now);
+                    }
+                    return false;
+                }
+
+                if (s.repeated > 0)
+                {
+                    preceding = report(s, now);
+                }
+
+                s.valid = true;
+                s.severity = r.severity();
+                s.last.assign(message.get(), message.size());
+                s.reported = now;
+                return true;
+            }
+
+        private:
+            struct thread_state
+            {
+                bool valid = false;
+                severity_level severity = severity_level::trace;
+                std::string last;
+                std::uint64_t repeated = 0;
+                std::int64_t reported = 0;
+                std::string report;
+            };
+
+            static thread_state& state()
+            {
+                static thread_local thread_state state_;
+                return state_;
+            }
+
+            static std::atomic<std::int64_t>& report_interval_ns()
+            {
+                static std::atomic<std::int64_t> interval{ 10000000000 };
+                return interval;
+            }
+
+            static lang::string_ref report(thread_state& s, std::int64_t now)
+            {
+                s.report.assign("last message repeated ");
+                s.report.append(std::to_string(s.repeated));
+                s.report.append(s.repeated == 1 ? " time" : " times");
+
+                s.repeated = 0;
+                s.reported = now;
+                return s.report;
+            }
+        };
+    } // namespace filter
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_FILTER_DEDUPE_HPP
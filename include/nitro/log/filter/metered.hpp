@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_FILTER_METERED_HPP
+#define INCLUDE_NITRO_LOG_FILTER_METERED_HPP
+
+#include <nitro/log/attribute/severity.hpp>
+#include <nitro/log/detail/has_attribute.hpp>
+#include <nitro/log/detail/post_filter.hpp>
+#include <nitro/log/detail/pre_filter.hpp>
+#include <nitro/log/detail/record_tag_id.hpp>
+#include <nitro/log/detail/sharded_counters.hpp>
+#include <nitro/log/detail/tag_table.hpp>
+#include <nitro/log/metrics.hpp>
+#include <nitro/log/severity.hpp>
+
+#include <nitro/lang/string_ref.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace nitro
+{
+namespace log
+{
+    namespace filter
+    {
+        struct metered_config
+        {
+            /// the name of the counts in write_metrics()
+            std::string name = "records";
+        };
+
+        /**
+         * \brief Filter adapter, which counts the records written and rejected by Filter
+         *
+         * Records are counted by severity, and the written ones also by tag. A record is
+         * rejected by any of pre_filter(), filter() and post_filter() of Filter, and written
+         * otherwise. Records, which post_filter() writes before another one, e.g. the summaries
+         * of dedupe, have neither the severity nor the tag of that record, so they are counted
+         * on their own, see preceding().
+         *
+         * The counters are incremented by every thread on its own, see
+         * detail::sharded_counters, so they are only summed when read. The configuration is
+         * read when the logger is constructed. Use the nested template as filter, e.g.
+         * metered<severity_filter>::type.
+         *
+         * \tparam Filter the filter deciding which records are written, Record needs a severity
+         */
+        template <template <typename> class Filter>
+        struct metered
+        {
+            static metered_config& config()
+            {
+                static metered_config config_;
+                return config_;
+            }
+
+            template <typename Record>
+            class type : Filter<Record>
+            {
+                static_assert(detail::has_attribute<severity_attribute, Record>::value,
+                              "Record requires a severity attribute to be metered");
+
+                static constexpr std::size_t severities = 6;
+                static constexpr std::size_t rejected_offset = severities;
+                static constexpr std::size_t tag_offset = 2 * severities;
+                // the last counter of the tags is for records without tag
+                static constexpr std::size_t untagged = detail::tag_table::max_size;
+                static constexpr std::size_t preceding_index = tag_offset + untagged + 1;
+
+                using counters = detail::sharded_counters<type, preceding_index + 1>;
+
+            public:
+                typedef Record record_type;
+
+                type()
+                {
+                    static bool registered = []() {
+                        detail::metrics_registry::instance().add(config().name, &write);
+                        return true;
+                    }();
+                    (void)registered;
+                }
+
+                bool pre_filter(severity_level severity, lang::string_ref tag) const
+                {
+                    if (detail::pre_filter(static_cast<const Filter<Record>&>(*this), severity,
+                                           tag))
+                    {
+                        return true;
+                    }
+
+                    counters::add(rejected_offset + index(severity));
+                    return false;
+                }
+
+                bool pre_filter(severity_level severity, lang::string_ref tag,
+                                const call_site& site) const
+                {
+                    if (detail::pre_filter(static_cast<const Filter<Record>&>(*this), severity,
+                                           tag, site))
+                    {
+                        return true;
+                    }
+
+                    counters::add(rejected_offset + index(severity));
+                    return false;
+                }
+
+                bool filter(Record& r) const
+                {
+                    if (Filter<Record>::filter(r))
+                    {
+                        return true;
+                    }
+
+                    counters::add(rejected_offset + index(r.severity()));
+                    return false;
+                }
+
+                bool post_filter(Record& r, lang::string_ref& preceding) const
+                {
+                    bool passed =
+                        detail::post_filter(static_cast<const Filter<Record>&>(*this), r,
+                                            preceding);
+
+                    auto& shard = counters::local();
+                    auto severity = index(r.severity());
+                    if (preceding)
+                    {
+                        shard.add(preceding_index);
+                    }
+
+                    if (passed)
+                    {
+                        count_written(shard, severity, r);
+                    }
+                    else
+                    {
+                        shard.add(rejected_offset + severity);
+                    }
+                    return passed;
+                }
+
+                /// the number of records written with the given severity
+                static std::uint64_t written(severity_level severity)
+                {
+                    return counters::values()[index(severity)];
+                }
+
+                /// the number of records rejected with the given severity
+                static std::uint64_t rejected(severity_level severity)
+                {
+                    return counters::values()[rejected_offset + index(severity)];
+                }
+
+                /// the number of records written by post_filter() of Filter before other records
+                static std::uint64_t preceding()
+                {
+                    return counters::values()[preceding_index];
+                }
+
+                /// the number of records written for every tag, in the order of their tag ids
+                static std::vector<std::pair<std::string, std::uint64_t>> written_by_tag()
+                {
+                    return by_tag(counters::values());
+                }
+
+            private:
+                static std::size_t index(severity_level severity)
+                {
+                    return static_cast<std::size_t>(severity);
+                }
+
+                static void count_written(typename counters::shard& shard, std::size_t severity,
+                                          Record& r)
+                {
+                    auto id = detail::record_tag_id(r);
+                    shard.add(severity);
+                    shard.add(tag_offset + (id == invalid_tag_id ? untagged : id));
+                }
+
+                template <typename Values>
+                static std::vector<std::pair<std::string, std::uint64_t>>
+                by_tag(const Values& values)
+                {
+                    std::vector<std::pair<std::string, std::uint64_t>> result;
+                    for (std::size_t id = 0; id < untagged; ++id)
+                    {
+                        if (values[tag_offset + id] != 0)
+                        {
+                            result.emplace_back(
+                                detail::tag_table::instance().str(static_cast<tag_id>(id)),
+                                values[tag_offset + id]);
+                        }
+                    }
+                    return result;
+                }
+
+                // e.g. "written info 10 error 1 rejected debug 20 preceding 2 tags net 8 io 3"
+                static void write(std::ostream& s)
+                {
+                    static const char* const names[severities] = { "trace", "debug", "info",
+                                                                   "warn",  "error", "fatal" };
+
+                    auto values = counters::values();
+
+                    s << "written";
+                    for (std::size_t i = 0; i < severities; ++i)
+                    {
+                        s << ' ' << names[i] << ' ' << values[i];
+                    }
+
+                    s << " rejected";
+                    for (std::size_t i = 0; i < severities; ++i)
+                    {
+                        s << ' ' << names[i] << ' ' << values[rejected_offset + i];
+                    }
+
+                    if (values[preceding_index] != 0)
+                    {
+                        s << " preceding " << values[preceding_index];
+                    }
+
+                    auto tags = by_tag(values);
+                    if (!tags.empty())
+                    {
+                        s << " tags";
+                        for (const auto& tag : tags)
+                        {
+                            s << ' ' << tag.first << ' ' << tag.second;
+                        }
+                    }
+                }
+            };
+        };
+    } // namespace filter
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_FILTER_METERED_HPP
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_FILTER_RATE_LIMIT_HPP
+#define INCLUDE_NITRO_LOG_FILTER_RATE_LIMIT_HPP
+
+#include <nitro/log/clock/coarse.hpp>
+#include <nitro/log/detail/record_key.hpp>
+#include <nitro/log/detail/thread_counter.hpp>
+
+#include <nitro/except/raise.hpp>
+#include <nitro/lang/string_ref.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace nitro
+{
+namespace log
+{
+    namespace filter
+    {
+        /**
+         * \brief Lets at most a configured number of records per second of each statement or
+         *        tag pass
+         *
+         * If the records have a call_site_attribute, every log statement with a call site has a
+         * token bucket of its own, so a flooding statement does not silence the other statements
+         * with the same tag. Otherwise, every tag has a token bucket, records without a tag share
+         * one. The buckets are implemented with the generic cell rate algorithm on a single
+         * atomic per bucket, so a rejected record only reads it. During a flood of records, the
+         * threads therefore do not contend for it. The time is read from
+         * clock::coarse_steady_clock, so a limit is only as precise as its resolution.
+         *
+         * By default, 100 records per second pass after a burst of 100 records.
+         *
+         * As filter(Record&) takes the token, put it last into an and_filter, so only records
+         * passing all other filters count. Rejected log statements are not formatted and
+         * their lazy arguments are not called.
+         *
+         * \tparam Record the record type
+         * \tparam N distinguishes rate limits with separate configurations for the same Record
+         */
+        template <typename Record, unsigned N = 0>
+        class rate_limit
+        {
+        public:
+            typedef Record record_type;
+
+            /**
+             * \brief lets records_per_second records of each statement or tag pass, after a burst
+             *        of burst records
+             */
+            static void set_limit(double records_per_second, std::size_t burst)
+            {
+                if (!(records_per_second > 0) || burst == 0)
+                {
+                    raise("A rate limit needs a positive rate and a burst of at least one record");
+                }
+
+                auto interval = std::max(1e9 / records_per_second, 1.0);
+                auto tolerance = std::min(interval * static_cast<double>(burst - 1), 1e18);
+
+                auto& s = state();
+                s.interval_ns.store(static_cast<std::int64_t>(interval), std::memory_order_relaxed);
+                s.tolerance_ns.store(static_cast<std::int64_t>(tolerance),
+                                     std::memory_order_relaxed);
+            }
+
+            /// the number of records rejected so far
+            static std::uint64_t suppressed()
+            {
+                return detail::thread_counter<rate_limit>::value();
+            }
+
+            bool filter(Record& r) const
+            {
+                if (take(nitro::log::detail::record_key(r)))
+                {
+                    return true;
+                }
+
+                detail::thread_counter<rate_limit>::add();
+                return false;
+            }
+
+        private:
+            struct bucket
+            {
+                // the theoretical arrival time of the next record
+                std::atomic<std::int64_t> next{ std::numeric_limits<std::int64_t>::min() };
+                char padding[64 - sizeof(std::atomic<std::int64_t>)];
+            };
+
+            struct shared_state
+            {
+                std::atomic<std::int64_t> interval_ns{ 10000000 };
+                std::atomic<std::int64_t> tolerance_ns{ 990000000 };
+                bucket buckets[nitro::log::detail::record_keys];
+            };
+
+            static shared_state& state()
+            {
+                // never destroyed, so records can still be filtered while statics are destroyed
+                static shared_state* state_ = new shared_state();
+                return *state_;
+            }
+
+            static bool take(std::size_t index)
+            {
+                auto& s = state();
+                auto& next = s.buckets[index].next;
+
+                const auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     clock::coarse_steady_clock::now().time_since_epoch())
+                                     .count();
+                const auto interval = s.interval_ns.load(std::memory_order_relaxed);
+                const auto tolerance = s.tolerance_ns.load(std::memory_order_relaxed);
+
+                auto expected = next.load(std::memory_order_relaxed);
+                while (true)
+                {
+                    if (expected > now && expected - now > tolerance)
+                    {
+                        return false;
+                    }
+
+                    if (next.compare_exchange_weak(expected, std::max(expected, now) + interval,
+                                                   std::memory_order_relaxed))
+                    {
+                        return true;
+                    }
+                }
+            }
+        };
+    } // namespace filter
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_FILTER_RATE_LIMIT_HPP
@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_FILTER_SAMPLING_FILTER_HPP
+#define INCLUDE_NITRO_LOG_FILTER_SAMPLING_FILTER_HPP
+
+#include <nitro/log/detail/record_key.hpp>
+#include <nitro/log/detail/thread_counter.hpp>
+#include <nitro/log/severity.hpp>
+
+#include <nitro/except/raise.hpp>
+#include <nitro/lang/string_ref.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <thread>
+
+namespace nitro
+{
+namespace log
+{
+    namespace filter
+    {
+        /**
+         * \brief Keeps only a sample of the records up to a maximum severity
+         *
+         * Records with a severity up to max_severity(), debug by default, are sampled, all other
+         * records pass. The sample is either every N-th record of each statement or tag, see
+         * keep_one_in(), or a random fraction of the records, see keep_fraction(). By default,
+         * all records are kept. Records are counted per statement, if their statement has a call
+         * site, e.g. with NITRO_LOG, and per tag otherwise.
+         *
+         * Both are decided in pre_filter(), before the record is constructed, with counters and a
+         * xorshift generator of the calling thread. So every thread keeps every N-th record of
+         * each statement or tag on its own and the filter does not synchronize threads. Statements
+         * of call sites enabled in the call_site_registry skip the filter and are not sampled.
+         *
+         * \tparam Record the record type
+         * \tparam N distinguishes sampling filters with separate configurations for the same
+         *           Record
+         */
+        template <typename Record, unsigned N = 0>
+        class sampling_filter
+        {
+        public:
+            typedef Record record_type;
+
+            /// keeps every n-th record of each statement or tag per thread, from the first
+            static void keep_one_in(std::uint32_t n)
+            {
+                if (n == 0)
+                {
+                    raise("A sampling filter has to keep at least one in one record");
+                }
+
+                state().one_in.store(n, std::memory_order_relaxed);
+            }
+
+            /// keeps each record with the given probability
+            static void keep_fraction(double fraction)
+            {
+                if (!(fraction >= 0.0 && fraction <= 1.0))
+                {
+                    raise("A sampling filter has to keep a fraction between 0 and 1");
+                }
+
+                // compared to 64 random bits, 1.0 cannot be represented and keeps everything
+                std::uint64_t threshold = keep_all;
+                if (fraction < 1.0)
+                {
+                    threshold = static_cast<std::uint64_t>(fraction * 18446744073709551616.0);
+                }
+
+                state().threshold.store(threshold, std::memory_order_relaxed);
+                state().one_in.store(0, std::memory_order_relaxed);
+            }
+
+            /// samples records up to this severity, records with a higher severity always pass
+            static void set_max_severity(severity_level sev)
+            {
+                state().max_severity.store(sev, std::memory_order_relaxed);
+            }
+
+            static severity_level max_severity()
+            {
+                return state().max_severity.load(std::memory_order_relaxed);
+            }
+
+            /// the number of sampled records kept so far
+            static std::uint64_t kept()
+            {
+                return detail::thread_counter<kept_domain>::value();
+            }
+
+            /// the number of sampled records dropped so far
+            static std::uint64_t dropped()
+            {
+                return detail::thread_counter<dropped_domain>::value();
+            }
+
+            bool pre_filter(severity_level severity, lang::string_ref tag) const
+            {
+                return sample(severity, [tag]() { return nitro::log::detail::statement_key(tag); });
+            }
+
+            bool pre_filter(severity_level severity, lang::string_ref tag,
+                            const call_site& site) const
+            {
+                return sample(severity, [tag, &site]() {
+                    return nitro::log::detail::statement_key(tag, site);
+                });
+            }
+
+            bool filter(Record&) const
+            {
+                return true;
+            }
+
+        private:
+            struct kept_domain;
+            struct dropped_domain;
+
+            static constexpr std::uint64_t keep_all = static_cast<std::uint64_t>(-1);
+
+            struct shared_state
+            {
+                std::atomic<severity_level> max_severity{ severity_level::debug };
+                // zero if a fraction is kept
+                std::atomic<std::uint32_t> one_in{ 1 };
+                std::atomic<std::uint64_t> threshold{ keep_all };
+            };
+
+            static shared_state& state()
+            {
+                static shared_state state_;
+                return state_;
+            }
+
+            // key returns the key of the statement, it is only called for every n-th sampling
+            template <typename Key>
+            static bool sample(severity_level severity, Key key)
+            {
+                auto& s = state();
+                if (severity > s.max_severity.load(std::memory_order_relaxed))
+                {
+                    return true;
+                }
+
+                bool keep;
+                auto one_in = s.one_in.load(std::memory_order_relaxed);
+                if (one_in != 0)
+                {
+                    auto& counter = thread_counters()[key()];
+
+                    keep = counter == 0;
+                    counter = counter + 1 >= one_in ? 0 : counter + 1;
+                }
+                else
+                {
+                    auto threshold = s.threshold.load(std::memory_order_relaxed);
+                    keep = threshold == keep_all || next_random() < threshold;
+                }
+
+                if (keep)
+                {
+                    detail::thread_counter<kept_domain>::add();
+                }
+                else
+                {
+                    detail::thread_counter<dropped_domain>::add();
+                }
+                return keep;
+            }
+
+            static std::uint32_t* thread_counters()
+            {
+                static thread_local std::uint32_t counters[nitro::log::detail::record_keys] = {};
+                return counters;
+            }
+
+            static std::uint64_t next_random()
+            {
+                static thread_local std::uint64_t x = seed();
+
+                // xorshift64*
+                x ^= x >> 12;
+                x ^= x << 25;
+                x ^= x >> 27;
+                return x * 0x2545F4914F6CDD1Dull;
+            }
+
+            static std::uint64_t seed()
+            {
+                // splitmix64 of the time and the thread, never zero for xorshift
+                std::uint64_t z =
+                    static_cast<std::uint64_t>(
+                        std::chrono::high_resolution_clock::now().time_since_epoch().count()) ^
+                    static_cast<std::uint64_t>(std::hash<std::thread::id>()(
+                        std::this_thread::get_id()));
+                z += 0x9E3779B97F4A7C15ull;
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+                z ^= z >> 31;
+                return z != 0 ? z : 1;
+            }
+        };
+    } // namespace filter
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_FILTER_SAMPLING_FILTER_HPP
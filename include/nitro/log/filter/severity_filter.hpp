@@ -31,6 +31,8 @@
 
 #include <nitro/log/severity.hpp>
 
+#include <nitro/lang/string_ref.hpp>
+
 namespace nitro
 {
 namespace log
@@ -54,6 +56,11 @@ namespace log
                 return sev;
             }
 
+            bool pre_filter(severity_level severity, lang::string_ref) const
+            {
+                return severity >= min_severity();
+            }
+
             bool filter(Record& r) const
             {
                 return r.severity() >= min_severity();
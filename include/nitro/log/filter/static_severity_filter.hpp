@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_FILTER_STATIC_SEVERITY_FILTER_HPP
+#define INCLUDE_NITRO_LOG_FILTER_STATIC_SEVERITY_FILTER_HPP
+
+#include <nitro/log/severity.hpp>
+
+#include <nitro/lang/string_ref.hpp>
+
+namespace nitro
+{
+namespace log
+{
+    namespace filter
+    {
+        /**
+         * \brief Lets records with at least the given severity pass
+         *
+         * Unlike severity_filter, the severity is fixed at compile-time. Use the nested template
+         * as filter, e.g. static_severity<severity_level::error>::type.
+         */
+        template <severity_level Severity>
+        struct static_severity
+        {
+            template <typename Record>
+            class type
+            {
+            public:
+                typedef Record record_type;
+
+                constexpr bool pre_filter(severity_level severity, lang::string_ref) const
+                {
+                    return severity >= Severity;
+                }
+
+                bool filter(Record& r) const
+                {
+                    return r.severity() >= Severity;
+                }
+            };
+        };
+    } // namespace filter
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_FILTER_STATIC_SEVERITY_FILTER_HPP
@@ -0,0 +1,308 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_FILTER_TAG_SEVERITY_FILTER_HPP
+#define INCLUDE_NITRO_LOG_FILTER_TAG_SEVERITY_FILTER_HPP
+
+#include <nitro/log/attribute/interned_tag.hpp>
+#include <nitro/log/attribute/tag.hpp>
+#include <nitro/log/detail/call_site_tag.hpp>
+#include <nitro/log/detail/has_attribute.hpp>
+#include <nitro/log/detail/tag_table.hpp>
+#include <nitro/log/severity.hpp>
+
+#include <nitro/except/raise.hpp>
+#include <nitro/lang/string_ref.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdlib>
+#include <string>
+#include <type_traits>
+
+namespace nitro
+{
+namespace log
+{
+    namespace filter
+    {
+        /**
+         * \brief Filters records by a minimum severity, which can be set per tag
+         *
+         * Records without a tag, or with a tag without its own minimum severity, are checked
+         * against the default minimum severity. The severities can be changed at any time from
+         * any thread. The check already happens before the record of a log statement is
+         * constructed. For statements of NITRO_LOG_TAG, the id of the tag is cached in the call
+         * site, so the check is a comparison with the cached tag and an array load. Other
+         * statements look their tag up in the lock-free tag table first. Records with an
+         * interned_tag_attribute are checked with an array load. Only set_severity() interns
+         * tags, so the tags of the checked statements do not fill the tag table.
+         *
+         * The severities can be configured with a string like "info,net=debug,db=warn", e.g.
+         * from the environment variable NITRO_LOG with configure_from_env().
+         */
+        template <typename Record, unsigned N = 0>
+        class tag_severity_filter
+        {
+        public:
+            typedef Record record_type;
+
+            /// sets the default minimum severity
+            static void set_severity(severity_level new_sev)
+            {
+                state().default_severity.store(new_sev, std::memory_order_relaxed);
+            }
+
+            /// sets the minimum severity for records with the given tag
+            static void set_severity(lang::string_ref tag, severity_level new_sev)
+            {
+                auto id = intern_tag(tag);
+                if (id == invalid_tag_id)
+                {
+                    raise("Cannot set the severity of an empty tag or too many tags");
+                }
+
+                state().severities[id].store(static_cast<int>(new_sev), std::memory_order_relaxed);
+                state().has_tag_severities.store(true, std::memory_order_release);
+            }
+
+            /// lets records with the given tag use the default minimum severity again
+            static void reset_severity(lang::string_ref tag)
+            {
+                auto id = detail::tag_table::instance().find(tag);
+                if (id != invalid_tag_id)
+                {
+                    state().severities[id].store(unset, std::memory_order_relaxed);
+                }
+            }
+
+            /// the default minimum severity
+            static severity_level min_severity()
+            {
+                return state().default_severity.load(std::memory_order_relaxed);
+            }
+
+            /// the minimum severity for records with the given tag
+            static severity_level min_severity(lang::string_ref tag)
+            {
+                if (state().has_tag_severities.load(std::memory_order_acquire))
+                {
+                    return min_severity(detail::tag_table::instance().find(tag));
+                }
+
+                return min_severity();
+            }
+
+            /// the minimum severity for records with the interned tag
+            static severity_level min_severity(tag_id id)
+            {
+                auto& s = state();
+
+                if (id != invalid_tag_id && s.has_tag_severities.load(std::memory_order_acquire))
+                {
+                    auto sev = s.severities[id].load(std::memory_order_relaxed);
+                    if (sev != unset)
+                    {
+                        return static_cast<severity_level>(sev);
+                    }
+                }
+
+                return s.default_severity.load(std::memory_order_relaxed);
+            }
+
+            /**
+             * \brief sets the severities from a comma separated list of "tag=severity" entries
+             *
+             * An entry without a tag sets the default minimum severity. Throws on malformed
+             * entries or unknown severities, without applying any of the entries then.
+             */
+            static void configure(const std::string& config)
+            {
+                parse(config, false);
+                parse(config, true);
+            }
+
+            /**
+             * \brief sets the severities from the given environment variable, if it is set
+             */
+            static void configure_from_env(const char* name = "NITRO_LOG")
+            {
+                if (const char* config = std::getenv(name))
+                {
+                    configure(config);
+                }
+            }
+
+            bool pre_filter(severity_level sev, lang::string_ref tag) const
+            {
+                return sev >= min_severity(tag);
+            }
+
+            bool pre_filter(severity_level sev, lang::string_ref tag, const call_site& site) const
+            {
+                if (state().has_tag_severities.load(std::memory_order_acquire))
+                {
+                    return sev >=
+                           min_severity(nitro::log::detail::call_site_find_tag_id(site, tag));
+                }
+
+                return sev >= min_severity();
+            }
+
+            bool filter(Record& r) const
+            {
+                return r.severity() >= min_severity_of(r, has_interned_tag(), has_tag());
+            }
+
+        private:
+            static constexpr int unset = -1;
+
+            struct shared_state
+            {
+                shared_state()
+                {
+                    for (auto& sev : severities)
+                    {
+                        sev.store(unset, std::memory_order_relaxed);
+                    }
+                }
+
+                std::atomic<severity_level> default_severity{ severity_level::trace };
+                std::atomic<bool> has_tag_severities{ false };
+                std::atomic<int> severities[detail::tag_table::max_size];
+            };
+
+            static shared_state& state()
+            {
+                static shared_state state_;
+                return state_;
+            }
+
+            using has_tag = std::integral_constant<
+                bool, nitro::log::detail::has_attribute<tag_attribute, Record>::value>;
+
+            using has_interned_tag = std::integral_constant<
+                bool, nitro::log::detail::has_attribute<interned_tag_attribute, Record>::value>;
+
+            static severity_level min_severity_of(Record& r, std::true_type, std::false_type)
+            {
+                return min_severity(r.interned_tag());
+            }
+
+            static severity_level min_severity_of(Record& r, std::false_type, std::true_type)
+            {
+                return min_severity(lang::string_ref(r.tag()));
+            }
+
+            static severity_level min_severity_of(Record&, std::false_type, std::false_type)
+            {
+                return min_severity();
+            }
+
+            static std::string trim(const std::string& str)
+            {
+                auto begin = str.find_first_not_of(" \t");
+                if (begin == std::string::npos)
+                {
+                    return {};
+                }
+                auto end = str.find_last_not_of(" \t");
+                return str.substr(begin, end - begin + 1);
+            }
+
+            static severity_level parse_severity(const std::string& text)
+            {
+                std::string upper = text;
+                std::transform(upper.begin(), upper.end(), upper.begin(),
+                               [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+
+                for (auto sev : { severity_level::trace, severity_level::debug,
+                                  severity_level::info, severity_level::warn,
+                                  severity_level::error, severity_level::fatal })
+                {
+                    if (trim(severity_name(sev)) == upper)
+                    {
+                        return sev;
+                    }
+                }
+
+                raise("Unknown severity in log configuration: " + text);
+            }
+
+            static void parse(const std::string& config, bool apply)
+            {
+                std::string::size_type begin = 0;
+
+                while (begin <= config.size())
+                {
+                    auto end = config.find(',', begin);
+                    if (end == std::string::npos)
+                    {
+                        end = config.size();
+                    }
+
+                    auto entry = trim(config.substr(begin, end - begin));
+                    begin = end + 1;
+
+                    if (entry.empty())
+                    {
+                        continue;
+                    }
+
+                    auto equals = entry.find('=');
+                    if (equals == std::string::npos)
+                    {
+                        auto sev = parse_severity(entry);
+                        if (apply)
+                        {
+                            set_severity(sev);
+                        }
+                        continue;
+                    }
+
+                    auto tag = trim(entry.substr(0, equals));
+                    auto sev = parse_severity(trim(entry.substr(equals + 1)));
+
+                    if (tag.empty())
+                    {
+                        raise("Missing tag in log configuration: " + entry);
+                    }
+
+                    if (apply)
+                    {
+                        set_severity(lang::string_ref(tag), sev);
+                    }
+                }
+            }
+        };
+    } // namespace filter
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_FILTER_TAG_SEVERITY_FILTER_HPP
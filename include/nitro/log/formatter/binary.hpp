@@ -0,0 +1,546 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_FORMATTER_BINARY_HPP
+#define INCLUDE_NITRO_LOG_FORMATTER_BINARY_HPP
+
+#include <nitro/format/detail/iso8601.hpp>
+#include <nitro/log/attribute/interned_tag.hpp>
+#include <nitro/log/attribute/severity.hpp>
+#include <nitro/log/attribute/tag.hpp>
+#include <nitro/log/detail/binary_format.hpp>
+#include <nitro/log/detail/has_attribute.hpp>
+#include <nitro/log/detail/stream_buffer.hpp>
+#include <nitro/log/detail/tag_table.hpp>
+
+#include <nitro/lang/string_ref.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+namespace nitro
+{
+namespace log
+{
+    class pid_attribute;
+    class pthread_id_attribute;
+
+    namespace detail
+    {
+        enum class binary_kind
+        {
+            literal,
+            c_string,
+            string,
+            character,
+            signed_integer,
+            unsigned_integer,
+            floating,
+            other
+        };
+
+        template <typename T>
+        struct binary_kind_of
+        : std::integral_constant<
+              binary_kind,
+              std::is_floating_point<T>::value
+                  ? binary_kind::floating
+                  : !std::is_integral<T>::value
+                        ? binary_kind::other
+                        : std::is_same<T, char>::value || std::is_same<T, signed char>::value ||
+                                  std::is_same<T, unsigned char>::value
+                              ? binary_kind::character
+                              : std::is_signed<T>::value ? binary_kind::signed_integer
+                                                         : binary_kind::unsigned_integer>
+        {
+        };
+
+        template <std::size_t N>
+        struct binary_kind_of<char[N]> : std::integral_constant<binary_kind, binary_kind::literal>
+        {
+        };
+
+        template <>
+        struct binary_kind_of<const char*>
+        : std::integral_constant<binary_kind, binary_kind::c_string>
+        {
+        };
+
+        template <>
+        struct binary_kind_of<char*> : std::integral_constant<binary_kind, binary_kind::c_string>
+        {
+        };
+
+        template <>
+        struct binary_kind_of<std::string>
+        : std::integral_constant<binary_kind, binary_kind::string>
+        {
+        };
+
+        template <>
+        struct binary_kind_of<lang::string_ref>
+        : std::integral_constant<binary_kind, binary_kind::string>
+        {
+        };
+
+        /**
+         * \brief Writes streamed arguments in the encoding of detail/binary_format.hpp
+         *
+         * Character arrays are taken for string literals and only their id in the literal_table
+         * is written. Numbers, strings and characters are written as they are. Everything else,
+         * and numbers, which are streamed after manipulators like std::hex, are converted to
+         * text with operator<< right away.
+         */
+        class binary_argument_encoder
+        {
+        public:
+            template <typename T>
+            static void encode(std::ostream& s, const T& value)
+            {
+                using kind = binary_kind_of<T>;
+
+                bool is_number = kind::value == binary_kind::signed_integer ||
+                                 kind::value == binary_kind::unsigned_integer ||
+                                 kind::value == binary_kind::floating;
+
+                if (s.width() != 0 || (is_number && !has_default_format(s)))
+                {
+                    encode_as_text(s, value);
+                }
+                else
+                {
+                    encode(s, value, kind());
+                }
+            }
+
+        private:
+            template <binary_kind Kind>
+            using kind_tag = std::integral_constant<binary_kind, Kind>;
+
+            static bool has_default_format(std::ostream& s)
+            {
+                return s.flags() == (std::ios_base::skipws | std::ios_base::dec) &&
+                       s.precision() == 6;
+            }
+
+            template <std::size_t N>
+            static void encode(std::ostream& s, const char (&value)[N],
+                               kind_tag<binary_kind::literal>)
+            {
+                // String literals keep their address, so their id is cached by it. The contents
+                // are compared anyway, as other arrays at the same address may differ.
+                auto& cached = literal_cache()[(reinterpret_cast<std::uintptr_t>(value) >> 3) %
+                                               literal_cache_size];
+                if (cached.address == value && cached.size < N && value[cached.size] == '\0' &&
+                    std::memcmp(cached.name, value, cached.size) == 0)
+                {
+                    encode_literal(s, cached.id);
+                    return;
+                }
+
+                // like operator<<, stop at the terminator
+                const auto size =
+                    static_cast<std::size_t>(std::find(value, value + N, '\0') - value);
+                if (size == 0)
+                {
+                    return;
+                }
+
+                auto& table = literal_table::instance();
+                auto id = table.intern(lang::string_ref(value, size));
+                if (id == literal_table::invalid_id)
+                {
+                    // the dictionary is full
+                    encode_string(s, value, size);
+                    return;
+                }
+
+                cached.address = value;
+                cached.name = table.name(id).get();
+                cached.size = size;
+                cached.id = id;
+
+                encode_literal(s, id);
+            }
+
+            template <typename T>
+            static void encode(std::ostream& s, const T& value, kind_tag<binary_kind::c_string>)
+            {
+                if (value != nullptr)
+                {
+                    encode_string(s, value, std::strlen(value));
+                }
+            }
+
+            template <typename T>
+            static void encode(std::ostream& s, const T& value, kind_tag<binary_kind::string>)
+            {
+                encode_string(s, value.data(), value.size());
+            }
+
+            static void encode(std::ostream& s, const lang::string_ref& value,
+                               kind_tag<binary_kind::string>)
+            {
+                encode_string(s, value.get(), value.size());
+            }
+
+            template <typename T>
+            static void encode(std::ostream& s, const T& value, kind_tag<binary_kind::character>)
+            {
+                const char item[] = { binary_char_argument, static_cast<char>(value) };
+                put(s, item, sizeof(item));
+            }
+
+            template <typename T>
+            static void encode(std::ostream& s, const T& value,
+                               kind_tag<binary_kind::signed_integer>)
+            {
+                encode_varint(s, binary_signed_argument,
+                              zigzag_encode(static_cast<std::int64_t>(value)));
+            }
+
+            template <typename T>
+            static void encode(std::ostream& s, const T& value,
+                               kind_tag<binary_kind::unsigned_integer>)
+            {
+                encode_varint(s, binary_unsigned_argument, static_cast<std::uint64_t>(value));
+            }
+
+            template <typename T>
+            static void encode(std::ostream& s, const T& value, kind_tag<binary_kind::floating>)
+            {
+                const auto wide_value = static_cast<double>(value);
+
+                char item[1 + sizeof(double)] = { binary_floating_argument };
+                std::memcpy(item + 1, &wide_value, sizeof(double));
+                put(s, item, sizeof(item));
+            }
+
+            template <typename T>
+            static void encode(std::ostream& s, const T& value, kind_tag<binary_kind::other>)
+            {
+                encode_as_text(s, value);
+            }
+
+            template <typename T>
+            static void encode_as_text(std::ostream& s, const T& value)
+            {
+                auto lease = stream_lease::acquire();
+                auto& text = lease.stream();
+
+                text.flags(s.flags());
+                text.precision(s.precision());
+                text.fill(s.fill());
+                text.width(s.width());
+
+                text << value;
+
+                auto str = lease.buffer().str();
+                if (str.size() == 0)
+                {
+                    // a manipulator, so apply it to the following arguments
+                    s << value;
+                    return;
+                }
+
+                s.width(0);
+
+                encode_string(s, str.get(), str.size());
+            }
+
+            static void encode_literal(std::ostream& s, literal_table::id_type id)
+            {
+                encode_varint(s, binary_literal_argument, id);
+            }
+
+            static void encode_string(std::ostream& s, const char* str, std::size_t size)
+            {
+                encode_varint(s, binary_string_argument, size);
+                put(s, str, size);
+            }
+
+            static void encode_varint(std::ostream& s, char kind, std::uint64_t value)
+            {
+                char item[1 + max_varint_size] = { kind };
+                put(s, item, static_cast<std::size_t>(put_varint(item + 1, value) - item));
+            }
+
+            // writes to the buffer directly, which skips the sentry of std::ostream
+            static void put(std::ostream& s, const char* data, std::size_t size)
+            {
+                s.rdbuf()->sputn(data, static_cast<std::streamsize>(size));
+            }
+
+            struct literal_cache_entry
+            {
+                const char* address = nullptr;
+                const char* name = nullptr;
+                std::size_t size = 0;
+                literal_table::id_type id = 0;
+            };
+
+            static constexpr std::size_t literal_cache_size = 256;
+
+            static literal_cache_entry* literal_cache()
+            {
+                static thread_local literal_cache_entry cache[literal_cache_size];
+                return cache;
+            }
+        };
+    } // namespace detail
+
+    namespace formatter
+    {
+        /**
+         * \brief Encodes records into a compact binary format instead of text
+         *
+         * The streamed arguments are not converted to text. Numbers are stored as they are and
+         * string literals are stored once in a dictionary and referenced by their id, which
+         * makes enabled log statements considerably cheaper. The timestamp, severity, tag, and if
+         * the record has them, process, thread and pthread id are stored as well.
+         *
+         * Use sink::binary_to_text to convert the records to text on another thread, e.g.
+         * sink::async<sink::binary_to_text<sink::StdOut>>, or write them to a file and convert it
+         * later with formatter::binary_decoder or the nitro-log-decode tool.
+         *
+         * The dictionary is written again whenever sink::rotating_file starts a new segment and
+         * twice per round of sink::mmap_ring, so every segment and the records left in the ring
+         * can be decoded on their own.
+         *
+         * The encoding is described in detail/binary_format.hpp. It uses the byte order of the
+         * host and is not meant to be stable across versions of nitro.
+         */
+        template <typename Record>
+        class binary_formatter
+        {
+        public:
+            using argument_encoder = nitro::log::detail::binary_argument_encoder;
+
+            void format(Record& r, std::ostream& s)
+            {
+                char header[64];
+                header[0] = 0;
+                char* end = header + 1;
+
+                end = write_timestamp(
+                    r.timestamp(), header, end,
+                    nitro::detail::is_system_time_point<std::decay_t<decltype(r.timestamp())>>());
+                end = write_severity(r, header, end, has<severity_attribute>());
+                end = write_tag(r, header, end, has<tag_attribute>());
+                end = write_interned_tag(r, header, end, has<interned_tag_attribute>());
+                end = write_pid(r, header, end, has<pid_attribute>());
+                end = write_thread(r, header, end, has<pthread_id_attribute>());
+
+                // after the tag was interned
+                redefine_on_new_epoch(s);
+                define_new<nitro::log::detail::literal_table>(
+                    s, nitro::log::detail::binary_literal_frame, literals_defined_);
+                define_new<nitro::log::detail::tag_table>(s, nitro::log::detail::binary_tag_frame,
+                                                          tags_defined_);
+
+                const auto message = r.message();
+                const auto header_size = static_cast<std::size_t>(end - header);
+
+                char prefix[1 + nitro::log::detail::max_varint_size] = {
+                    nitro::log::detail::binary_record_frame
+                };
+                auto prefix_end =
+                    nitro::log::detail::put_varint(prefix + 1, header_size + message.size());
+
+                auto buffer = s.rdbuf();
+                buffer->sputn(prefix, prefix_end - prefix);
+                buffer->sputn(header, static_cast<std::streamsize>(header_size));
+                buffer->sputn(message.get(), static_cast<std::streamsize>(message.size()));
+            }
+
+        private:
+            template <typename Attribute>
+            using has = std::integral_constant<
+                bool, nitro::log::detail::has_attribute<Attribute, Record>::value>;
+
+            // writes all definitions again, if a sink dropped the earlier ones
+            void redefine_on_new_epoch(std::ostream& s)
+            {
+                const auto epoch = nitro::log::detail::binary_dictionary_epoch().load(
+                    std::memory_order_relaxed);
+
+                auto seen = epoch_.load(std::memory_order_relaxed);
+                if (seen == epoch || !epoch_.compare_exchange_strong(seen, epoch))
+                {
+                    return;
+                }
+
+                // the definitions after these are written by define_new()
+                define<nitro::log::detail::literal_table>(
+                    s, nitro::log::detail::binary_literal_frame, 0,
+                    literals_defined_.load(std::memory_order_relaxed));
+                define<nitro::log::detail::tag_table>(
+                    s, nitro::log::detail::binary_tag_frame, 0,
+                    tags_defined_.load(std::memory_order_relaxed));
+            }
+
+            // writes the definitions of all strings interned since the last call
+            template <typename Table>
+            static void define_new(std::ostream& s, char frame, std::atomic<std::size_t>& defined)
+            {
+                const auto size = Table::instance().size();
+
+                auto first = defined.load(std::memory_order_relaxed);
+                while (first < size && !defined.compare_exchange_weak(first, size))
+                {
+                }
+
+                define<Table>(s, frame, first, size);
+            }
+
+            template <typename Table>
+            static void define(std::ostream& s, char frame, std::size_t first, std::size_t size)
+            {
+                const auto& table = Table::instance();
+
+                for (auto id = first; id < size; ++id)
+                {
+                    auto name = table.name(static_cast<typename Table::id_type>(id));
+
+                    char prefix[nitro::log::detail::max_varint_size];
+                    auto prefix_size = static_cast<std::size_t>(
+                        nitro::log::detail::put_varint(prefix, id) - prefix);
+
+                    s.put(frame);
+                    nitro::log::detail::write_varint(s, prefix_size + name.size());
+                    s.write(prefix, static_cast<std::streamsize>(prefix_size));
+                    s.write(name.get(), static_cast<std::streamsize>(name.size()));
+                }
+            }
+
+            template <typename TimePoint>
+            static char* write_timestamp(const TimePoint& timestamp, char* header, char* end,
+                                         std::true_type)
+            {
+                auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              timestamp.time_since_epoch())
+                              .count();
+                header[0] |= nitro::log::detail::binary_system_timestamp;
+                return nitro::log::detail::put_varint(
+                    end, nitro::log::detail::zigzag_encode(static_cast<std::int64_t>(ns)));
+            }
+
+            template <typename TimePoint>
+            static char* write_timestamp(const TimePoint& timestamp, char* header, char* end,
+                                         std::false_type)
+            {
+                auto ticks = timestamp.time_since_epoch().count();
+                header[0] |= nitro::log::detail::binary_ticks_timestamp;
+                return nitro::log::detail::put_varint(
+                    end, nitro::log::detail::zigzag_encode(static_cast<std::int64_t>(ticks)));
+            }
+
+            static char* write_severity(Record& r, char* header, char* end, std::true_type)
+            {
+                header[0] |= nitro::log::detail::binary_severity;
+                *end++ = static_cast<char>(r.severity());
+                return end;
+            }
+
+            static char* write_tag(Record& r, char* header, char* end, std::true_type)
+            {
+                return write_tag_id(intern_tag(r.tag()), header, end);
+            }
+
+            static char* write_interned_tag(Record& r, char* header, char* end, std::true_type)
+            {
+                return write_tag_id(r.interned_tag(), header, end);
+            }
+
+            static char* write_tag_id(tag_id id, char* header, char* end)
+            {
+                if (id == invalid_tag_id)
+                {
+                    return end;
+                }
+
+                header[0] |= nitro::log::detail::binary_tag;
+                return nitro::log::detail::put_varint(end, id);
+            }
+
+            static char* write_pid(Record& r, char* header, char* end, std::true_type)
+            {
+                header[0] |= nitro::log::detail::binary_pid;
+                end = nitro::log::detail::put_varint(end,
+                                                     nitro::log::detail::zigzag_encode(r.pid()));
+                return nitro::log::detail::put_varint(end,
+                                                      nitro::log::detail::zigzag_encode(r.tid()));
+            }
+
+            static char* write_thread(Record& r, char* header, char* end, std::true_type)
+            {
+                header[0] |= nitro::log::detail::binary_thread;
+                return nitro::log::detail::put_varint(end, r.pthread_id());
+            }
+
+            static char* write_severity(Record&, char*, char* end, std::false_type)
+            {
+                return end;
+            }
+
+            static char* write_tag(Record&, char*, char* end, std::false_type)
+            {
+                return end;
+            }
+
+            static char* write_interned_tag(Record&, char*, char* end, std::false_type)
+            {
+                return end;
+            }
+
+            static char* write_pid(Record&, char*, char* end, std::false_type)
+            {
+                return end;
+            }
+
+            static char* write_thread(Record&, char*, char* end, std::false_type)
+            {
+                return end;
+            }
+
+            std::atomic<std::size_t> literals_defined_{ 0 };
+            std::atomic<std::size_t> tags_defined_{ 0 };
+            std::atomic<std::uint64_t> epoch_{ 0 };
+        };
+    } // namespace formatter
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_FORMATTER_BINARY_HPP
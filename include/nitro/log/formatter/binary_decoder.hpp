@@ -0,0 +1,412 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_FORMATTER_BINARY_DECODER_HPP
+#define INCLUDE_NITRO_LOG_FORMATTER_BINARY_DECODER_HPP
+
+#include <nitro/format/detail/iso8601.hpp>
+#include <nitro/format/detail/kernels.hpp>
+#include <nitro/log/detail/binary_format.hpp>
+#include <nitro/log/detail/tag_table.hpp>
+#include <nitro/log/severity.hpp>
+
+#include <nitro/lang/string_ref.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+
+namespace nitro
+{
+namespace log
+{
+    namespace formatter
+    {
+        /**
+         * \brief Converts records of formatter::binary_formatter to text
+         *
+         * Records are written like formatter::text_formatter does, with the process and thread
+         * id and the pthread id after the timestamp, if the records have them.
+         *
+         * Literals and tags are looked up in the definitions passed to define(). As records may
+         * precede their definitions, pass all the data to define() before decoding it. In the
+         * process, which wrote the records, the definitions are not needed, see
+         * use_process_tables.
+         */
+        class binary_decoder
+        {
+        public:
+            /**
+             * \param use_process_tables look up literals and tags in the tables of the current
+             *                           process, if they were not defined
+             */
+            explicit binary_decoder(bool use_process_tables = false)
+            : use_process_tables_(use_process_tables)
+            {
+            }
+
+            /**
+             * \brief reads the definitions of literals and tags in data
+             *
+             * \returns the number of bytes read, which is less than size if data ends with an
+             *          incomplete frame
+             */
+            std::size_t define(const char* data, std::size_t size)
+            {
+                return for_each_frame(data, size, [this](char type, const char* begin,
+                                                         const char* end) {
+                    if (type != nitro::log::detail::binary_literal_frame &&
+                        type != nitro::log::detail::binary_tag_frame)
+                    {
+                        return;
+                    }
+
+                    std::uint64_t id;
+                    if (nitro::log::detail::get_varint(begin, end, id))
+                    {
+                        auto& names =
+                            type == nitro::log::detail::binary_literal_frame ? literals_ : tags_;
+                        names[id].assign(begin, end);
+                    }
+                });
+            }
+
+            /**
+             * \brief writes the records in data as text to out
+             *
+             * This does not change the decoder, so it can be called by several threads at once.
+             *
+             * \returns the number of bytes read, which is less than size if data ends with an
+             *          incomplete frame
+             */
+            std::size_t decode(const char* data, std::size_t size, std::ostream& out) const
+            {
+                return for_each_frame(data, size, [this, &out](char type, const char* begin,
+                                                               const char* end) {
+                    if (type == nitro::log::detail::binary_record_frame)
+                    {
+                        decode_record(begin, end, out);
+                    }
+                });
+            }
+
+        private:
+            template <typename F>
+            static std::size_t for_each_frame(const char* data, std::size_t size, F&& f)
+            {
+                const char* position = data;
+                const char* end = data + size;
+
+                while (position != end)
+                {
+                    const char* payload = position + 1;
+                    std::uint64_t length;
+                    if (!nitro::log::detail::get_varint(payload, end, length) ||
+                        length > static_cast<std::uint64_t>(end - payload))
+                    {
+                        break;
+                    }
+
+                    f(*position, payload, payload + length);
+                    position = payload + length;
+                }
+
+                return static_cast<std::size_t>(position - data);
+            }
+
+            struct record_fields
+            {
+                unsigned char present = 0;
+                std::int64_t timestamp = 0;
+                severity_level severity = severity_level::info;
+                std::uint64_t tag = 0;
+                std::int64_t pid = 0;
+                std::int64_t tid = 0;
+                std::uint64_t thread = 0;
+            };
+
+            static bool read_fields(const char*& in, const char* end, record_fields& fields)
+            {
+                using namespace nitro::log::detail;
+
+                if (in == end)
+                {
+                    return false;
+                }
+                fields.present = static_cast<unsigned char>(*in++);
+
+                std::uint64_t value;
+
+                if (fields.present & (binary_system_timestamp | binary_ticks_timestamp))
+                {
+                    if (!get_varint(in, end, value))
+                    {
+                        return false;
+                    }
+                    fields.timestamp = zigzag_decode(value);
+                }
+
+                if (fields.present & binary_severity)
+                {
+                    if (in == end)
+                    {
+                        return false;
+                    }
+                    fields.severity = static_cast<severity_level>(*in++);
+                }
+
+                if ((fields.present & binary_tag) && !get_varint(in, end, fields.tag))
+                {
+                    return false;
+                }
+
+                if (fields.present & binary_pid)
+                {
+                    if (!get_varint(in, end, value))
+                    {
+                        return false;
+                    }
+                    fields.pid = zigzag_decode(value);
+
+                    if (!get_varint(in, end, value))
+                    {
+                        return false;
+                    }
+                    fields.tid = zigzag_decode(value);
+                }
+
+                return !(fields.present & binary_thread) || get_varint(in, end, fields.thread);
+            }
+
+            void decode_record(const char* in, const char* end, std::ostream& out) const
+            {
+                using namespace nitro::log::detail;
+
+                record_fields fields;
+                if (!read_fields(in, end, fields))
+                {
+                    out << "<corrupted record>\n";
+                    return;
+                }
+
+                out.put('[');
+                if (fields.present & binary_system_timestamp)
+                {
+                    char buffer[nitro::detail::iso8601_max_size];
+                    std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds>
+                        timestamp{ std::chrono::nanoseconds(fields.timestamp) };
+                    out.write(buffer, static_cast<std::streamsize>(
+                                          nitro::detail::format_iso8601(buffer, timestamp)));
+                }
+                else if (fields.present & binary_ticks_timestamp)
+                {
+                    write_signed(fields.timestamp, out);
+                }
+                out.put(']');
+
+                if (fields.present & binary_pid)
+                {
+                    out.put('[');
+                    write_signed(fields.pid, out);
+                    out.put(':');
+                    write_signed(fields.tid, out);
+                    out.put(']');
+                }
+
+                if (fields.present & binary_thread)
+                {
+                    char buffer[nitro::detail::max_digits<std::uint64_t>()];
+                    char* digits_end = buffer + sizeof(buffer);
+                    char* digits = nitro::detail::format_hex(digits_end, fields.thread);
+                    out.write("[0x", 3);
+                    out.write(digits, digits_end - digits);
+                    out.put(']');
+                }
+
+                if (fields.present & binary_tag)
+                {
+                    out.put('[');
+                    write_name<tag_table>(tags_, fields.tag, out);
+                    out.put(']');
+                }
+
+                if (fields.present & binary_severity)
+                {
+                    const char* name = severity_name(fields.severity);
+                    out.put('[');
+                    out.write(name, static_cast<std::streamsize>(std::strlen(name)));
+                    out.put(']');
+                }
+
+                out.write(": ", 2);
+
+                if (!decode_arguments(in, end, out))
+                {
+                    out << "<corrupted>";
+                }
+
+                out.put('\n');
+            }
+
+            bool decode_arguments(const char* in, const char* end, std::ostream& out) const
+            {
+                using namespace nitro::log::detail;
+
+                while (in != end)
+                {
+                    const char kind = *in++;
+                    std::uint64_t value;
+
+                    switch (kind)
+                    {
+                    case binary_literal_argument:
+                        if (!get_varint(in, end, value))
+                        {
+                            return false;
+                        }
+                        write_name<literal_table>(literals_, value, out);
+                        break;
+
+                    case binary_string_argument:
+                        if (!get_varint(in, end, value) ||
+                            value > static_cast<std::uint64_t>(end - in))
+                        {
+                            return false;
+                        }
+                        out.write(in, static_cast<std::streamsize>(value));
+                        in += value;
+                        break;
+
+                    case binary_char_argument:
+                        if (in == end)
+                        {
+                            return false;
+                        }
+                        out.put(*in++);
+                        break;
+
+                    case binary_signed_argument:
+                        if (!get_varint(in, end, value))
+                        {
+                            return false;
+                        }
+                        write_signed(zigzag_decode(value), out);
+                        break;
+
+                    case binary_unsigned_argument:
+                        if (!get_varint(in, end, value))
+                        {
+                            return false;
+                        }
+                        write_unsigned(value, out);
+                        break;
+
+                    case binary_floating_argument:
+                    {
+                        double number;
+                        if (static_cast<std::size_t>(end - in) < sizeof(number))
+                        {
+                            return false;
+                        }
+                        std::memcpy(&number, in, sizeof(number));
+                        in += sizeof(number);
+
+                        // the default format of std::ostream
+                        char buffer[64];
+                        auto length = nitro::detail::format_floating(buffer, sizeof(buffer),
+                                                                     number, 'g', 6);
+                        if (length > 0 && static_cast<std::size_t>(length) < sizeof(buffer))
+                        {
+                            out.write(buffer, length);
+                        }
+                        break;
+                    }
+
+                    default:
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
+            template <typename Table>
+            void write_name(const std::unordered_map<std::uint64_t, std::string>& names,
+                            std::uint64_t id, std::ostream& out) const
+            {
+                auto it = names.find(id);
+                if (it != names.end())
+                {
+                    out.write(it->second.data(), static_cast<std::streamsize>(it->second.size()));
+                    return;
+                }
+
+                if (use_process_tables_ && id < Table::max_size)
+                {
+                    auto name = Table::instance().name(static_cast<typename Table::id_type>(id));
+                    if (name)
+                    {
+                        out << name;
+                        return;
+                    }
+                }
+
+                out << "<undefined #" << id << '>';
+            }
+
+            static void write_unsigned(std::uint64_t value, std::ostream& out)
+            {
+                char buffer[nitro::detail::max_digits<std::uint64_t>()];
+                char* end = buffer + sizeof(buffer);
+                char* begin = nitro::detail::format_decimal(end, value);
+                out.write(begin, end - begin);
+            }
+
+            static void write_signed(std::int64_t value, std::ostream& out)
+            {
+                auto magnitude = static_cast<std::uint64_t>(value);
+                if (value < 0)
+                {
+                    out.put('-');
+                    magnitude = 0u - magnitude;
+                }
+                write_unsigned(magnitude, out);
+            }
+
+            bool use_process_tables_;
+            std::unordered_map<std::uint64_t, std::string> literals_;
+            std::unordered_map<std::uint64_t, std::string> tags_;
+        };
+    } // namespace formatter
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_FORMATTER_BINARY_DECODER_HPP
@@ -0,0 +1,476 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_FORMATTER_JSON_HPP
+#define INCLUDE_NITRO_LOG_FORMATTER_JSON_HPP
+
+#include <nitro/format/detail/iso8601.hpp>
+#include <nitro/format/detail/kernels.hpp>
+#include <nitro/log/attribute/call_site.hpp>
+#include <nitro/log/attribute/interned_tag.hpp>
+#include <nitro/log/attribute/message.hpp>
+#include <nitro/log/attribute/severity.hpp>
+#include <nitro/log/attribute/tag.hpp>
+#include <nitro/log/attribute/timestamp.hpp>
+#include <nitro/log/record.hpp>
+
+#include <nitro/lang/string_ref.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+namespace nitro
+{
+namespace log
+{
+    // these attributes need headers, which not every program can include
+    class hostname_attribute;
+    class mpi_rank_attribute;
+    class omp_thread_id_attribute;
+    class pid_attribute;
+    class pthread_id_attribute;
+    class rank_attribute;
+    class std_thread_id_attribute;
+
+    namespace formatter
+    {
+        /**
+         * \brief Writes the members of a JSON object into a std::ostream
+         *
+         * Used by json_formatter and specializations of json_attribute.
+         */
+        class json_writer
+        {
+        public:
+            explicit json_writer(std::ostream& s) : s_(s)
+            {
+            }
+
+            /**
+             * \brief writes the key of the next member
+             *
+             * The prefix is the complete text before the value, e.g. ",\"pid\":". The comma is
+             * left out for the first member.
+             */
+            template <std::size_t N>
+            void key(const char (&prefix)[N])
+            {
+                s_.write(prefix + first_, static_cast<std::streamsize>(N - 1 - first_));
+                first_ = 0;
+            }
+
+            /// writes a quoted and escaped string
+            void string(const char* data, std::size_t size)
+            {
+                s_.put('"');
+
+                const char* run = data;
+                const char* end = data + size;
+                for (const char* c = data; c != end; ++c)
+                {
+                    auto u = static_cast<unsigned char>(*c);
+                    if (u >= 0x20 && u != '"' && u != '\\')
+                    {
+                        continue;
+                    }
+
+                    s_.write(run, c - run);
+                    escape(u);
+                    run = c + 1;
+                }
+                s_.write(run, end - run);
+
+                s_.put('"');
+            }
+
+            void string(lang::string_ref str)
+            {
+                string(str.get(), str.size());
+            }
+
+            void string(const std::string& str)
+            {
+                string(str.data(), str.size());
+            }
+
+            void string(const char* str)
+            {
+                string(str, std::strlen(str));
+            }
+
+            void number(std::uint64_t value)
+            {
+                char buffer[nitro::detail::max_digits<std::uint64_t>()];
+                char* end = buffer + sizeof(buffer);
+                char* begin = nitro::detail::format_decimal(end, value);
+                s_.write(begin, end - begin);
+            }
+
+            void number(std::int64_t value)
+            {
+                auto magnitude = static_cast<std::uint64_t>(value);
+                if (value < 0)
+                {
+                    s_.put('-');
+                    magnitude = 0u - magnitude;
+                }
+                number(magnitude);
+            }
+
+            void number(int value)
+            {
+                number(static_cast<std::int64_t>(value));
+            }
+
+            void number(unsigned value)
+            {
+                number(static_cast<std::uint64_t>(value));
+            }
+
+            /// the stream, for values, which need no escaping
+            std::ostream& stream()
+            {
+                return s_;
+            }
+
+        private:
+            void escape(unsigned char c)
+            {
+                char buffer[6] = { '\\', 'u', '0', '0', 0, 0 };
+                switch (c)
+                {
+                case '"':
+                    s_.write("\\\"", 2);
+                    return;
+                case '\\':
+                    s_.write("\\\\", 2);
+                    return;
+                case '\n':
+                    s_.write("\\n", 2);
+                    return;
+                case '\r':
+                    s_.write("\\r", 2);
+                    return;
+                case '\t':
+                    s_.write("\\t", 2);
+                    return;
+                case '\b':
+                    s_.write("\\b", 2);
+                    return;
+                case '\f':
+                    s_.write("\\f", 2);
+                    return;
+                default:
+                    buffer[4] = "0123456789abcdef"[c >> 4];
+                    buffer[5] = "0123456789abcdef"[c & 0xf];
+                    s_.write(buffer, 6);
+                }
+            }
+
+            std::ostream& s_;
+            int first_ = 1;
+        };
+
+        /**
+         * \brief How json_formatter writes an attribute of a record
+         *
+         * Specializations provide template <typename Record> static void write(const Record&,
+         * json_writer&), which writes the keys and values of the attribute. Attributes without
+         * a specialization are left out, specialize it for attributes of your own:
+         *
+         *     template <>
+         *     struct json_attribute<job_attribute>
+         *     {
+         *         template <typename Record>
+         *         static void write(const Record& r, json_writer& w)
+         *         {
+         *             w.key(",\"job\":");
+         *             w.number(r.job());
+         *         }
+         *     };
+         */
+        template <typename Attribute>
+        struct json_attribute
+        {
+            template <typename Record>
+            static void write(const Record&, json_writer&)
+            {
+            }
+        };
+
+        template <>
+        struct json_attribute<message_attribute>
+        {
+            template <typename Record>
+            static void write(const Record& r, json_writer& w)
+            {
+                w.key(",\"message\":");
+                w.string(r.message());
+            }
+        };
+
+        template <typename Clock>
+        struct json_attribute<timestamp_clock_attribute<Clock>>
+        {
+            template <typename Record>
+            static void write(const Record& r, json_writer& w)
+            {
+                w.key(",\"timestamp\":");
+                write_timestamp(r.timestamp(), w,
+                                nitro::detail::is_system_time_point<
+                                    std::decay_t<decltype(r.timestamp())>>());
+            }
+
+        private:
+            // ISO-8601 in UTC
+            template <typename TimePoint>
+            static void write_timestamp(const TimePoint& timestamp, json_writer& w,
+                                        std::true_type)
+            {
+                char buffer[nitro::detail::iso8601_max_size + 2];
+                buffer[0] = '"';
+                auto length = nitro::detail::format_iso8601(buffer + 1, timestamp);
+                buffer[length + 1] = '"';
+                w.stream().write(buffer, static_cast<std::streamsize>(length + 2));
+            }
+
+            // ticks since the epoch of the clock
+            template <typename TimePoint>
+            static void write_timestamp(const TimePoint& timestamp, json_writer& w,
+                                        std::false_type)
+            {
+                w.number(static_cast<std::int64_t>(timestamp.time_since_epoch().count()));
+            }
+        };
+
+        template <>
+        struct json_attribute<severity_attribute>
+        {
+            template <typename Record>
+            static void write(const Record& r, json_writer& w)
+            {
+                w.key(",\"severity\":");
+
+                switch (r.severity())
+                {
+                case severity_level::trace:
+                    w.stream().write("\"trace\"", 7);
+                    break;
+                case severity_level::debug:
+                    w.stream().write("\"debug\"", 7);
+                    break;
+                case severity_level::info:
+                    w.stream().write("\"info\"", 6);
+                    break;
+                case severity_level::warn:
+                    w.stream().write("\"warn\"", 6);
+                    break;
+                case severity_level::error:
+                    w.stream().write("\"error\"", 7);
+                    break;
+                default:
+                    w.stream().write("\"fatal\"", 7);
+                }
+            }
+        };
+
+        /// left out, if the tag is empty
+        template <>
+        struct json_attribute<tag_attribute>
+        {
+            template <typename Record>
+            static void write(const Record& r, json_writer& w)
+            {
+                // the const tag() returns a copy
+                const tag_attribute& attribute = r;
+                const auto& tag = const_cast<tag_attribute&>(attribute).tag();
+                if (!tag.empty())
+                {
+                    w.key(",\"tag\":");
+                    w.string(tag);
+                }
+            }
+        };
+
+        /// left out, if there is no tag
+        template <>
+        struct json_attribute<interned_tag_attribute>
+        {
+            template <typename Record>
+            static void write(const Record& r, json_writer& w)
+            {
+                const auto& tag = r.tag();
+                if (!tag.empty())
+                {
+                    w.key(",\"tag\":");
+                    w.string(tag);
+                }
+            }
+        };
+
+        /// left out, if the record has no call site
+        template <>
+        struct json_attribute<call_site_attribute>
+        {
+            template <typename Record>
+            static void write(const Record& r, json_writer& w)
+            {
+                const auto* site = r.call_site();
+                if (site == nullptr)
+                {
+                    return;
+                }
+
+                w.key(",\"file\":");
+                w.string(site->file());
+                w.key(",\"line\":");
+                w.number(site->line());
+                w.key(",\"function\":");
+                w.string(site->function());
+            }
+        };
+
+        template <>
+        struct json_attribute<pid_attribute>
+        {
+            template <typename Record>
+            static void write(const Record& r, json_writer& w)
+            {
+                w.key(",\"pid\":");
+                w.number(r.pid());
+                w.key(",\"tid\":");
+                w.number(r.tid());
+            }
+        };
+
+        template <>
+        struct json_attribute<hostname_attribute>
+        {
+            template <typename Record>
+            static void write(const Record& r, json_writer& w)
+            {
+                w.key(",\"hostname\":");
+                w.string(r.hostname());
+            }
+        };
+
+        template <>
+        struct json_attribute<pthread_id_attribute>
+        {
+            template <typename Record>
+            static void write(const Record& r, json_writer& w)
+            {
+                w.key(",\"pthread_id\":");
+                w.number(r.pthread_id());
+            }
+        };
+
+        /// a string, as std::thread::id is only defined to be printable
+        template <>
+        struct json_attribute<std_thread_id_attribute>
+        {
+            template <typename Record>
+            static void write(const Record& r, json_writer& w)
+            {
+                w.key(",\"thread_id\":\"");
+                w.stream() << r.std_thread_id();
+                w.stream().put('"');
+            }
+        };
+
+        template <>
+        struct json_attribute<omp_thread_id_attribute>
+        {
+            template <typename Record>
+            static void write(const Record& r, json_writer& w)
+            {
+                w.key(",\"omp_thread_id\":");
+                w.number(r.omp_thread_id());
+            }
+        };
+
+        template <>
+        struct json_attribute<rank_attribute>
+        {
+            template <typename Record>
+            static void write(const Record& r, json_writer& w)
+            {
+                w.key(",\"rank\":");
+                w.number(r.rank());
+            }
+        };
+
+        template <>
+        struct json_attribute<mpi_rank_attribute>
+        {
+            template <typename Record>
+            static void write(const Record& r, json_writer& w)
+            {
+                w.key(",\"mpi_rank\":");
+                w.number(r.mpi_rank());
+                w.key(",\"mpi_size\":");
+                w.number(r.mpi_size());
+            }
+        };
+
+        template <typename Record>
+        class json_formatter;
+
+        /**
+         * \brief Formats records as one JSON object per line
+         *
+         * The members are the attributes of the record in the order of record<Attributes...>,
+         * e.g. {"timestamp":"2026-10-18T08:15:42.123456Z","severity":"info","message":"ok"}.
+         * Every attribute is written by its json_attribute specialization with a key prefix
+         * fixed at compile-time. Strings are escaped as required by JSON, other bytes, e.g.
+         * UTF-8 sequences, are written as they are.
+         *
+         * Everything is written directly into the buffer of the logger.
+         */
+        template <typename... Attributes>
+        class json_formatter<record<Attributes...>>
+        {
+        public:
+            void format(record<Attributes...>& r, std::ostream& s)
+            {
+                json_writer w(s);
+
+                s.put('{');
+                int expand[] = { 0, (json_attribute<Attributes>::write(r, w), 0)... };
+                (void)expand;
+                s.write("}\n", 2);
+            }
+        };
+    } // namespace formatter
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_FORMATTER_JSON_HPP
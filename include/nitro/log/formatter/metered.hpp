@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_FORMATTER_METERED_HPP
+#define INCLUDE_NITRO_LOG_FORMATTER_METERED_HPP
+
+#include <nitro/log/detail/formats_into_stream.hpp>
+#include <nitro/log/metrics.hpp>
+
+#include <chrono>
+#include <ostream>
+#include <string>
+
+namespace nitro
+{
+namespace log
+{
+    namespace detail
+    {
+        // formatter::metered<Formatter>::type, formats like Formatter and records the duration
+        template <typename Metered, typename Formatter, typename Record,
+                  bool = formats_into_stream<Formatter, Record>::value>
+        class metered_formatter : public Formatter
+        {
+        public:
+            metered_formatter()
+            {
+                Metered::add_to_registry();
+            }
+
+            std::string format(Record& r)
+            {
+                auto start = std::chrono::steady_clock::now();
+                auto result = Formatter::format(r);
+                Metered::recorder::record(std::chrono::steady_clock::now() - start);
+                return result;
+            }
+        };
+
+        template <typename Metered, typename Formatter, typename Record>
+        class metered_formatter<Metered, Formatter, Record, true> : public Formatter
+        {
+        public:
+            metered_formatter()
+            {
+                Metered::add_to_registry();
+            }
+
+            void format(Record& r, std::ostream& s)
+            {
+                auto start = std::chrono::steady_clock::now();
+                Formatter::format(r, s);
+                Metered::recorder::record(std::chrono::steady_clock::now() - start);
+            }
+        };
+    } // namespace detail
+
+    namespace formatter
+    {
+        struct metered_config
+        {
+            /// the name of the latencies in write_metrics()
+            std::string name = "format";
+        };
+
+        /**
+         * \brief Formatter adapter, which records how long Formatter takes for every record
+         *
+         * The durations are recorded in a latency_histogram by every thread on its own, see
+         * latency(). The adapter formats the same way as Formatter, into the buffer of the
+         * logger, if Formatter does so. The configuration is read when the logger is
+         * constructed. Use the nested template as formatter, e.g. metered<text_formatter>::type.
+         */
+        template <template <typename> class Formatter>
+        struct metered
+        {
+            template <typename Record>
+            using type = detail::metered_formatter<metered, Formatter<Record>, Record>;
+
+            static metered_config& config()
+            {
+                static metered_config config_;
+                return config_;
+            }
+
+            /// the durations of all records formatted so far
+            static latency_histogram latency()
+            {
+                return recorder::histogram();
+            }
+
+        private:
+            template <typename, typename, typename, bool>
+            friend class detail::metered_formatter;
+
+            using recorder = detail::latency_recorder<metered>;
+
+            static void add_to_registry()
+            {
+                static bool registered = []() {
+                    detail::metrics_registry::instance().add(
+                        config().name, [](std::ostream& s) { s << latency(); });
+                    return true;
+                }();
+                (void)registered;
+            }
+        };
+    } // namespace formatter
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_FORMATTER_METERED_HPP
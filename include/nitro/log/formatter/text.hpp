@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_FORMATTER_TEXT_HPP
+#define INCLUDE_NITRO_LOG_FORMATTER_TEXT_HPP
+
+#include <nitro/format/detail/iso8601.hpp>
+#include <nitro/format/detail/kernels.hpp>
+#include <nitro/log/attribute/call_site.hpp>
+#include <nitro/log/attribute/interned_tag.hpp>
+#include <nitro/log/attribute/severity.hpp>
+#include <nitro/log/attribute/tag.hpp>
+#include <nitro/log/detail/has_attribute.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <type_traits>
+
+namespace nitro
+{
+namespace log
+{
+    namespace formatter
+    {
+        /**
+         * \brief Formats records as "[timestamp][tag][severity][file:line]: message\n"
+         *
+         * Timestamps of std::chrono::system_clock are printed as ISO-8601 in UTC, timestamps of
+         * other clocks as ticks since their epoch. The tag is left out, if the record has none
+         * or it is empty, just like the severity and the call site, if the record has none. The
+         * call site is printed with the file name without its directories.
+         *
+         * Everything is written with the locale-free kernels of nitro::format directly into the
+         * buffer of the logger.
+         */
+        template <typename Record>
+        class text_formatter
+        {
+        public:
+            void format(Record& r, std::ostream& s)
+            {
+                s.put('[');
+                write_timestamp(r.timestamp(), s,
+                                nitro::detail::is_system_time_point<
+                                    std::decay_t<decltype(r.timestamp())>>());
+                s.put(']');
+
+                write_tag(r, s, has_tag());
+                write_severity(r, s, has_severity());
+                write_call_site(r, s, has_call_site());
+
+                s.write(": ", 2);
+                s << r.message();
+                s.put('\n');
+            }
+
+        private:
+            using has_tag = std::integral_constant<
+                bool, nitro::log::detail::has_attribute<tag_attribute, Record>::value ||
+                          nitro::log::detail::has_attribute<interned_tag_attribute, Record>::value>;
+            using has_severity = std::integral_constant<
+                bool, nitro::log::detail::has_attribute<severity_attribute, Record>::value>;
+            using has_call_site = std::integral_constant<
+                bool, nitro::log::detail::has_attribute<call_site_attribute, Record>::value>;
+
+            template <typename TimePoint>
+            static void write_timestamp(const TimePoint& timestamp, std::ostream& s,
+                                        std::true_type)
+            {
+                char buffer[nitro::detail::iso8601_max_size];
+                auto length = nitro::detail::format_iso8601(buffer, timestamp);
+                s.write(buffer, static_cast<std::streamsize>(length));
+            }
+
+            template <typename TimePoint>
+            static void write_timestamp(const TimePoint& timestamp, std::ostream& s,
+                                        std::false_type)
+            {
+                auto ticks = static_cast<std::int64_t>(timestamp.time_since_epoch().count());
+                auto magnitude = static_cast<std::uint64_t>(ticks);
+                if (ticks < 0)
+                {
+                    s.put('-');
+                    magnitude = 0u - magnitude;
+                }
+
+                char buffer[nitro::detail::max_digits<std::uint64_t>()];
+                char* end = buffer + sizeof(buffer);
+                char* begin = nitro::detail::format_decimal(end, magnitude);
+                s.write(begin, end - begin);
+            }
+
+            static void write_tag(Record& r, std::ostream& s, std::true_type)
+            {
+                const auto& tag = r.tag();
+                if (!tag.empty())
+                {
+                    s.put('[');
+                    s.write(tag.data(), static_cast<std::streamsize>(tag.size()));
+                    s.put(']');
+                }
+            }
+
+            static void write_tag(Record&, std::ostream&, std::false_type)
+            {
+            }
+
+            static void write_severity(Record& r, std::ostream& s, std::true_type)
+            {
+                const char* name = severity_name(r.severity());
+
+                s.put('[');
+                s.write(name, static_cast<std::streamsize>(std::strlen(name)));
+                s.put(']');
+            }
+
+            static void write_severity(Record&, std::ostream&, std::false_type)
+            {
+            }
+
+            static void write_call_site(Record& r, std::ostream& s, std::true_type)
+            {
+                const auto* site = r.call_site();
+                if (site == nullptr)
+                {
+                    return;
+                }
+
+                s.put('[');
+                s.write(site->file_name(),
+                        static_cast<std::streamsize>(std::strlen(site->file_name())));
+                s.put(':');
+
+                char buffer[nitro::detail::max_digits<unsigned>()];
+                char* end = buffer + sizeof(buffer);
+                char* begin = nitro::detail::format_decimal(end, site->line());
+                s.write(begin, end - begin);
+                s.put(']');
+            }
+
+            static void write_call_site(Record&, std::ostream&, std::false_type)
+            {
+            }
+        };
+    } // namespace formatter
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_FORMATTER_TEXT_HPP
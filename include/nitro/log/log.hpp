@@ -40,7 +40,38 @@ static_assert(std::is_same<decltype(nitro::log::severity_level::NITRO_LOG_MIN_SE
               "NITRO_LOG_MIN_SEVERITY has to be of type nitro::log::severity_level");
 #endif
 
+#include <nitro/log/call_site.hpp>
 #include <nitro/log/logger.hpp>
 #include <nitro/log/record.hpp>
 
+/**
+ * \brief Starts a log statement, whose arguments are only evaluated if it is not filtered
+ *
+ *     NITRO_LOG_TAG(logging, debug, "net") << "received " << expensive_dump();
+ *
+ * The statement is filtered at compile-time with NITRO_LOG_MIN_SEVERITY and at runtime with the
+ * pre_filter of the logger's filter, before any of the streamed expressions is evaluated. Tag is
+ * evaluated once, the pre_filter is called at most once. Records with a call_site_attribute get
+ * the location of the statement, see NITRO_LOG_CALL_SITE().
+ *
+ * Every statement registers its call site, when it is executed first. It can then be enabled or
+ * disabled at runtime with the nitro::log::call_site_registry.
+ *
+ * \param Logger the nitro::log::logger
+ * \param Severity the name of the severity, e.g. debug
+ */
+#define NITRO_LOG_TAG(Logger, Severity, Tag)                                                       \
+    if (const auto nitro_log_check =                                                               \
+            ::nitro::log::detail::check_call_site<Logger, ::nitro::log::severity_level::Severity>( \
+                NITRO_LOG_STATIC_CALL_SITE(), __func__, Tag))                                      \
+    {                                                                                              \
+    }                                                                                              \
+    else                                                                                           \
+        Logger::Severity(nitro_log_check.checked(), nitro_log_check.tag())
+
+/**
+ * \brief Like NITRO_LOG_TAG, but without a tag
+ */
+#define NITRO_LOG(Logger, Severity) NITRO_LOG_TAG(Logger, Severity, nullptr)
+
 #endif // INCLUDE_NITRO_LOG_LOG_HPP
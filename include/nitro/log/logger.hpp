@@ -29,11 +29,21 @@
 #ifndef INCLUDE_NITRO_LOG_LOGGER_HPP
 #define INCLUDE_NITRO_LOG_LOGGER_HPP
 
+#include <nitro/log/detail/formats_into_stream.hpp>
+#include <nitro/log/detail/post_filter.hpp>
+#include <nitro/log/detail/pre_filter.hpp>
+#include <nitro/log/detail/sink_record.hpp>
+#include <nitro/log/detail/stream_buffer.hpp>
 #include <nitro/log/severity.hpp>
 #include <nitro/log/stream.hpp>
 
 #include <nitro/lang/string_ref.hpp>
 
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+
 namespace nitro
 {
 namespace log
@@ -66,14 +76,45 @@ namespace log
             return instance_;
         }
 
+        /**
+         * \brief Whether a log statement with the given severity and tag can be logged at all
+         *
+         * Checked before the record is constructed, see detail::has_pre_filter.
+         */
+        static bool will_log(severity_level severity, lang::string_ref tag)
+        {
+            return detail::pre_filter(static_cast<const Filter<Record>&>(instance()), severity,
+                                      tag);
+        }
+
+        /**
+         * \brief Like will_log(severity, tag), for the statement of the given call site
+         */
+        static bool will_log(severity_level severity, lang::string_ref tag, const call_site& site)
+        {
+            return detail::pre_filter(static_cast<const Filter<Record>&>(instance()), severity,
+                                      tag, site);
+        }
+
         static bool will_log(Record& r)
         {
             return instance().Filter<Record>::filter(r);
         }
 
+        /**
+         * \brief Whether the finished record, i.e. with its message, is logged
+         *
+         * See detail::has_post_filter for the meaning of preceding.
+         */
+        static bool will_log(Record& r, lang::string_ref& preceding)
+        {
+            return detail::post_filter(static_cast<const Filter<Record>&>(instance()), r,
+                                       preceding);
+        }
+
         static void log(severity_level sev, Record& r)
         {
-            instance().Sink::sink(sev, instance().Formater<Record>::format(r));
+            log(sev, r, detail::formats_into_stream<Formater<Record>, Record>());
         }
 
         static actual_stream_t<severity_level::trace> trace(lang::string_ref tag = nullptr)
@@ -81,30 +122,128 @@ namespace log
             return actual_stream_t<severity_level::trace>(tag);
         }
 
+        /**
+         * \brief Like trace(tag), but the record refers to the call site of the statement
+         *
+         * Usually called by NITRO_LOG and NITRO_LOG_TAG, or with NITRO_LOG_CALL_SITE(). The
+         * overloads of the other severities work the same.
+         */
+        static actual_stream_t<severity_level::trace> trace(const call_site& site,
+                                                            lang::string_ref tag = nullptr)
+        {
+            return actual_stream_t<severity_level::trace>(tag, site);
+        }
+
+        /**
+         * \brief Like trace(site, tag), for statements which passed the call site and pre_filter
+         *
+         * Only called by NITRO_LOG_TAG, see detail::call_site_check.
+         */
+        static actual_stream_t<severity_level::trace>
+        trace(const detail::checked_call_site& checked, lang::string_ref tag)
+        {
+            return actual_stream_t<severity_level::trace>(tag, checked);
+        }
+
         static actual_stream_t<severity_level::debug> debug(lang::string_ref tag = nullptr)
         {
             return actual_stream_t<severity_level::debug>(tag);
         }
 
+        static actual_stream_t<severity_level::debug> debug(const call_site& site,
+                                                            lang::string_ref tag = nullptr)
+        {
+            return actual_stream_t<severity_level::debug>(tag, site);
+        }
+
+        static actual_stream_t<severity_level::debug>
+        debug(const detail::checked_call_site& checked, lang::string_ref tag)
+        {
+            return actual_stream_t<severity_level::debug>(tag, checked);
+        }
+
         static actual_stream_t<severity_level::info> info(lang::string_ref tag = nullptr)
         {
             return actual_stream_t<severity_level::info>(tag);
         }
 
+        static actual_stream_t<severity_level::info> info(const call_site& site,
+                                                          lang::string_ref tag = nullptr)
+        {
+            return actual_stream_t<severity_level::info>(tag, site);
+        }
+
+        static actual_stream_t<severity_level::info>
+        info(const detail::checked_call_site& checked, lang::string_ref tag)
+        {
+            return actual_stream_t<severity_level::info>(tag, checked);
+        }
+
         static actual_stream_t<severity_level::warn> warn(lang::string_ref tag = nullptr)
         {
             return actual_stream_t<severity_level::warn>(tag);
         }
 
+        static actual_stream_t<severity_level::warn> warn(const call_site& site,
+                                                          lang::string_ref tag = nullptr)
+        {
+            return actual_stream_t<severity_level::warn>(tag, site);
+        }
+
+        static actual_stream_t<severity_level::warn>
+        warn(const detail::checked_call_site& checked, lang::string_ref tag)
+        {
+            return actual_stream_t<severity_level::warn>(tag, checked);
+        }
+
         static actual_stream_t<severity_level::error> error(lang::string_ref tag = nullptr)
         {
             return actual_stream_t<severity_level::error>(tag);
         }
 
+        static actual_stream_t<severity_level::error> error(const call_site& site,
+                                                            lang::string_ref tag = nullptr)
+        {
+            return actual_stream_t<severity_level::error>(tag, site);
+        }
+
+        static actual_stream_t<severity_level::error>
+        error(const detail::checked_call_site& checked, lang::string_ref tag)
+        {
+            return actual_stream_t<severity_level::error>(tag, checked);
+        }
+
         static actual_stream_t<severity_level::fatal> fatal(lang::string_ref tag = nullptr)
         {
             return actual_stream_t<severity_level::fatal>(tag);
         }
+
+        static actual_stream_t<severity_level::fatal> fatal(const call_site& site,
+                                                            lang::string_ref tag = nullptr)
+        {
+            return actual_stream_t<severity_level::fatal>(tag, site);
+        }
+
+        static actual_stream_t<severity_level::fatal>
+        fatal(const detail::checked_call_site& checked, lang::string_ref tag)
+        {
+            return actual_stream_t<severity_level::fatal>(tag, checked);
+        }
+
+    private:
+        static void log(severity_level sev, Record& r, std::true_type)
+        {
+            auto lease = detail::stream_lease::acquire();
+            instance().Formater<Record>::format(r, lease.stream());
+            detail::sink_record(static_cast<Sink&>(instance()), sev, lease.buffer().str(), r);
+        }
+
+        static void log(severity_level sev, Record& r, std::false_type)
+        {
+            const std::string formatted_record = instance().Formater<Record>::format(r);
+            detail::sink_record(static_cast<Sink&>(instance()), sev,
+                                lang::string_ref(formatted_record), r);
+        }
     };
 } // namespace log
 } // namespace nitro
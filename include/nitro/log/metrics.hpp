@@ -0,0 +1,339 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_METRICS_HPP
+#define INCLUDE_NITRO_LOG_METRICS_HPP
+
+#include <nitro/log/detail/sharded_counters.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace nitro
+{
+namespace log
+{
+    /**
+     * \brief The distribution of durations recorded by one of the metered adapters
+     *
+     * Durations are counted in buckets with a relative width of 1/16, like an HDR histogram:
+     * durations below 32ns get a bucket per nanosecond, above that, every power of two is split
+     * into 16 buckets. Durations of more than 2^40ns, about 18 minutes, are counted in the last
+     * bucket. Percentiles are reported as the largest duration of their bucket.
+     */
+    class latency_histogram
+    {
+        static constexpr std::size_t linear_buckets = 32;
+        static constexpr std::size_t sub_buckets = 16;
+        static constexpr unsigned linear_bits = 5;
+        static constexpr unsigned max_bits = 40;
+
+    public:
+        static constexpr std::size_t bucket_count =
+            linear_buckets + (max_bits - linear_bits) * sub_buckets;
+
+        latency_histogram() = default;
+
+        explicit latency_histogram(const std::array<std::uint64_t, bucket_count>& buckets,
+                                   std::uint64_t total_ns)
+        : buckets_(buckets), total_ns_(total_ns)
+        {
+            for (auto n : buckets_)
+            {
+                count_ += n;
+            }
+        }
+
+        /// the bucket counting durations of ns nanoseconds
+        static std::size_t bucket_of(std::uint64_t ns)
+        {
+            if (ns < linear_buckets)
+            {
+                return static_cast<std::size_t>(ns);
+            }
+
+            ns = std::min<std::uint64_t>(ns, (std::uint64_t(1) << max_bits) - 1);
+
+            unsigned msb = linear_bits;
+            while ((ns >> (msb + 1)) != 0)
+            {
+                ++msb;
+            }
+
+            auto shift = msb - (linear_bits - 1);
+            return linear_buckets + (msb - linear_bits) * sub_buckets +
+                   static_cast<std::size_t>((ns >> shift) - sub_buckets);
+        }
+
+        /// the largest duration counted in the bucket, in nanoseconds
+        static std::uint64_t bucket_max(std::size_t bucket)
+        {
+            if (bucket < linear_buckets)
+            {
+                return bucket;
+            }
+
+            auto octave = (bucket - linear_buckets) / sub_buckets;
+            auto top = (bucket - linear_buckets) % sub_buckets + sub_buckets;
+            return ((std::uint64_t(top) + 1) << (octave + 1)) - 1;
+        }
+
+        std::uint64_t count() const
+        {
+            return count_;
+        }
+
+        std::chrono::nanoseconds total() const
+        {
+            return std::chrono::nanoseconds(total_ns_);
+        }
+
+        std::chrono::nanoseconds mean() const
+        {
+            return std::chrono::nanoseconds(count_ == 0 ? 0 : total_ns_ / count_);
+        }
+
+        /**
+         * \brief the duration, which the given fraction of the recorded durations does not exceed
+         *
+         * \param fraction between 0 and 1, e.g. 0.99 for the 99th percentile
+         */
+        std::chrono::nanoseconds percentile(double fraction) const
+        {
+            if (count_ == 0)
+            {
+                return std::chrono::nanoseconds(0);
+            }
+
+            auto rank = static_cast<std::uint64_t>(fraction * static_cast<double>(count_) + 0.5);
+            rank = std::max<std::uint64_t>(1, std::min(rank, count_));
+
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < bucket_count; ++i)
+            {
+                seen += buckets_[i];
+                if (seen >= rank)
+                {
+                    return std::chrono::nanoseconds(bucket_max(i));
+                }
+            }
+            return std::chrono::nanoseconds(bucket_max(bucket_count - 1));
+        }
+
+        std::chrono::nanoseconds max() const
+        {
+            return percentile(1.0);
+        }
+
+        const std::array<std::uint64_t, bucket_count>& buckets() const
+        {
+            return buckets_;
+        }
+
+    private:
+        std::array<std::uint64_t, bucket_count> buckets_ = {};
+        std::uint64_t count_ = 0;
+        std::uint64_t total_ns_ = 0;
+    };
+
+    /// writes e.g. "count 10 mean 130ns p50 127ns p99 255ns max 255ns"
+    template <typename S>
+    S& operator<<(S& s, const latency_histogram& h)
+    {
+        s << "count " << h.count() << " mean " << h.mean().count() << "ns p50 "
+          << h.percentile(0.5).count() << "ns p99 " << h.percentile(0.99).count() << "ns max "
+          << h.max().count() << "ns";
+        return s;
+    }
+
+    namespace detail
+    {
+        /**
+         * \brief Records durations into a latency_histogram, with counters of every thread
+         *
+         * \tparam Domain distinguishes different histograms
+         */
+        template <typename Domain>
+        class latency_recorder
+        {
+            static constexpr std::size_t total_index = latency_histogram::bucket_count;
+
+            using counters = sharded_counters<latency_recorder, total_index + 1>;
+
+        public:
+            static void record(std::chrono::nanoseconds duration)
+            {
+                auto ns = static_cast<std::uint64_t>(std::max<std::int64_t>(duration.count(), 0));
+
+                auto& shard = counters::local();
+                shard.add(latency_histogram::bucket_of(ns));
+                shard.add(total_index, ns);
+            }
+
+            static latency_histogram histogram()
+            {
+                auto values = counters::values();
+
+                std::array<std::uint64_t, latency_histogram::bucket_count> buckets;
+                std::copy(values.begin(), values.begin() + total_index, buckets.begin());
+                return latency_histogram(buckets, values[total_index]);
+            }
+        };
+
+        /**
+         * \brief The metered adapters, which can be written by write_metrics()
+         *
+         * Every adapter adds itself, when it is constructed, i.e. before its first record.
+         */
+        class metrics_registry
+        {
+        public:
+            using writer = std::function<void(std::ostream&)>;
+
+            static metrics_registry& instance()
+            {
+                // never destroyed, so statics can still log while being destroyed
+                static metrics_registry* instance_ = new metrics_registry();
+                return *instance_;
+            }
+
+            void add(std::string name, writer w)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                sources_.emplace_back(std::move(name), std::move(w));
+            }
+
+            std::vector<std::pair<std::string, writer>> sources() const
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                return sources_;
+            }
+
+        private:
+            metrics_registry() = default;
+
+            mutable std::mutex mutex_;
+            std::vector<std::pair<std::string, writer>> sources_;
+        };
+    } // namespace detail
+
+    /**
+     * \brief writes a line "name: metrics" for every metered adapter in use
+     */
+    inline void write_metrics(std::ostream& s)
+    {
+        for (const auto& source : detail::metrics_registry::instance().sources())
+        {
+            s << source.first << ": ";
+            source.second(s);
+            s << '\n';
+        }
+    }
+
+    /**
+     * \brief Logs the metrics of all metered adapters periodically
+     *
+     * Every interval, and once more when it is destroyed, a thread logs a record with severity
+     * info and tag "nitro.metrics" for every metered adapter in use, see write_metrics(). These
+     * records are counted by the metered adapters of Logging like every other record.
+     *
+     * \tparam Logging the logger to write the metrics with
+     */
+    template <typename Logging>
+    class metrics_reporter
+    {
+    public:
+        explicit metrics_reporter(std::chrono::milliseconds interval)
+        : interval_(interval), thread_([this]() { run(); })
+        {
+        }
+
+        ~metrics_reporter()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stop_ = true;
+            }
+            wakeup_.notify_one();
+            thread_.join();
+
+            report();
+        }
+
+        metrics_reporter(const metrics_reporter&) = delete;
+        metrics_reporter& operator=(const metrics_reporter&) = delete;
+
+        /**
+         * \brief logs the metrics right away
+         */
+        static void report()
+        {
+            // the sources are copied, so the metered adapters of Logging can still add themselves
+            for (const auto& source : detail::metrics_registry::instance().sources())
+            {
+                std::ostringstream metrics;
+                source.second(metrics);
+                Logging::info("nitro.metrics") << source.first << ": " << metrics.str();
+            }
+        }
+
+    private:
+        void run()
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (!wakeup_.wait_for(lock, interval_, [this]() { return stop_; }))
+            {
+                lock.unlock();
+                report();
+                lock.lock();
+            }
+        }
+
+        const std::chrono::milliseconds interval_;
+
+        std::mutex mutex_;
+        std::condition_variable wakeup_;
+        bool stop_ = false;
+        std::thread thread_;
+    };
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_METRICS_HPP
@@ -77,36 +77,40 @@ namespace log
         return default_;
     }
 
-    template <typename S>
-    S& operator<<(S& s, severity_level sev)
+    /**
+     * \brief the name of the severity, padded to five characters
+     */
+    inline const char* severity_name(severity_level sev)
     {
         switch (sev)
         {
         case severity_level::debug:
-            s << "DEBUG";
-            break;
+            return "DEBUG";
 
         case severity_level::trace:
-            s << "TRACE";
-            break;
+            return "TRACE";
 
         case severity_level::info:
-            s << " INFO";
-            break;
+            return " INFO";
 
         case severity_level::warn:
-            s << " WARN";
-            break;
+            return " WARN";
 
         case severity_level::error:
-            s << "ERROR";
-            break;
+            return "ERROR";
 
         case severity_level::fatal:
-            s << "FATAL";
-            break;
+            return "FATAL";
         }
 
+        return "";
+    }
+
+    template <typename S>
+    S& operator<<(S& s, severity_level sev)
+    {
+        s << severity_name(sev);
+
         return s;
     }
 } // namespace log
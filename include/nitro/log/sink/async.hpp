@@ -0,0 +1,438 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_SINK_ASYNC_HPP
+#define INCLUDE_NITRO_LOG_SINK_ASYNC_HPP
+
+#include <nitro/log/detail/bounded_queue.hpp>
+#include <nitro/log/metrics.hpp>
+#include <nitro/log/severity.hpp>
+
+#include <nitro/lang/string_ref.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+namespace nitro
+{
+namespace log
+{
+    namespace sink
+    {
+        /**
+         * \brief What an async sink does with a record if its queue is full
+         *
+         * Records with severity fatal are never dropped, they always block. With drop_oldest, a
+         * fatal record is not evicted either, once it is the oldest record in the queue, newer
+         * records are dropped instead.
+         */
+        enum class overflow_policy
+        {
+            block,
+            drop_newest,
+            drop_oldest
+        };
+
+        struct async_config
+        {
+            /// the name of the queue in write_metrics()
+            std::string name = "async";
+        };
+
+        /**
+         * \brief Sink adapter, which hands records to a background thread
+         *
+         * The calling thread only copies the formatted record into a slot of a bounded lock-free
+         * queue. A dedicated writer thread drains the queue into the wrapped Sink, so the Sink
+         * does not need to be thread-safe itself.
+         *
+         * A fatal record is only returned from after it was written by the wrapped Sink. All
+         * pending records are written at process exit, but not on a crash, see
+         * install_crash_handler().
+         *
+         * The number of dropped records and the depth of the queue are listed by write_metrics()
+         * under config().name, which is read when the sink is constructed.
+         *
+         * \tparam Sink the sink that writes the records
+         * \tparam Policy what to do if the queue is full
+         * \tparam Capacity the number of records the queue can hold
+         */
+        template <typename Sink, overflow_policy Policy = overflow_policy::block,
+                  std::size_t Capacity = 8192>
+        class async
+        {
+            static_assert(Capacity >= 2,
+                          "The queue of an async sink needs a capacity of at least 2");
+
+            struct entry
+            {
+                // atomic, as producers check it before evicting the entry, see push()
+                std::atomic<severity_level> severity{ severity_level::trace };
+                std::string record;
+            };
+
+            class worker
+            {
+            public:
+                worker() : queue_(Capacity), thread_([this]() { run(); })
+                {
+                    std::atexit(&async::stop_at_exit);
+                }
+
+                void push(severity_level sev, lang::string_ref formatted_record)
+                {
+                    if (stopped_.load())
+                    {
+                        // late records, e.g. from destructors of other static objects
+                        write_directly(sev, formatted_record);
+                        return;
+                    }
+
+                    auto fill = [sev, &formatted_record](entry& e) {
+                        e.severity.store(sev, std::memory_order_relaxed);
+                        e.record.assign(formatted_record.get(), formatted_record.size());
+                    };
+
+                    std::size_t position;
+                    if (!queue_.try_push(fill, position))
+                    {
+                        if (Policy == overflow_policy::drop_newest &&
+                            sev != severity_level::fatal)
+                        {
+                            dropped_.fetch_add(1, std::memory_order_relaxed);
+                            return;
+                        }
+
+                        while (!queue_.try_push(fill, position))
+                        {
+                            if (stopped_.load())
+                            {
+                                // nobody takes records out of the queue anymore
+                                write_directly(sev, formatted_record);
+                                return;
+                            }
+
+                            if (Policy == overflow_policy::drop_oldest &&
+                                sev != severity_level::fatal)
+                            {
+                                bool fatal_oldest = false;
+                                auto accept = [&fatal_oldest](const entry& e) {
+                                    fatal_oldest = e.severity.load(std::memory_order_relaxed) ==
+                                                   severity_level::fatal;
+                                    return !fatal_oldest;
+                                };
+
+                                if (queue_.try_pop_if(accept, [](entry&) {}))
+                                {
+                                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                                }
+                                else if (fatal_oldest)
+                                {
+                                    // a fatal record is never evicted, this one is dropped instead
+                                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                                    return;
+                                }
+                                else
+                                {
+                                    std::this_thread::yield();
+                                }
+                            }
+                            else
+                            {
+                                wake();
+                                std::this_thread::yield();
+                            }
+                        }
+                    }
+
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    if (sleeping_.load(std::memory_order_relaxed))
+                    {
+                        wake();
+                    }
+
+                    if (sev == severity_level::fatal)
+                    {
+                        wait_written(position);
+                    }
+                }
+
+                void flush()
+                {
+                    auto end = queue_.enqueue_position();
+                    if (end > 0)
+                    {
+                        wait_written(end - 1);
+                    }
+                }
+
+                // writes the remaining records, later records are written directly
+                void stop()
+                {
+                    // first, so no push from now on enqueues a record nobody writes
+                    stopped_.store(true);
+
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        stop_ = true;
+                    }
+                    wakeup_.notify_one();
+
+                    std::lock_guard<std::mutex> lock(join_mutex_);
+                    if (thread_.joinable())
+                    {
+                        thread_.join();
+                    }
+
+                    // no handler is registered from within the exit handlers, see write()
+                    exit_handler_registered_ = true;
+
+                    // pushed after the thread saw the queue empty for the last time
+                    while (pop_current())
+                    {
+                        write(current_);
+                    }
+                }
+
+                std::uint64_t dropped() const
+                {
+                    return dropped_.load(std::memory_order_relaxed);
+                }
+
+                std::size_t queue_depth() const
+                {
+                    // the dequeue position first, so the enqueue position cannot be behind it
+                    auto begin = queue_.dequeue_position();
+                    return queue_.enqueue_position() - begin;
+                }
+
+            private:
+                void write_directly(severity_level sev, lang::string_ref formatted_record)
+                {
+                    std::lock_guard<std::mutex> lock(join_mutex_);
+                    sink_.sink(sev, formatted_record);
+                }
+
+                void wake()
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    wakeup_.notify_one();
+                }
+
+                // blocks until the record enqueued at position left the queue and, if the writer
+                // took it, is written
+                void wait_written(std::size_t position)
+                {
+                    while (queue_.dequeue_position() <= position)
+                    {
+                        if (stopped_.load())
+                        {
+                            return;
+                        }
+
+                        wake();
+                        std::this_thread::yield();
+                    }
+
+                    auto seen = completed_.load();
+                    if (busy_.load())
+                    {
+                        while (completed_.load() == seen)
+                        {
+                            std::this_thread::yield();
+                        }
+                    }
+                }
+
+                // Swapping keeps the allocated strings circulating and releases the slot before the
+                // possibly slow write.
+                bool pop_current()
+                {
+                    return queue_.try_pop([this](entry& e) {
+                        current_.severity.store(e.severity.load(std::memory_order_relaxed),
+                                                std::memory_order_relaxed);
+                        current_.record.swap(e.record);
+                    });
+                }
+
+                void run()
+                {
+                    while (true)
+                    {
+                        busy_.store(true);
+                        bool popped = pop_current();
+                        if (popped)
+                        {
+                            write(current_);
+                        }
+                        completed_.fetch_add(1);
+                        busy_.store(false);
+
+                        if (popped)
+                        {
+                            continue;
+                        }
+
+                        std::unique_lock<std::mutex> lock(mutex_);
+                        sleeping_.store(true, std::memory_order_relaxed);
+                        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                        if (queue_.empty())
+                        {
+                            if (stop_)
+                            {
+                                break;
+                            }
+
+                            wakeup_.wait_for(lock, std::chrono::milliseconds(100));
+                        }
+
+                        sleeping_.store(false, std::memory_order_relaxed);
+                    }
+                }
+
+                void write(entry& e)
+                {
+                    try
+                    {
+                        sink_.sink(e.severity.load(std::memory_order_relaxed), e.record);
+                    }
+                    catch (...)
+                    {
+                        // there is no one to report this to from here
+                    }
+
+                    if (!exit_handler_registered_)
+                    {
+                        // The wrapped sink may have created static objects on its first call.
+                        // Registering the handler again now makes it run before their
+                        // destructors, so the remaining records can still be written at exit.
+                        exit_handler_registered_ = true;
+                        std::atexit(&async::stop_at_exit);
+                    }
+                }
+
+                Sink sink_;
+                detail::bounded_queue<entry> queue_;
+                entry current_;
+
+                std::mutex mutex_;
+                std::condition_variable wakeup_;
+                bool stop_ = false;
+                std::atomic<bool> sleeping_{ false };
+
+                std::atomic<bool> busy_{ false };
+                std::atomic<std::uint64_t> completed_{ 0 };
+                std::atomic<std::uint64_t> dropped_{ 0 };
+                std::atomic<bool> stopped_{ false };
+                bool exit_handler_registered_ = false;
+
+                std::mutex join_mutex_;
+                std::thread thread_;
+            };
+
+            static worker& get_worker()
+            {
+                // never destroyed, so records of destructors of other statics find it stopped.
+                // Not allocated with new, which ignores the alignment of the queue before C++17.
+                static typename std::aligned_storage<sizeof(worker), alignof(worker)>::type
+                    storage_;
+                static worker* worker_ = new (&storage_) worker();
+                return *worker_;
+            }
+
+            static void stop_at_exit()
+            {
+                get_worker().stop();
+            }
+
+            // e.g. "dropped 0 queue_depth 12"
+            static void write(std::ostream& s)
+            {
+                s << "dropped " << dropped() << " queue_depth " << queue_depth();
+            }
+
+        public:
+            async()
+            {
+                static bool registered = []() {
+                    detail::metrics_registry::instance().add(config().name, &write);
+                    return true;
+                }();
+                (void)registered;
+            }
+
+            static async_config& config()
+            {
+                static async_config config_;
+                return config_;
+            }
+
+            void sink(severity_level sev, lang::string_ref formatted_record)
+            {
+                get_worker().push(sev, formatted_record);
+            }
+
+            /**
+             * \brief blocks until every record enqueued before this call is written
+             */
+            static void flush()
+            {
+                get_worker().flush();
+            }
+
+            /**
+             * \brief the number of records dropped because the queue was full
+             */
+            static std::uint64_t dropped()
+            {
+                return get_worker().dropped();
+            }
+
+            /**
+             * \brief the number of records in the queue, i.e. not written yet
+             */
+            static std::size_t queue_depth()
+            {
+                return get_worker().queue_depth();
+            }
+        };
+    } // namespace sink
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_SINK_ASYNC_HPP
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_SINK_BINARY_TO_TEXT_HPP
+#define INCLUDE_NITRO_LOG_SINK_BINARY_TO_TEXT_HPP
+
+#include <nitro/log/detail/stream_buffer.hpp>
+#include <nitro/log/formatter/binary_decoder.hpp>
+#include <nitro/log/severity.hpp>
+
+#include <nitro/lang/string_ref.hpp>
+
+namespace nitro
+{
+namespace log
+{
+    namespace sink
+    {
+        /**
+         * \brief Sink adapter, which converts records of formatter::binary_formatter to text
+         *
+         * Wrapped into sink::async, the records are converted on the background thread instead
+         * of the thread, which logs them.
+         *
+         * \tparam Sink the sink that writes the text
+         */
+        template <typename Sink>
+        class binary_to_text
+        {
+        public:
+            void sink(severity_level sev, lang::string_ref formatted_record)
+            {
+                auto lease = detail::stream_lease::acquire();
+
+                decoder_.decode(formatted_record.get(), formatted_record.size(), lease.stream());
+
+                if (lease.buffer().size() > 0)
+                {
+                    sink_.sink(sev, lease.buffer().str());
+                }
+            }
+
+        private:
+            formatter::binary_decoder decoder_{ true };
+            Sink sink_;
+        };
+    } // namespace sink
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_SINK_BINARY_TO_TEXT_HPP
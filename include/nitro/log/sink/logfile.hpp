@@ -30,6 +30,8 @@
 
 #include <nitro/log/severity.hpp>
 
+#include <nitro/lang/string_ref.hpp>
+
 #include <fstream>
 #include <string>
 
@@ -55,7 +57,7 @@ namespace log
                 return of;
             }
 
-            void sink(severity_level, const std::string& formatted_record)
+            void sink(severity_level, lang::string_ref formatted_record)
             {
                 log_stream() << formatted_record << std::flush;
             }
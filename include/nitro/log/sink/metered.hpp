@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_SINK_METERED_HPP
+#define INCLUDE_NITRO_LOG_SINK_METERED_HPP
+
+#include <nitro/log/detail/sharded_counters.hpp>
+#include <nitro/log/detail/sink_record.hpp>
+#include <nitro/log/metrics.hpp>
+#include <nitro/log/severity.hpp>
+
+#include <nitro/lang/string_ref.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace nitro
+{
+namespace log
+{
+    namespace sink
+    {
+        struct metered_config
+        {
+            /// the name of the sink in write_metrics()
+            std::string name = "sink";
+        };
+
+        /**
+         * \brief Sink adapter, which counts the records and bytes written to Sink and records
+         *        how long Sink takes for them
+         *
+         * The counters and the latency_histogram are written by every thread on its own, see
+         * detail::sharded_counters, so they are only summed when read. For sinks, which hand the
+         * records to another thread like async, the latency is the time to hand them over. The
+         * configuration is read when the sink is constructed.
+         */
+        template <typename Sink>
+        class metered
+        {
+            static constexpr std::size_t records_index = 0;
+            static constexpr std::size_t bytes_index = 1;
+
+            using counters = detail::sharded_counters<metered, 2>;
+            using recorder = detail::latency_recorder<metered>;
+
+        public:
+            metered()
+            {
+                static bool registered = []() {
+                    detail::metrics_registry::instance().add(config().name, &write);
+                    return true;
+                }();
+                (void)registered;
+            }
+
+            static metered_config& config()
+            {
+                static metered_config config_;
+                return config_;
+            }
+
+            void sink(severity_level sev, lang::string_ref formatted_record)
+            {
+                auto start = std::chrono::steady_clock::now();
+                sink_.sink(sev, formatted_record);
+                count(formatted_record, start);
+            }
+
+            template <typename Record>
+            void sink(severity_level sev, lang::string_ref formatted_record, const Record& r)
+            {
+                auto start = std::chrono::steady_clock::now();
+                detail::sink_record(sink_, sev, formatted_record, r);
+                count(formatted_record, start);
+            }
+
+            /// the number of records written so far
+            static std::uint64_t records()
+            {
+                return counters::values()[records_index];
+            }
+
+            /// the number of bytes written so far
+            static std::uint64_t bytes()
+            {
+                return counters::values()[bytes_index];
+            }
+
+            /// the durations of all records written so far
+            static latency_histogram latency()
+            {
+                return recorder::histogram();
+            }
+
+        private:
+            static void count(lang::string_ref formatted_record,
+                              std::chrono::steady_clock::time_point start)
+            {
+                recorder::record(std::chrono::steady_clock::now() - start);
+
+                auto& shard = counters::local();
+                shard.add(records_index);
+                shard.add(bytes_index, formatted_record.size());
+            }
+
+            // e.g. "records 10 bytes 420 latency count 10 mean 130ns ..."
+            static void write(std::ostream& s)
+            {
+                auto values = counters::values();
+                s << "records " << values[records_index] << " bytes " << values[bytes_index]
+                  << " latency " << latency();
+            }
+
+            Sink sink_;
+        };
+    } // namespace sink
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_SINK_METERED_HPP
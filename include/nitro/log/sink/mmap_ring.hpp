@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_SINK_MMAP_RING_HPP
+#define INCLUDE_NITRO_LOG_SINK_MMAP_RING_HPP
+
+#include <nitro/log/detail/binary_format.hpp>
+#include <nitro/log/detail/mmap_ring_format.hpp>
+#include <nitro/log/severity.hpp>
+
+#include <nitro/except/raise.hpp>
+#include <nitro/lang/string_ref.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+extern "C"
+{
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+}
+
+namespace nitro
+{
+namespace log
+{
+    namespace sink
+    {
+        struct mmap_ring_config
+        {
+            /// the file backing the ring buffer, an existing ring of the same capacity is continued
+            std::string path = "log.ring";
+
+            /// size of the data area in bytes, rounded up to a multiple of 16, at least 4 KiB
+            std::size_t capacity = 16 << 20;
+        };
+
+        /**
+         * \brief Crash-persistent sink, which keeps the most recent records in a ring buffer
+         *
+         * The records are copied into a file mapped with MAP_SHARED, so writing a record is a
+         * memcpy and the kernel writes the pages back to the file, even if the process is killed
+         * by SIGKILL or crashes. Once the buffer is full, the oldest records are overwritten. Use
+         * mmap_ring_reader or the nitro-mmap-ring-dump tool to get the records out of the file.
+         *
+         * This is meant to always log at trace level next to the regular sinks, e.g.
+         * sink::sequence<sink::rotating_file<>, sink::mmap_ring<>> with a filter, which lets
+         * everything through, or even with several processes sharing one file. Records longer
+         * than the capacity are truncated. If writers lap a writer, which is still copying its
+         * record, that record is lost.
+         *
+         * The file is mapped when the first record is written and never unmapped, so records
+         * written by destructors of static objects are still kept. The sink is thread-safe.
+         *
+         * \tparam N distinguishes sinks writing to different files
+         */
+        template <unsigned N = 0>
+        class mmap_ring
+        {
+            class ring
+            {
+            public:
+                ring()
+                {
+                    const auto& conf = config();
+
+                    capacity_ = std::max<std::uint64_t>(conf.capacity, 4096);
+                    capacity_ = (capacity_ + detail::mmap_ring_alignment - 1) &
+                                ~static_cast<std::uint64_t>(detail::mmap_ring_alignment - 1);
+                    size_ = detail::mmap_ring_header_size + capacity_;
+
+                    int fd = ::open(conf.path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+                    if (fd == -1)
+                    {
+                        raise("Cannot open ring buffer file " + conf.path + ": " +
+                              std::strerror(errno));
+                    }
+
+                    bool continued = is_compatible(fd);
+                    if (!continued &&
+                        (::ftruncate(fd, 0) != 0 ||
+                         ::ftruncate(fd, static_cast<off_t>(size_)) != 0))
+                    {
+                        int error = errno;
+                        ::close(fd);
+                        raise("Cannot resize ring buffer file " + conf.path + ": " +
+                              std::strerror(error));
+                    }
+
+                    void* base =
+                        ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                    int error = errno;
+                    ::close(fd);
+
+                    if (base == MAP_FAILED)
+                    {
+                        raise("Cannot map ring buffer file " + conf.path + ": " +
+                              std::strerror(error));
+                    }
+
+                    base_ = static_cast<char*>(base);
+                    data_ = base_ + detail::mmap_ring_header_size;
+
+                    if (!continued)
+                    {
+                        std::memcpy(base_, detail::mmap_ring_magic(),
+                                    detail::mmap_ring_magic_size);
+                        detail::mmap_ring_store(base_ + detail::mmap_ring_version_offset,
+                                                detail::mmap_ring_version);
+                        detail::mmap_ring_store(base_ + detail::mmap_ring_header_size_offset,
+                                                static_cast<std::uint32_t>(
+                                                    detail::mmap_ring_header_size));
+                        detail::mmap_ring_store(base_ + detail::mmap_ring_capacity_offset,
+                                                capacity_);
+                    }
+
+                    // The position is not initialized through the atomic, as other processes may
+                    // already write to a continued file. A new file is zero-filled.
+                    static_assert(sizeof(std::atomic<std::uint64_t>) == sizeof(std::uint64_t),
+                                  "The write position must be a plain 64 bit integer in the file");
+                    write_position_ = reinterpret_cast<std::atomic<std::uint64_t>*>(
+                        base_ + detail::mmap_ring_position_offset);
+                }
+
+                void append(lang::string_ref formatted_record)
+                {
+                    const std::uint64_t length =
+                        std::min<std::uint64_t>(formatted_record.size(),
+                                                capacity_ - detail::mmap_ring_frame_header_size);
+                    const auto frame_size = detail::mmap_ring_frame_size(length);
+
+                    const auto position =
+                        write_position_->fetch_add(frame_size, std::memory_order_relaxed);
+
+                    // Twice per round, so the ring always keeps a complete dictionary of
+                    // formatter::binary_formatter, which was written after the records before it.
+                    const auto half = capacity_ / 2;
+                    if (position / half != (position + frame_size) / half)
+                    {
+                        detail::redefine_binary_dictionary();
+                    }
+
+                    char* frame = data_ + position % capacity_;
+
+                    // Clear the magic of a stale frame first and set it only after everything
+                    // else is written, so a partially written frame is never taken as valid.
+                    detail::mmap_ring_store<std::uint32_t>(frame, 0);
+                    std::atomic_thread_fence(std::memory_order_release);
+
+                    detail::mmap_ring_store(frame + 4, static_cast<std::uint32_t>(length));
+                    detail::mmap_ring_store(frame + 8, position);
+
+                    auto offset = (position + detail::mmap_ring_frame_header_size) % capacity_;
+                    auto first = std::min<std::uint64_t>(length, capacity_ - offset);
+                    std::memcpy(data_ + offset, formatted_record.get(), first);
+                    std::memcpy(data_, formatted_record.get() + first, length - first);
+
+                    std::atomic_thread_fence(std::memory_order_release);
+                    detail::mmap_ring_store(frame, detail::mmap_ring_frame_magic);
+                }
+
+                void sync()
+                {
+                    ::msync(base_, size_, MS_SYNC);
+                }
+
+            private:
+                bool is_compatible(int fd) const
+                {
+                    struct stat info;
+                    if (::fstat(fd, &info) != 0 ||
+                        static_cast<std::uint64_t>(info.st_size) != size_)
+                    {
+                        return false;
+                    }
+
+                    char header[detail::mmap_ring_header_size];
+                    if (::pread(fd, header, sizeof(header), 0) !=
+                        static_cast<ssize_t>(sizeof(header)))
+                    {
+                        return false;
+                    }
+
+                    return std::memcmp(header, detail::mmap_ring_magic(),
+                                       detail::mmap_ring_magic_size) == 0 &&
+                           detail::mmap_ring_load<std::uint32_t>(
+                               header + detail::mmap_ring_version_offset) ==
+                               detail::mmap_ring_version &&
+                           detail::mmap_ring_load<std::uint64_t>(
+                               header + detail::mmap_ring_capacity_offset) == capacity_;
+                }
+
+                std::uint64_t capacity_;
+                std::uint64_t size_;
+                char* base_;
+                char* data_;
+                std::atomic<std::uint64_t>* write_position_;
+            };
+
+            static ring& get_ring()
+            {
+                // never unmapped, see above
+                static ring* ring_ = new ring();
+                return *ring_;
+            }
+
+        public:
+            static mmap_ring_config& config()
+            {
+                static mmap_ring_config config_;
+                return config_;
+            }
+
+            void sink(severity_level, lang::string_ref formatted_record)
+            {
+                get_ring().append(formatted_record);
+            }
+
+            /**
+             * \brief writes the ring buffer to disk and waits for it
+             *
+             * This is not needed to survive a crash of the process, only a crash of the system.
+             */
+            static void sync()
+            {
+                get_ring().sync();
+            }
+        };
+    } // namespace sink
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_SINK_MMAP_RING_HPP
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_SINK_MMAP_RING_READER_HPP
+#define INCLUDE_NITRO_LOG_SINK_MMAP_RING_READER_HPP
+
+#include <nitro/log/detail/mmap_ring_format.hpp>
+
+#include <nitro/except/raise.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace nitro
+{
+namespace log
+{
+    namespace sink
+    {
+        /**
+         * \brief Reconstructs the records of a file written by sink::mmap_ring
+         *
+         * The file is read once on construction, so it can be the file of a crashed process, a
+         * copy of it, or the file of a process, which is still writing. In the latter case, the
+         * records written while the file was read may be missing or incomplete.
+         */
+        class mmap_ring_reader
+        {
+        public:
+            explicit mmap_ring_reader(const std::string& path)
+            {
+                std::ifstream file(path, std::ios::binary);
+                if (!file)
+                {
+                    raise("Cannot open ring buffer file ", path);
+                }
+
+                content_.assign(std::istreambuf_iterator<char>(file),
+                                std::istreambuf_iterator<char>());
+
+                if (content_.size() < detail::mmap_ring_header_size ||
+                    std::memcmp(content_.data(), detail::mmap_ring_magic(),
+                                detail::mmap_ring_magic_size) != 0)
+                {
+                    raise("Not a ring buffer file: ", path);
+                }
+
+                auto version = load<std::uint32_t>(detail::mmap_ring_version_offset);
+                if (version != detail::mmap_ring_version)
+                {
+                    raise("Unsupported version ", version, " of ring buffer file ", path);
+                }
+
+                header_size_ = load<std::uint32_t>(detail::mmap_ring_header_size_offset);
+                capacity_ = load<std::uint64_t>(detail::mmap_ring_capacity_offset);
+                write_position_ = load<std::uint64_t>(detail::mmap_ring_position_offset);
+
+                if (capacity_ == 0 || capacity_ % detail::mmap_ring_alignment != 0 ||
+                    header_size_ < detail::mmap_ring_header_size ||
+                    content_.size() < header_size_ + capacity_)
+                {
+                    raise("Corrupted or truncated ring buffer file ", path);
+                }
+            }
+
+            /// the size of the data area in bytes
+            std::uint64_t capacity() const
+            {
+                return capacity_;
+            }
+
+            /// the number of bytes ever written into the ring buffer
+            std::uint64_t write_position() const
+            {
+                return write_position_;
+            }
+
+            /// how often the writers wrapped around to the start of the data area
+            std::uint64_t wraps() const
+            {
+                return write_position_ / capacity_;
+            }
+
+            /**
+             * \brief calls f with every complete record still in the buffer, oldest first
+             *
+             * \param f callable taking a const std::string&
+             */
+            template <typename F>
+            void for_each(F&& f) const
+            {
+                const char* data = content_.data() + header_size_;
+                const auto end = write_position_;
+
+                // Frames from end - capacity on survived, but the one overlapping that position
+                // lost its header. So search for the first frame, which is valid.
+                auto position = end > capacity_ ? end - capacity_ : 0;
+
+                std::string record;
+                while (position + detail::mmap_ring_frame_header_size <= end)
+                {
+                    const char* frame = data + position % capacity_;
+
+                    auto length = detail::mmap_ring_load<std::uint32_t>(frame + 4);
+                    auto frame_size = detail::mmap_ring_frame_size(length);
+
+                    if (detail::mmap_ring_load<std::uint32_t>(frame) !=
+                            detail::mmap_ring_frame_magic ||
+                        detail::mmap_ring_load<std::uint64_t>(frame + 8) != position ||
+                        frame_size > capacity_ || position + frame_size > end)
+                    {
+                        position += detail::mmap_ring_alignment;
+                        continue;
+                    }
+
+                    auto offset = (position + detail::mmap_ring_frame_header_size) % capacity_;
+                    auto first = std::min<std::uint64_t>(length, capacity_ - offset);
+
+                    record.assign(data + offset, first);
+                    record.append(data, length - first);
+
+                    f(static_cast<const std::string&>(record));
+
+                    position += frame_size;
+                }
+            }
+
+            /**
+             * \brief all complete records still in the buffer, oldest first
+             */
+            std::vector<std::string> records() const
+            {
+                std::vector<std::string> result;
+                for_each([&result](const std::string& record) { result.push_back(record); });
+                return result;
+            }
+
+        private:
+            template <typename T>
+            T load(std::size_t offset) const
+            {
+                return detail::mmap_ring_load<T>(content_.data() + offset);
+            }
+
+            std::string content_;
+            std::uint32_t header_size_;
+            std::uint64_t capacity_;
+            std::uint64_t write_position_;
+        };
+    } // namespace sink
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_SINK_MMAP_RING_READER_HPP
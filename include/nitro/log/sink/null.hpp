@@ -31,6 +31,8 @@
 
 #include <nitro/log/severity.hpp>
 
+#include <nitro/lang/string_ref.hpp>
+
 #include <string>
 
 namespace nitro
@@ -43,7 +45,7 @@ namespace log
         class Null
         {
         public:
-            void sink(severity_level, const std::string&)
+            void sink(severity_level, lang::string_ref)
             {
             }
         };
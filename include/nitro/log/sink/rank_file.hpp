@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_SINK_RANK_FILE_HPP
+#define INCLUDE_NITRO_LOG_SINK_RANK_FILE_HPP
+
+#include <nitro/log/severity.hpp>
+#include <nitro/log/sink/rotating_file.hpp>
+
+#include <nitro/format/detail/iso8601.hpp>
+#include <nitro/lang/string_ref.hpp>
+
+#include <chrono>
+#include <string>
+#include <type_traits>
+
+extern "C"
+{
+#include <unistd.h>
+}
+
+namespace nitro
+{
+namespace log
+{
+    namespace detail
+    {
+        // prefers rank_attribute, as it is set explicitly, over mpi_rank_attribute
+        template <typename Record>
+        auto record_rank(const Record& r, int) -> decltype(r.rank())
+        {
+            return r.rank();
+        }
+
+        template <typename Record>
+        auto record_rank(const Record& r, long) -> decltype(r.mpi_rank())
+        {
+            return r.mpi_rank();
+        }
+
+        template <typename TimePoint>
+        std::chrono::system_clock::time_point to_system_time(const TimePoint& tp, std::true_type)
+        {
+            return std::chrono::time_point_cast<std::chrono::system_clock::duration>(tp);
+        }
+
+        template <typename TimePoint>
+        std::chrono::system_clock::time_point to_system_time(const TimePoint& tp, std::false_type)
+        {
+            using clock = typename TimePoint::clock;
+            return std::chrono::system_clock::now() +
+                   std::chrono::duration_cast<std::chrono::system_clock::duration>(tp -
+                                                                                   clock::now());
+        }
+    } // namespace detail
+
+    namespace sink
+    {
+        struct rank_file_config
+        {
+            /// the file of every rank, "{rank}" is replaced by the rank of the process
+            std::string path = "log.{rank}.txt";
+        };
+
+        /**
+         * \brief Sink, which writes the records of every MPI rank into a file of its own
+         *
+         * Instead of sending all records to one rank, every rank writes its own file, which
+         * nitro-rank-merge, or rank_file_merge, combine into one time-ordered view afterwards.
+         * Every line is prefixed with the timestamp of its record in UTC with nanoseconds and
+         * the rank, e.g. "2026-10-18T08:15:42.123456789Z 17 ", so the formatter does not need
+         * to write either.
+         *
+         * The rank comes from the rank_attribute or mpi_rank_attribute of the record, so this
+         * works with rank_attribute::initialize() alone. The file is named by the rank of the
+         * first record, a process without a rank yet gets "pid<pid>" instead. Records of
+         * timestamp clocks other than the system clock are converted to it.
+         *
+         * The records are written by rotating_file<N>, so they are buffered and written in large
+         * batches. Its config() controls the buffering, its path is set by this sink, so do not
+         * use rotating_file<N> elsewhere.
+         *
+         * \tparam N distinguishes sinks writing to different files
+         */
+        template <unsigned N = 0>
+        class rank_file
+        {
+        public:
+            static rank_file_config& config()
+            {
+                static rank_file_config config_;
+                return config_;
+            }
+
+            template <typename Record>
+            void sink(severity_level sev, lang::string_ref formatted_record, const Record& r)
+            {
+                const int rank = detail::record_rank(r, 0);
+
+                static const bool configured = configure(rank);
+                (void)configured;
+
+                static thread_local std::string line;
+                line.clear();
+
+                char prefix[nitro::detail::iso8601_max_size + 1];
+                auto size = nitro::detail::format_iso8601(
+                    prefix,
+                    detail::to_system_time(
+                        r.timestamp(),
+                        nitro::detail::is_system_time_point<
+                            std::decay_t<decltype(r.timestamp())>>()),
+                    9);
+                prefix[size++] = ' ';
+                line.append(prefix, size);
+                line.append(std::to_string(rank));
+                line.push_back(' ');
+                line.append(formatted_record.get(), formatted_record.size());
+
+                if (line.back() != '\n')
+                {
+                    line.push_back('\n');
+                }
+
+                rotating_file<N>().sink(sev, line);
+            }
+
+            /**
+             * \brief writes all buffered records to the file
+             */
+            static void flush()
+            {
+                rotating_file<N>::flush();
+            }
+
+            /**
+             * \brief the file for the given rank
+             */
+            static std::string path(int rank)
+            {
+                auto path = config().path;
+                const auto name =
+                    rank >= 0 ? std::to_string(rank) : "pid" + std::to_string(::getpid());
+
+                auto pos = path.find("{rank}");
+                if (pos != std::string::npos)
+                {
+                    path.replace(pos, 6, name);
+                }
+                return path;
+            }
+
+        private:
+            static bool configure(int rank)
+            {
+                rotating_file<N>::config().path = path(rank);
+                return true;
+            }
+        };
+    } // namespace sink
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_SINK_RANK_FILE_HPP
@@ -0,0 +1,363 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_SINK_RANK_FILE_MERGE_HPP
+#define INCLUDE_NITRO_LOG_SINK_RANK_FILE_MERGE_HPP
+
+#include <nitro/except/raise.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <queue>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace nitro
+{
+namespace log
+{
+    namespace sink
+    {
+        /**
+         * \brief Merges the files written by sink::rank_file into one time-ordered view
+         *
+         * Every record is written as "[<rank>] <timestamp> <record>". The files are read at the
+         * same time and merged as they are read, so the memory needed does not depend on their
+         * size, but every file is open at once.
+         *
+         * With collapse(), records with the same text of different ranks within a time window are
+         * written only once, with all their ranks, e.g. "[0-511,513-1023] <timestamp> <record>".
+         * The timestamp is the one of the earliest of these records.
+         */
+        class rank_file_merge
+        {
+            struct entry
+            {
+                std::int64_t time;
+                std::string timestamp;
+                int rank;
+                std::string text;
+            };
+
+            // reads the records of one file, a record spans all lines until the next prefix
+            class cursor
+            {
+            public:
+                explicit cursor(const std::string& path) : file_(path)
+                {
+                    if (!file_)
+                    {
+                        raise("Cannot open rank file ", path);
+                    }
+
+                    while (std::getline(file_, pending_))
+                    {
+                        if (parse(pending_, current_))
+                        {
+                            has_pending_ = true;
+                            break;
+                        }
+                    }
+                }
+
+                // takes the next record into current()
+                bool next()
+                {
+                    if (!has_pending_)
+                    {
+                        return false;
+                    }
+
+                    parse(pending_, current_);
+                    current_.text.push_back('\n');
+                    has_pending_ = false;
+
+                    entry ignored;
+                    while (std::getline(file_, pending_))
+                    {
+                        if (parse(pending_, ignored))
+                        {
+                            has_pending_ = true;
+                            break;
+                        }
+
+                        current_.text.append(pending_);
+                        current_.text.push_back('\n');
+                    }
+
+                    return true;
+                }
+
+                entry& current()
+                {
+                    return current_;
+                }
+
+            private:
+                std::ifstream file_;
+                std::string pending_;
+                bool has_pending_ = false;
+                entry current_;
+            };
+
+            // records with the same text, which are written as one
+            struct group
+            {
+                entry first;
+                std::set<int> ranks;
+                bool open;
+            };
+
+        public:
+            explicit rank_file_merge(const std::vector<std::string>& paths)
+            {
+                for (const auto& path : paths)
+                {
+                    cursors_.emplace_back(new cursor(path));
+                }
+            }
+
+            /**
+             * \brief write records with the same text of different ranks only once
+             *
+             * \param window records are only collapsed with records at most this much earlier
+             */
+            void collapse(std::chrono::nanoseconds window = std::chrono::seconds(1))
+            {
+                collapse_ = true;
+                window_ = window.count();
+            }
+
+            /**
+             * \brief writes the merged records
+             */
+            void write(std::ostream& out)
+            {
+                // the cursor with the earliest record first, ties in the order of the files
+                using head = std::pair<std::int64_t, std::size_t>;
+                std::priority_queue<head, std::vector<head>, std::greater<head>> heads;
+
+                for (std::size_t i = 0; i < cursors_.size(); ++i)
+                {
+                    if (cursors_[i]->next())
+                    {
+                        heads.emplace(cursors_[i]->current().time, i);
+                    }
+                }
+
+                while (!heads.empty())
+                {
+                    auto i = heads.top().second;
+                    heads.pop();
+
+                    auto& e = cursors_[i]->current();
+                    if (collapse_)
+                    {
+                        add(e, out);
+                    }
+                    else
+                    {
+                        out << '[' << e.rank << "] " << e.timestamp << ' ' << e.text;
+                    }
+
+                    if (cursors_[i]->next())
+                    {
+                        heads.emplace(cursors_[i]->current().time, i);
+                    }
+                }
+
+                while (!groups_.empty())
+                {
+                    write_first_group(out);
+                }
+            }
+
+            /**
+             * \brief the ranks as a list of ranges, e.g. "0-3,5"
+             */
+            static std::string format_ranks(const std::set<int>& ranks)
+            {
+                std::string result;
+
+                for (auto it = ranks.begin(); it != ranks.end();)
+                {
+                    auto first = *it;
+                    auto last = first;
+                    for (++it; it != ranks.end() && *it == last + 1; ++it)
+                    {
+                        ++last;
+                    }
+
+                    if (!result.empty())
+                    {
+                        result.push_back(',');
+                    }
+                    result += std::to_string(first);
+                    if (last != first)
+                    {
+                        result += "-" + std::to_string(last);
+                    }
+                }
+
+                return result;
+            }
+
+        private:
+            void add(entry& e, std::ostream& out)
+            {
+                while (!groups_.empty() && e.time - groups_.front().first.time > window_)
+                {
+                    write_first_group(out);
+                }
+
+                auto it = open_.find(e.text);
+                if (it != open_.end())
+                {
+                    auto& g = groups_[it->second - written_];
+                    if (g.ranks.insert(e.rank).second)
+                    {
+                        return;
+                    }
+
+                    // the rank wrote the same text again, which starts a new group
+                    g.open = false;
+                    open_.erase(it);
+                }
+
+                open_.emplace(e.text, written_ + groups_.size());
+                groups_.push_back(group{ e, { e.rank }, true });
+            }
+
+            void write_first_group(std::ostream& out)
+            {
+                auto& g = groups_.front();
+                if (g.open)
+                {
+                    open_.erase(g.first.text);
+                }
+
+                out << '[' << format_ranks(g.ranks) << "] " << g.first.timestamp << ' '
+                    << g.first.text;
+
+                groups_.pop_front();
+                ++written_;
+            }
+
+            // parses "2026-10-18T08:15:42.123456789Z 17 text" into e
+            static bool parse(const std::string& line, entry& e)
+            {
+                static const char pattern[] = "dddd-dd-ddTdd:dd:dd.dddddddddZ ";
+                constexpr std::size_t prefix_size = sizeof(pattern) - 1;
+
+                if (line.size() < prefix_size + 2)
+                {
+                    return false;
+                }
+
+                for (std::size_t i = 0; i < prefix_size; ++i)
+                {
+                    if (pattern[i] == 'd' ? line[i] < '0' || line[i] > '9' : line[i] != pattern[i])
+                    {
+                        return false;
+                    }
+                }
+
+                auto pos = prefix_size;
+                bool negative = line[pos] == '-';
+                if (negative)
+                {
+                    ++pos;
+                }
+
+                const auto digits = pos;
+                long rank = 0;
+                for (; pos < line.size() && line[pos] >= '0' && line[pos] <= '9'; ++pos)
+                {
+                    rank = rank * 10 + (line[pos] - '0');
+                }
+
+                if (pos == digits || pos >= line.size() || line[pos] != ' ')
+                {
+                    return false;
+                }
+
+                auto number = [&line](std::size_t offset, std::size_t size) {
+                    std::int64_t value = 0;
+                    for (std::size_t i = offset; i < offset + size; ++i)
+                    {
+                        value = value * 10 + (line[i] - '0');
+                    }
+                    return value;
+                };
+
+                e.time = (days_from_civil(number(0, 4), number(5, 2), number(8, 2)) * 86400 +
+                          number(11, 2) * 3600 + number(14, 2) * 60 + number(17, 2)) *
+                             1000000000 +
+                         number(20, 9);
+                e.timestamp.assign(line, 0, prefix_size - 1);
+                e.rank = static_cast<int>(negative ? -rank : rank);
+                e.text.assign(line, pos + 1, std::string::npos);
+
+                return true;
+            }
+
+            // days since 1970-01-01 of a date in the proleptic Gregorian calendar
+            static std::int64_t days_from_civil(std::int64_t year, std::int64_t month,
+                                                std::int64_t day)
+            {
+                year -= month <= 2;
+                const auto era = (year >= 0 ? year : year - 399) / 400;
+                const auto year_of_era = year - era * 400;
+                const auto day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+                const auto day_of_era =
+                    year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+                return era * 146097 + day_of_era - 719468;
+            }
+
+            std::vector<std::unique_ptr<cursor>> cursors_;
+
+            bool collapse_ = false;
+            std::int64_t window_ = 0;
+            std::deque<group> groups_;
+            std::size_t written_ = 0;
+            // the index of the open group of every text, counted from the first group ever
+            std::unordered_map<std::string, std::size_t> open_;
+        };
+    } // namespace sink
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_SINK_RANK_FILE_MERGE_HPP
@@ -0,0 +1,549 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_SINK_ROTATING_FILE_HPP
+#define INCLUDE_NITRO_LOG_SINK_ROTATING_FILE_HPP
+
+#include <nitro/log/detail/binary_format.hpp>
+#include <nitro/log/detail/emergency_writers.hpp>
+#include <nitro/log/severity.hpp>
+
+#include <nitro/except/raise.hpp>
+#include <nitro/format/detail/iso8601.hpp>
+#include <nitro/lang/string_ref.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+extern "C"
+{
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+    extern char** environ;
+}
+
+namespace nitro
+{
+namespace log
+{
+    namespace sink
+    {
+        struct rotating_file_config
+        {
+            /// the file records are appended to, rotated segments get a timestamp appended
+            std::string path = "log.txt";
+
+            /// records are collected in a buffer of this size and written with one write(2),
+            /// larger records are written on their own
+            std::size_t buffer_size = 1 << 20;
+
+            /// how often a background thread writes the buffer, zero disables the thread
+            std::chrono::milliseconds flush_interval{ 1000 };
+
+            /// records with at least this severity are written before sink() returns
+            severity_level flush_severity = severity_level::error;
+
+            /// rotate before the file would grow beyond this size, zero disables it
+            std::size_t max_file_size = 0;
+
+            /// rotate files older than this, zero disables it
+            std::chrono::seconds max_file_age{ 0 };
+
+            /// command run on every rotated segment, whose path is appended, e.g. { "gzip" }
+            std::vector<std::string> compress_command;
+        };
+
+        /**
+         * \brief High-throughput file sink with rotation
+         *
+         * Records are appended to a userspace buffer, which is written with a single write(2)
+         * per batch: when it is full, when a record with config().flush_severity arrives, by a
+         * background thread every config().flush_interval, on flush() and at exit. Records
+         * logged later, e.g. by destructors of static objects, are written right away.
+         *
+         * If the file would exceed config().max_file_size or is older than
+         * config().max_file_age, it is renamed to "<path>.<UTC timestamp>" and a new file is
+         * started. Rotated segments can be compressed in the background by a command like gzip.
+         * Finished commands are waited for on the next rotation and by the background thread.
+         *
+         * If the process crashes, the buffer is written by the handler of install_crash_handler().
+         * It does not wait for other threads, so if one of them is writing to the sink at that
+         * moment, records may be written twice or torn.
+         *
+         * The configuration is read when the first record is written. The sink is thread-safe.
+         *
+         * \tparam N distinguishes sinks writing to different files
+         */
+        template <unsigned N = 0>
+        class rotating_file
+        {
+            class writer
+            {
+            public:
+                writer()
+                : config_(config()), buffers_{ buffer(config_.buffer_size),
+                                               buffer(config_.buffer_size) },
+                  active_(&buffers_[0])
+                {
+                    open();
+
+                    if (config_.flush_interval.count() > 0)
+                    {
+                        thread_ = std::thread([this]() { run(); });
+                    }
+
+                    detail::emergency_writers::add(&emergency_write, this);
+                    std::atexit(&rotating_file::stop_at_exit);
+                }
+
+                // writes the remaining records, later records are written directly
+                void stop()
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(thread_mutex_);
+                        stop_ = true;
+                    }
+                    wakeup_.notify_one();
+
+                    if (thread_.joinable())
+                    {
+                        thread_.join();
+                    }
+
+                    // before the flush, so records appended after it see it, see append()
+                    stopped_.store(true);
+                    flush();
+                    reap();
+                }
+
+                void append(severity_level sev, lang::string_ref formatted_record)
+                {
+                    const auto size = formatted_record.size();
+                    if (size > config_.buffer_size)
+                    {
+                        std::lock_guard<std::mutex> file_lock(file_mutex_);
+                        flush_locked();
+                        write_batch(formatted_record.get(), size);
+                        return;
+                    }
+
+                    bool flush_now;
+                    while (true)
+                    {
+                        {
+                            std::lock_guard<std::mutex> lock(buffer_mutex_);
+                            auto& b = *active_.load(std::memory_order_relaxed);
+                            auto used = b.size.load(std::memory_order_relaxed);
+
+                            if (used + size <= config_.buffer_size)
+                            {
+                                std::memcpy(b.data.get() + used, formatted_record.get(), size);
+                                // publishes the record to the crash handler
+                                b.size.store(used + size, std::memory_order_release);
+
+                                flush_now = used + size == config_.buffer_size ||
+                                            sev >= config_.flush_severity || stopped_.load();
+                                break;
+                            }
+                        }
+
+                        flush();
+                    }
+
+                    if (flush_now)
+                    {
+                        flush();
+                    }
+                }
+
+                void flush()
+                {
+                    std::lock_guard<std::mutex> file_lock(file_mutex_);
+                    flush_locked();
+                }
+
+                void rotate_now()
+                {
+                    flush();
+
+                    std::lock_guard<std::mutex> file_lock(file_mutex_);
+                    rotate();
+                }
+
+            private:
+                // The buffers never grow, so the crash handler can read them while other threads
+                // append. Only the committed size is read, records still being copied are left
+                // out.
+                struct buffer
+                {
+                    explicit buffer(std::size_t capacity) : data(new char[capacity])
+                    {
+                    }
+
+                    buffer(buffer&& other)
+                    : data(std::move(other.data)), size(other.size.load(std::memory_order_relaxed))
+                    {
+                    }
+
+                    std::unique_ptr<char[]> data;
+                    std::atomic<std::size_t> size{ 0 };
+                };
+
+                // requires file_mutex_
+                void flush_locked()
+                {
+                    buffer* writing;
+
+                    {
+                        std::lock_guard<std::mutex> lock(buffer_mutex_);
+                        writing = active_.load(std::memory_order_relaxed);
+                        if (writing->size.load(std::memory_order_relaxed) == 0)
+                        {
+                            return;
+                        }
+
+                        // the other buffer was written by the last flush and is empty
+                        active_.store(other(writing), std::memory_order_release);
+                    }
+
+                    write_batch(writing->data.get(), writing->size.load(std::memory_order_relaxed));
+                    writing->size.store(0, std::memory_order_release);
+                }
+
+                // requires file_mutex_
+                void write_batch(const char* data, std::size_t size)
+                {
+                    if (needs_rotation(size))
+                    {
+                        rotate();
+                    }
+
+                    write_all(data, size);
+                }
+
+                buffer* other(buffer* b)
+                {
+                    return b == &buffers_[0] ? &buffers_[1] : &buffers_[0];
+                }
+
+                /*
+                 * Called by the crash handler, so it takes no locks and only calls write(2). It
+                 * races with the threads, which still log or flush. The buffer, which is being
+                 * written to the file, may be written again, and a buffer, which was just written
+                 * and is reused, may be written with records of the new batch in it.
+                 */
+                static void emergency_write(void* context, const char* final_record,
+                                            std::size_t size)
+                {
+                    auto& self = *static_cast<writer*>(context);
+                    const int fd = self.fd_.load(std::memory_order_relaxed);
+
+                    // the older records first
+                    auto active = self.active_.load(std::memory_order_acquire);
+                    for (auto b : { self.other(active), active })
+                    {
+                        write_fd(fd, b->data.get(), b->size.load(std::memory_order_acquire));
+                    }
+                    write_fd(fd, final_record, size);
+                }
+
+                static void write_fd(int fd, const char* data, std::size_t size)
+                {
+                    while (size > 0 && fd != -1)
+                    {
+                        auto written = ::write(fd, data, size);
+                        if (written < 0)
+                        {
+                            if (errno == EINTR)
+                            {
+                                continue;
+                            }
+                            return;
+                        }
+
+                        data += written;
+                        size -= static_cast<std::size_t>(written);
+                    }
+                }
+
+                void open()
+                {
+                    fd_ = ::open(config_.path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC,
+                                 0644);
+
+                    if (fd_ == -1)
+                    {
+                        raise("Cannot open log file " + config_.path + ": " +
+                              std::strerror(errno));
+                    }
+
+                    struct stat info;
+                    file_size_ = ::fstat(fd_, &info) == 0 ? static_cast<std::size_t>(info.st_size)
+                                                          : 0;
+                    opened_ = std::chrono::steady_clock::now();
+                }
+
+                bool needs_rotation(std::size_t batch_size) const
+                {
+                    if (fd_ == -1 || file_size_ == 0)
+                    {
+                        return false;
+                    }
+
+                    if (config_.max_file_size > 0 &&
+                        file_size_ + batch_size > config_.max_file_size)
+                    {
+                        return true;
+                    }
+
+                    return config_.max_file_age.count() > 0 &&
+                           std::chrono::steady_clock::now() - opened_ >= config_.max_file_age;
+                }
+
+                // requires file_mutex_
+                void rotate()
+                {
+                    // hidden from the crash handler before it is closed
+                    auto fd = fd_.exchange(-1);
+                    if (fd != -1)
+                    {
+                        ::close(fd);
+                    }
+
+                    auto segment = segment_path();
+                    if (::rename(config_.path.c_str(), segment.c_str()) == 0)
+                    {
+                        compress(segment);
+                    }
+                    // also without the flush thread, which reaps them otherwise
+                    reap();
+
+                    // the records in the new file must not depend on definitions in the old one
+                    detail::redefine_binary_dictionary();
+
+                    try
+                    {
+                        open();
+                    }
+                    catch (...)
+                    {
+                        // records are dropped until the next rotation manages to open the file
+                        fd_ = -1;
+                    }
+                }
+
+                std::string segment_path() const
+                {
+                    char timestamp[nitro::detail::iso8601_max_size];
+                    auto seconds = std::chrono::duration_cast<std::chrono::seconds>(
+                                       std::chrono::system_clock::now().time_since_epoch())
+                                       .count();
+                    auto end =
+                        timestamp + nitro::detail::format_iso8601_seconds(timestamp, seconds);
+
+                    // "YYYYMMDDTHHMMSS", as colons are not allowed in file names everywhere
+                    end = std::remove_if(timestamp, end,
+                                         [](char c) { return c == '-' || c == ':'; });
+
+                    auto base = config_.path + "." + std::string(timestamp, end);
+                    auto path = base;
+
+                    struct stat info;
+                    for (int i = 1; ::stat(path.c_str(), &info) == 0; ++i)
+                    {
+                        path = base + "." + std::to_string(i);
+                    }
+
+                    return path;
+                }
+
+                void compress(const std::string& segment)
+                {
+                    if (config_.compress_command.empty())
+                    {
+                        return;
+                    }
+
+                    std::vector<std::string> args = config_.compress_command;
+                    args.push_back(segment);
+
+                    std::vector<char*> argv;
+                    for (auto& arg : args)
+                    {
+                        argv.push_back(&arg[0]);
+                    }
+                    argv.push_back(nullptr);
+
+                    pid_t pid;
+                    if (::posix_spawnp(&pid, argv[0], nullptr, nullptr, argv.data(), environ) ==
+                        0)
+                    {
+                        std::lock_guard<std::mutex> lock(children_mutex_);
+                        children_.push_back(pid);
+                    }
+                }
+
+                // collects finished compression processes, so they do not linger as zombies
+                void reap()
+                {
+                    std::lock_guard<std::mutex> lock(children_mutex_);
+
+                    auto finished = [](pid_t pid) {
+                        int status;
+                        return ::waitpid(pid, &status, WNOHANG) != 0;
+                    };
+
+                    children_.erase(std::remove_if(children_.begin(), children_.end(), finished),
+                                    children_.end());
+                }
+
+                // requires file_mutex_
+                void write_all(const char* data, std::size_t size)
+                {
+                    while (size > 0 && fd_ != -1)
+                    {
+                        auto written = ::write(fd_, data, size);
+                        if (written < 0)
+                        {
+                            if (errno == EINTR)
+                            {
+                                continue;
+                            }
+                            // there is no one to report this to, the batch is lost
+                            return;
+                        }
+
+                        data += written;
+                        size -= static_cast<std::size_t>(written);
+                        file_size_ += static_cast<std::size_t>(written);
+                    }
+                }
+
+                void run()
+                {
+                    std::unique_lock<std::mutex> lock(thread_mutex_);
+
+                    while (!stop_)
+                    {
+                        wakeup_.wait_for(lock, config_.flush_interval);
+                        if (stop_)
+                        {
+                            break;
+                        }
+
+                        lock.unlock();
+                        flush();
+                        reap();
+                        lock.lock();
+                    }
+                }
+
+                const rotating_file_config config_;
+
+                std::mutex buffer_mutex_;
+                buffer buffers_[2];
+                // the buffer records are appended to, the other one is written by flush()
+                std::atomic<buffer*> active_;
+
+                std::mutex file_mutex_;
+                // atomic, as the crash handler reads it
+                std::atomic<int> fd_{ -1 };
+                std::size_t file_size_ = 0;
+                std::chrono::steady_clock::time_point opened_;
+
+                std::mutex children_mutex_;
+                std::vector<pid_t> children_;
+
+                std::mutex thread_mutex_;
+                std::condition_variable wakeup_;
+                bool stop_ = false;
+                std::atomic<bool> stopped_{ false };
+                std::thread thread_;
+            };
+
+            static writer& get_writer()
+            {
+                // never destroyed, so records of destructors of other statics find it stopped
+                static writer* writer_ = new writer();
+                return *writer_;
+            }
+
+            static void stop_at_exit()
+            {
+                get_writer().stop();
+            }
+
+        public:
+            static rotating_file_config& config()
+            {
+                static rotating_file_config config_;
+                return config_;
+            }
+
+            void sink(severity_level sev, lang::string_ref formatted_record)
+            {
+                get_writer().append(sev, formatted_record);
+            }
+
+            /**
+             * \brief writes all buffered records to the file
+             */
+            static void flush()
+            {
+                get_writer().flush();
+            }
+
+            /**
+             * \brief writes all buffered records and starts a new file, e.g. on SIGHUP
+             */
+            static void rotate()
+            {
+                get_writer().rotate_now();
+            }
+        };
+    } // namespace sink
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_SINK_ROTATING_FILE_HPP
@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_SINK_ROUTER_HPP
+#define INCLUDE_NITRO_LOG_SINK_ROUTER_HPP
+
+#include <nitro/log/detail/formats_into_stream.hpp>
+#include <nitro/log/detail/sink_record.hpp>
+#include <nitro/log/detail/stream_buffer.hpp>
+#include <nitro/log/filter/null_filter.hpp>
+#include <nitro/log/severity.hpp>
+
+#include <nitro/lang/string_ref.hpp>
+
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace nitro
+{
+namespace log
+{
+    namespace detail
+    {
+        template <template <typename> class Formatter>
+        struct formatter_id
+        {
+        };
+
+        /// the index of the first of Routes, which has the formatter Id
+        template <typename Id, typename... Routes>
+        struct first_route_formatted_by;
+
+        template <typename Id>
+        struct first_route_formatted_by<Id> : std::integral_constant<std::size_t, 0>
+        {
+        };
+
+        template <typename Id, typename Route, typename... Routes>
+        struct first_route_formatted_by<Id, Route, Routes...>
+        : std::integral_constant<std::size_t,
+                                 std::is_same<Id, typename Route::formatter_id>::value
+                                     ? 0
+                                     : 1 + first_route_formatted_by<Id, Routes...>::value>
+        {
+        };
+    } // namespace detail
+
+    namespace sink
+    {
+        /**
+         * \brief Marks a route, which writes the record as formatted by the logger
+         *
+         * Only used as argument of route, never defined.
+         */
+        template <typename Record>
+        class formatted_by_logger;
+
+        /**
+         * \brief A destination of a router
+         *
+         * \tparam Sink the sink that writes the records of this route. Wrap a slow Sink into
+         *              sink::async, so it is written by a thread of its own and does not delay
+         *              the other routes, e.g. async<Sink, overflow_policy::drop_newest>.
+         * \tparam Filter decides which records take this route, e.g. severity_filter for a
+         *                threshold set at runtime, or static_severity<Severity>::type for a
+         *                fixed one. Only its filter(Record&) is used.
+         * \tparam Formatter formats the records for this route, formatted_by_logger uses the
+         *                   record as formatted by the logger
+         */
+        template <typename Sink, template <typename> class Filter = filter::null_filter,
+                  template <typename> class Formatter = formatted_by_logger>
+        struct route
+        {
+            using sink_type = Sink;
+
+            template <typename Record>
+            using filter_type = Filter<Record>;
+
+            template <typename Record>
+            using formatter_type = Formatter<Record>;
+
+            // formatter templates cannot be compared directly, so they are wrapped
+            using formatter_id = detail::formatter_id<Formatter>;
+        };
+
+        /**
+         * \brief Sink, which writes every record to the routes it is accepted by
+         *
+         * Unlike sequence, where every sink gets every record formatted the same way, every route
+         * has a filter and a formatter of its own, e.g. to write all records to a file, but
+         * only errors to syslog:
+         *
+         *     router<route<logfile_sink>,
+         *            route<syslog_sink, filter::static_severity<severity_level::error>::type,
+         *                  formatter::json_formatter>>
+         *
+         * The filter of the logger applies before all routes, so it has to accept every record
+         * any of the routes accepts.
+         *
+         * A record is formatted at most once per distinct formatter: the routes, which accept
+         * the record and share a formatter, are written one after another with the same
+         * formatted record. They are written in the order of their first route.
+         *
+         * A slow sink delays the routes written after it. Wrap it into sink::async to write it
+         * on a thread of its own.
+         */
+        template <typename... Routes>
+        class router
+        {
+            static_assert(sizeof...(Routes) > 0, "A router needs at least one route");
+
+            using routes = std::tuple<Routes...>;
+            using indices = std::index_sequence_for<Routes...>;
+
+            template <std::size_t I>
+            using route_t = std::tuple_element_t<I, routes>;
+
+            template <std::size_t I>
+            using formatter_id = typename route_t<I>::formatter_id;
+
+            // whether the routes I and J use the same formatter
+            template <std::size_t I, std::size_t J>
+            using same_formatter = std::is_same<formatter_id<I>, formatter_id<J>>;
+
+            // whether I is the first route with its formatter
+            template <std::size_t I>
+            using first_of_formatter = std::integral_constant<
+                bool, detail::first_route_formatted_by<formatter_id<I>, Routes...>::value == I>;
+
+            // whether route I writes the record as formatted by the logger
+            template <std::size_t I>
+            using uses_logger_format =
+                std::is_same<formatter_id<I>, detail::formatter_id<formatted_by_logger>>;
+
+            static std::tuple<typename Routes::sink_type...> sinks;
+
+        public:
+            template <typename Record>
+            void sink(severity_level sev, lang::string_ref formatted_record, const Record& r)
+            {
+                // filters and formatters take the record as Record&, but do not change it
+                auto& record = const_cast<Record&>(r);
+
+                bool accepted[sizeof...(Routes)];
+                filter(record, accepted, indices());
+
+                write(sev, formatted_record, record, accepted, indices());
+            }
+
+        private:
+            template <std::size_t I, typename Record>
+            static typename route_t<I>::template filter_type<Record>& route_filter()
+            {
+                static typename route_t<I>::template filter_type<Record> filter_;
+                return filter_;
+            }
+
+            template <std::size_t I, typename Record>
+            static typename route_t<I>::template formatter_type<Record>& route_formatter()
+            {
+                static typename route_t<I>::template formatter_type<Record> formatter_;
+                return formatter_;
+            }
+
+            template <typename Record, std::size_t... I>
+            static void filter(Record& record, bool* accepted, std::index_sequence<I...>)
+            {
+                int expand[] = { 0,
+                                 (accepted[I] = route_filter<I, Record>().filter(record), 0)... };
+                (void)expand;
+            }
+
+            template <typename Record, std::size_t... I>
+            static void write(severity_level sev, lang::string_ref formatted_record,
+                              Record& record, const bool* accepted, std::index_sequence<I...>)
+            {
+                int expand[] = { 0, (write_formatted_by<I>(sev, formatted_record, record,
+                                                           accepted, first_of_formatter<I>()),
+                                     0)... };
+                (void)expand;
+            }
+
+            // writes all routes, which share the formatter of route I
+            template <std::size_t I, typename Record>
+            static void write_formatted_by(severity_level sev, lang::string_ref formatted_record,
+                                           Record& record, const bool* accepted, std::true_type)
+            {
+                if (!any_accepted<I>(accepted, indices()))
+                {
+                    return;
+                }
+
+                format<I>(sev, formatted_record, record, accepted, uses_logger_format<I>());
+            }
+
+            template <std::size_t I, typename Record>
+            static void write_formatted_by(severity_level, lang::string_ref, Record&,
+                                           const bool*, std::false_type)
+            {
+            }
+
+            template <std::size_t I, std::size_t... J>
+            static bool any_accepted(const bool* accepted, std::index_sequence<J...>)
+            {
+                bool any = false;
+                int expand[] = { 0, (any = any || (same_formatter<I, J>::value && accepted[J]),
+                                     0)... };
+                (void)expand;
+                return any;
+            }
+
+            template <std::size_t I, typename Record>
+            static void format(severity_level sev, lang::string_ref formatted_record,
+                               Record& record, const bool* accepted, std::true_type)
+            {
+                write_routes<I>(sev, formatted_record, record, accepted, indices());
+            }
+
+            template <std::size_t I, typename Record>
+            static void format(severity_level sev, lang::string_ref, Record& record,
+                               const bool* accepted, std::false_type)
+            {
+                format_into<I>(sev, record, accepted,
+                               detail::formats_into_stream<
+                                   typename route_t<I>::template formatter_type<Record>, Record>());
+            }
+
+            template <std::size_t I, typename Record>
+            static void format_into(severity_level sev, Record& record, const bool* accepted,
+                                    std::true_type)
+            {
+                auto lease = detail::stream_lease::acquire();
+                route_formatter<I, Record>().format(record, lease.stream());
+                write_routes<I>(sev, lease.buffer().str(), record, accepted, indices());
+            }
+
+            template <std::size_t I, typename Record>
+            static void format_into(severity_level sev, Record& record, const bool* accepted,
+                                    std::false_type)
+            {
+                const std::string formatted = route_formatter<I, Record>().format(record);
+                write_routes<I>(sev, lang::string_ref(formatted), record, accepted, indices());
+            }
+
+            template <std::size_t I, typename Record, std::size_t... J>
+            static void write_routes(severity_level sev, lang::string_ref formatted,
+                                     Record& record, const bool* accepted,
+                                     std::index_sequence<J...>)
+            {
+                int expand[] = { 0, (write_route<J>(sev, formatted, record,
+                                                    same_formatter<I, J>::value && accepted[J]),
+                                     0)... };
+                (void)expand;
+            }
+
+            template <std::size_t J, typename Record>
+            static void write_route(severity_level sev, lang::string_ref formatted,
+                                    const Record& record, bool take)
+            {
+                if (take)
+                {
+                    detail::sink_record(std::get<J>(sinks), sev, formatted, record);
+                }
+            }
+        };
+
+        template <typename... Routes>
+        std::tuple<typename Routes::sink_type...> router<Routes...>::sinks;
+    } // namespace sink
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_SINK_ROUTER_HPP
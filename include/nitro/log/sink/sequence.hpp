@@ -28,8 +28,11 @@
 
 #pragma once
 
+#include <nitro/log/detail/sink_record.hpp>
 #include <nitro/log/severity.hpp>
 
+#include <nitro/lang/string_ref.hpp>
+
 #include <nitro/lang/tuple_foreach.hpp>
 
 namespace nitro
@@ -44,12 +47,20 @@ namespace log
             static std::tuple<Sinks...> sinks;
 
         public:
-            void sink(severity_level sev, const std::string& formatted_record)
+            void sink(severity_level sev, lang::string_ref formatted_record)
             {
                 lang::tuple_foreach(sinks, [&sev, &formatted_record](auto& sink) {
                     sink.sink(sev, formatted_record);
                 });
             }
+
+            template <typename Record>
+            void sink(severity_level sev, lang::string_ref formatted_record, const Record& r)
+            {
+                lang::tuple_foreach(sinks, [&sev, &formatted_record, &r](auto& sink) {
+                    detail::sink_record(sink, sev, formatted_record, r);
+                });
+            }
         };
 
         template <typename... Sinks>
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_SINK_SHM_RING_HPP
+#define INCLUDE_NITRO_LOG_SINK_SHM_RING_HPP
+
+#include <nitro/log/detail/shm_ring.hpp>
+#include <nitro/log/severity.hpp>
+
+#include <nitro/lang/string_ref.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+extern "C"
+{
+#include <unistd.h>
+}
+
+namespace nitro
+{
+namespace log
+{
+    namespace sink
+    {
+        struct shm_ring_config
+        {
+            /// the segment is named /<prefix>.<pid>.<N>, the collector looks for this prefix
+            std::string prefix = "nitro-log";
+
+            /// size of the ring in bytes, rounded up to a multiple of 32, at least 4 KiB
+            std::size_t capacity = 4 << 20;
+        };
+
+        /**
+         * \brief Sink, which hands records to a collector process through shared memory
+         *
+         * Every process writes its records into a POSIX shared memory segment of its own. The
+         * collector, i.e. shm_ring_collector or the nitro-shm-ring-collector tool, drains the
+         * segments of all processes on the host, merges the records by their timestamp and
+         * writes them to one file, so the logging processes never do any file I/O. Writing a
+         * record is a compare-and-swap and a memcpy.
+         *
+         * Records are never overwritten: if the collector does not keep up and the ring is full,
+         * the record is dropped and counted, see dropped(). Records longer than the capacity are
+         * truncated.
+         *
+         * The segment is created when the first record is written and never unmapped, so records
+         * written by destructors of static objects are still collected. The collector removes it
+         * after the process exited. A forked child keeps writing into the segment of its parent,
+         * which is safe, but the segment is removed once the parent exited.
+         *
+         * The sink is thread-safe. The record needs a timestamp attribute, which should use the
+         * system clock, so the records of different processes can be merged.
+         *
+         * \tparam N distinguishes sinks writing to different segments
+         */
+        template <unsigned N = 0>
+        class shm_ring
+        {
+            static detail::shm_ring& get_ring()
+            {
+                // never unmapped, see above
+                static detail::shm_ring* ring_ = new detail::shm_ring(
+                    detail::shm_ring::create("/" + config().prefix + "." +
+                                                 std::to_string(::getpid()) + "." +
+                                                 std::to_string(N),
+                                             config().capacity));
+                return *ring_;
+            }
+
+        public:
+            static shm_ring_config& config()
+            {
+                static shm_ring_config config_;
+                return config_;
+            }
+
+            template <typename Record>
+            void sink(severity_level sev, lang::string_ref formatted_record, const Record& r)
+            {
+                const auto timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                           r.timestamp().time_since_epoch())
+                                           .count();
+
+                get_ring().push(static_cast<std::int64_t>(timestamp), sev, formatted_record);
+            }
+
+            /**
+             * \brief the number of records dropped, because the ring was full
+             */
+            static std::uint64_t dropped()
+            {
+                return get_ring().dropped();
+            }
+
+            /**
+             * \brief the name of the shared memory segment
+             */
+            static const std::string& name()
+            {
+                return get_ring().name();
+            }
+        };
+    } // namespace sink
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_SINK_SHM_RING_HPP
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_SINK_SHM_RING_COLLECTOR_HPP
+#define INCLUDE_NITRO_LOG_SINK_SHM_RING_COLLECTOR_HPP
+
+#include <nitro/log/detail/shm_ring.hpp>
+#include <nitro/log/severity.hpp>
+
+#include <nitro/lang/string_ref.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <exception>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+extern "C"
+{
+#include <dirent.h>
+#include <signal.h>
+#include <sys/types.h>
+}
+
+namespace nitro
+{
+namespace log
+{
+    namespace sink
+    {
+        /**
+         * \brief Drains the shared memory segments written by sink::shm_ring
+         *
+         * Every call of collect() looks for new segments with the given prefix, takes all
+         * complete records out of every segment, and passes them in the order of their
+         * timestamps to a sink. Records collected at the same time are in timestamp order, but a
+         * record may be collected only after later records of other processes, if its process
+         * took a long time between taking the timestamp and writing the record.
+         *
+         * Segments of processes, which exited, are removed after they were drained.
+         *
+         * Only one collector may drain the segments of a prefix at a time.
+         */
+        class shm_ring_collector
+        {
+            struct entry
+            {
+                std::int64_t timestamp;
+                severity_level severity;
+                std::size_t offset;
+                std::size_t size;
+            };
+
+        public:
+            /**
+             * \param prefix the prefix of shm_ring_config
+             * \param directory where the system shows the shared memory segments
+             */
+            explicit shm_ring_collector(const std::string& prefix = "nitro-log",
+                                        const std::string& directory = "/dev/shm")
+            : prefix_(prefix + "."), directory_(directory)
+            {
+            }
+
+            /**
+             * \brief writes all records collected from the segments to sink
+             *
+             * Every record is passed as sink.sink(severity_level, lang::string_ref). Returns the
+             * number of records written.
+             */
+            template <typename Sink>
+            std::size_t collect(Sink& sink)
+            {
+                discover();
+
+                data_.clear();
+                entries_.clear();
+
+                for (auto it = rings_.begin(); it != rings_.end();)
+                {
+                    auto& ring = it->second;
+
+                    // checked first, so all records of an exited process are drained below
+                    bool exited = ::kill(ring.pid(), 0) == -1 && errno == ESRCH;
+
+                    ring.pop([this](std::int64_t timestamp, severity_level severity,
+                                    const char* first, std::size_t first_size,
+                                    const char* second, std::size_t second_size) {
+                        entries_.push_back(
+                            { timestamp, severity, data_.size(), first_size + second_size });
+                        data_.append(first, first_size);
+                        data_.append(second, second_size);
+                        // string_ref requires the '\0' after the record
+                        data_.push_back('\0');
+                    });
+
+                    if (exited)
+                    {
+                        dropped_ += ring.dropped();
+                        ring.unlink();
+                        it = rings_.erase(it);
+                    }
+                    else
+                    {
+                        ++it;
+                    }
+                }
+
+                // every segment is already ordered, which stable_sort makes use of
+                std::stable_sort(entries_.begin(), entries_.end(),
+                                 [](const entry& a, const entry& b) {
+                                     return a.timestamp < b.timestamp;
+                                 });
+
+                for (const auto& e : entries_)
+                {
+                    sink.sink(e.severity, lang::string_ref(data_.data() + e.offset, e.size));
+                }
+
+                return entries_.size();
+            }
+
+            /**
+             * \brief the number of segments being collected
+             */
+            std::size_t rings() const
+            {
+                return rings_.size();
+            }
+
+            /**
+             * \brief the number of records the processes dropped, because their ring was full
+             */
+            std::uint64_t dropped() const
+            {
+                auto dropped = dropped_;
+                for (const auto& ring : rings_)
+                {
+                    dropped += ring.second.dropped();
+                }
+                return dropped;
+            }
+
+        private:
+            void discover()
+            {
+                DIR* dir = ::opendir(directory_.c_str());
+                if (dir == nullptr)
+                {
+                    return;
+                }
+
+                while (auto entry = ::readdir(dir))
+                {
+                    std::string name = entry->d_name;
+                    if (name.compare(0, prefix_.size(), prefix_) != 0 ||
+                        rings_.count(name) != 0)
+                    {
+                        continue;
+                    }
+
+                    try
+                    {
+                        rings_.emplace(name, detail::shm_ring::open("/" + name));
+                    }
+                    catch (std::exception&)
+                    {
+                        // e.g. a segment still being created, it is tried again next time
+                    }
+                }
+
+                ::closedir(dir);
+            }
+
+            std::string prefix_;
+            std::string directory_;
+            std::map<std::string, detail::shm_ring> rings_;
+            std::uint64_t dropped_ = 0;
+
+            std::string data_;
+            std::vector<entry> entries_;
+        };
+    } // namespace sink
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_SINK_SHM_RING_COLLECTOR_HPP
@@ -31,6 +31,8 @@
 
 #include <nitro/log/severity.hpp>
 
+#include <nitro/lang/string_ref.hpp>
+
 #include <iostream>
 #include <mutex>
 #include <string>
@@ -50,7 +52,7 @@ namespace log
             }
 
         public:
-            void sink(severity_level, const std::string& formatted_record)
+            void sink(severity_level, lang::string_ref formatted_record)
             {
                 std::lock_guard<std::mutex> my_lock(std_err_mutex());
 
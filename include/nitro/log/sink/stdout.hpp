@@ -31,6 +31,8 @@
 
 #include <nitro/log/severity.hpp>
 
+#include <nitro/lang/string_ref.hpp>
+
 #include <iostream>
 #include <string>
 
@@ -44,7 +46,7 @@ namespace log
         class StdOut
         {
         public:
-            void sink(severity_level, const std::string& formatted_record)
+            void sink(severity_level, lang::string_ref formatted_record)
             {
                 std::cout << formatted_record << std::flush;
             }
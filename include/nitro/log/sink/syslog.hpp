@@ -30,6 +30,8 @@
 
 #include <nitro/log/severity.hpp>
 
+#include <nitro/lang/string_ref.hpp>
+
 #include <string>
 
 extern "C"
@@ -51,9 +53,9 @@ namespace log
                 openlog(nullptr, LOG_PID, LOG_USER);
             }
 
-            void sink(severity_level sev, const std::string& formatted_record)
+            void sink(severity_level sev, lang::string_ref formatted_record)
             {
-                syslog(get_syslog_priority(sev), "%s", formatted_record.c_str());
+                syslog(get_syslog_priority(sev), "%s", formatted_record.get());
             }
 
             ~Syslog()
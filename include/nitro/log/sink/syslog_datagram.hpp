@@ -0,0 +1,578 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_SINK_SYSLOG_DATAGRAM_HPP
+#define INCLUDE_NITRO_LOG_SINK_SYSLOG_DATAGRAM_HPP
+
+#include <nitro/format/detail/iso8601.hpp>
+#include <nitro/format/detail/kernels.hpp>
+#include <nitro/log/attribute/interned_tag.hpp>
+#include <nitro/log/attribute/tag.hpp>
+#include <nitro/log/detail/bounded_queue.hpp>
+#include <nitro/log/detail/has_attribute.hpp>
+#include <nitro/log/detail/process_identity.hpp>
+#include <nitro/log/severity.hpp>
+
+#include <nitro/lang/string_ref.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace nitro
+{
+namespace log
+{
+    namespace sink
+    {
+        struct syslog_datagram_config
+        {
+            /// the Unix datagram socket of the syslog daemon
+            std::string path = "/dev/log";
+
+            /// the facility of all messages, 1 are user-level messages
+            int facility = 1;
+
+            /// the APP-NAME of the messages, left out if empty
+            std::string app_name;
+
+            /// how many messages wait to be sent at most, further messages are dropped
+            std::size_t queue_size = 4096;
+
+            /// how many messages are sent with one system call at most
+            std::size_t batch_size = 64;
+
+            /// how long the daemon may not take messages, before the waiting ones are dropped
+            std::chrono::milliseconds send_timeout{ 1000 };
+        };
+
+        /**
+         * \brief Sends records as RFC 5424 messages to the local syslog daemon
+         *
+         * Unlike sink::Syslog, the calling thread does not call syslog(), which takes a lock and
+         * may block on the socket. It only writes the message, e.g.
+         * "<14>1 2026-10-18T08:15:42.123456Z host app 4711 net - message", into a slot of a
+         * bounded lock-free queue. A background thread sends the messages in batches to the
+         * non-blocking Unix datagram socket config().path.
+         *
+         * The sink never blocks the logging thread. If the queue is full, because the daemon is
+         * slow, messages are dropped. If the daemon does not take any message for
+         * config().send_timeout or cannot be reached, the waiting messages are dropped as well.
+         * Both are counted, see dropped().
+         *
+         * At exit, the thread sends the waiting messages and stops. Messages logged later, e.g.
+         * by destructors of static objects, are sent by the logging thread itself.
+         *
+         * The tag of the record, if any, is the MSGID, the timestamp is the one of the record,
+         * if it is of std::chrono::system_clock. The configuration is read when the first record
+         * is written.
+         */
+        class syslog_datagram
+        {
+            class worker
+            {
+            public:
+                worker()
+                : config_(config()), queue_(std::max<std::size_t>(config_.queue_size, 2)),
+                  batch_(std::max<std::size_t>(config_.batch_size, 1)),
+                  thread_([this]() { run(); })
+                {
+                    std::atexit(&syslog_datagram::stop_at_exit);
+                }
+
+                // sends the remaining messages, later messages are sent directly
+                void stop()
+                {
+                    // first, so no push from now on enqueues a message nobody sends
+                    stopped_.store(true);
+
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        stop_ = true;
+                    }
+                    wakeup_.notify_one();
+
+                    std::lock_guard<std::mutex> lock(join_mutex_);
+                    if (thread_.joinable())
+                    {
+                        thread_.join();
+                    }
+
+                    // pushed after the thread saw the queue empty for the last time
+                    while (auto count = pop_batch())
+                    {
+                        send(count);
+                        handled_.fetch_add(count);
+                    }
+                }
+
+                const syslog_datagram_config& configuration() const
+                {
+                    return config_;
+                }
+
+                void push(const std::string& message)
+                {
+                    if (stopped_.load())
+                    {
+                        // late messages, e.g. from destructors of other static objects
+                        std::lock_guard<std::mutex> lock(join_mutex_);
+                        batch_[0] = message;
+                        send(1);
+                        handled_.fetch_add(1);
+                        return;
+                    }
+
+                    if (!queue_.try_push([&message](std::string& slot) { slot = message; }))
+                    {
+                        dropped_.fetch_add(1, std::memory_order_relaxed);
+                        return;
+                    }
+
+                    // only the first thread, which sees the writer sleeping, wakes it
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    if (sleeping_.load(std::memory_order_relaxed) &&
+                        sleeping_.exchange(false, std::memory_order_relaxed))
+                    {
+                        wake();
+                    }
+                }
+
+                void flush()
+                {
+                    auto end = queue_.enqueue_position();
+                    while (handled_.load() < end && !stopped_.load())
+                    {
+                        wake();
+                        std::this_thread::yield();
+                    }
+                }
+
+                std::uint64_t sent() const
+                {
+                    return sent_.load(std::memory_order_relaxed);
+                }
+
+                std::uint64_t dropped() const
+                {
+                    return dropped_.load(std::memory_order_relaxed);
+                }
+
+            private:
+                void wake()
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    wakeup_.notify_one();
+                }
+
+                // takes up to a batch of messages out of the queue, returns their number
+                std::size_t pop_batch()
+                {
+                    // swapping keeps the allocated strings circulating
+                    std::size_t count = 0;
+                    while (count < batch_.size() &&
+                           queue_.try_pop([this, count](std::string& slot) {
+                               batch_[count].swap(slot);
+                           }))
+                    {
+                        ++count;
+                    }
+                    return count;
+                }
+
+                void run()
+                {
+                    while (true)
+                    {
+                        auto count = pop_batch();
+                        if (count > 0)
+                        {
+                            send(count);
+                            handled_.fetch_add(count);
+                            continue;
+                        }
+
+                        std::unique_lock<std::mutex> lock(mutex_);
+                        sleeping_.store(true, std::memory_order_relaxed);
+                        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                        if (queue_.empty())
+                        {
+                            if (stop_)
+                            {
+                                break;
+                            }
+
+                            wakeup_.wait_for(lock, std::chrono::milliseconds(100));
+                        }
+
+                        sleeping_.store(false, std::memory_order_relaxed);
+                    }
+                }
+
+                bool connect()
+                {
+                    if (socket_ >= 0)
+                    {
+                        return true;
+                    }
+
+                    sockaddr_un address;
+                    std::memset(&address, 0, sizeof(address));
+                    address.sun_family = AF_UNIX;
+                    if (config_.path.size() >= sizeof(address.sun_path))
+                    {
+                        return false;
+                    }
+                    std::memcpy(address.sun_path, config_.path.c_str(), config_.path.size());
+
+                    socket_ = ::socket(AF_UNIX, SOCK_DGRAM, 0);
+                    if (socket_ < 0)
+                    {
+                        return false;
+                    }
+
+                    ::fcntl(socket_, F_SETFL, ::fcntl(socket_, F_GETFL) | O_NONBLOCK);
+                    ::fcntl(socket_, F_SETFD, FD_CLOEXEC);
+
+                    if (::connect(socket_, reinterpret_cast<const sockaddr*>(&address),
+                                  sizeof(address)) != 0)
+                    {
+                        disconnect();
+                        return false;
+                    }
+
+                    return true;
+                }
+
+                void disconnect()
+                {
+                    ::close(socket_);
+                    socket_ = -1;
+                }
+
+                // sends batch_[first, count), returns the number of sent messages or -1
+                int send_some(std::size_t first, std::size_t count)
+                {
+#ifdef __linux__
+                    messages_.resize(count);
+                    iovecs_.resize(count);
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        iovecs_[i].iov_base = &batch_[first + i][0];
+                        iovecs_[i].iov_len = batch_[first + i].size();
+
+                        std::memset(&messages_[i], 0, sizeof(mmsghdr));
+                        messages_[i].msg_hdr.msg_iov = &iovecs_[i];
+                        messages_[i].msg_hdr.msg_iovlen = 1;
+                    }
+
+                    return ::sendmmsg(socket_, messages_.data(), static_cast<unsigned>(count),
+                                      MSG_DONTWAIT | MSG_NOSIGNAL);
+#else
+                    int result = 0;
+                    for (std::size_t i = first; i < first + count; ++i)
+                    {
+                        if (::send(socket_, batch_[i].data(), batch_[i].size(), MSG_DONTWAIT) < 0)
+                        {
+                            return result > 0 ? result : -1;
+                        }
+                        ++result;
+                    }
+                    return result;
+#endif
+                }
+
+                void send(std::size_t count)
+                {
+                    std::size_t done = 0;
+                    bool reconnected = false;
+                    auto deadline = std::chrono::steady_clock::now() + config_.send_timeout;
+
+                    while (done < count)
+                    {
+                        if (!connect())
+                        {
+                            break;
+                        }
+
+                        int result = send_some(done, count - done);
+                        if (result > 0)
+                        {
+                            done += static_cast<std::size_t>(result);
+                            sent_.fetch_add(static_cast<std::uint64_t>(result),
+                                            std::memory_order_relaxed);
+                            continue;
+                        }
+
+                        if (errno == EINTR)
+                        {
+                            continue;
+                        }
+
+                        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS)
+                        {
+                            // the daemon is slow, waits until it takes messages again
+                            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                deadline - std::chrono::steady_clock::now());
+                            if (left.count() <= 0)
+                            {
+                                break;
+                            }
+
+                            pollfd fd{ socket_, POLLOUT, 0 };
+                            ::poll(&fd, 1, static_cast<int>(left.count()));
+                            continue;
+                        }
+
+                        if (errno == EMSGSIZE)
+                        {
+                            ++done;
+                            dropped_.fetch_add(1, std::memory_order_relaxed);
+                            continue;
+                        }
+
+                        // e.g. the daemon was restarted, which closes the connection
+                        disconnect();
+                        if (reconnected)
+                        {
+                            break;
+                        }
+                        reconnected = true;
+                    }
+
+                    dropped_.fetch_add(count - done, std::memory_order_relaxed);
+                }
+
+                const syslog_datagram_config config_;
+                detail::bounded_queue<std::string> queue_;
+
+                std::vector<std::string> batch_;
+#ifdef __linux__
+                std::vector<mmsghdr> messages_;
+                std::vector<iovec> iovecs_;
+#endif
+                int socket_ = -1;
+
+                std::atomic<std::uint64_t> handled_{ 0 };
+                std::atomic<std::uint64_t> sent_{ 0 };
+                std::atomic<std::uint64_t> dropped_{ 0 };
+                std::atomic<bool> stopped_{ false };
+
+                std::mutex mutex_;
+                std::condition_variable wakeup_;
+                bool stop_ = false;
+                std::atomic<bool> sleeping_{ false };
+
+                // guards the batch once the thread is stopped
+                std::mutex join_mutex_;
+                std::thread thread_;
+            };
+
+            static worker& get_worker()
+            {
+                // never destroyed, so messages of destructors of other statics find it stopped.
+                // Not allocated with new, which ignores the alignment of the queue before C++17.
+                static typename std::aligned_storage<sizeof(worker), alignof(worker)>::type
+                    storage_;
+                static worker* worker_ = new (&storage_) worker();
+                return *worker_;
+            }
+
+            static void stop_at_exit()
+            {
+                get_worker().stop();
+            }
+
+        public:
+            static syslog_datagram_config& config()
+            {
+                static syslog_datagram_config config_;
+                return config_;
+            }
+
+            template <typename Record>
+            void sink(severity_level sev, lang::string_ref formatted_record, const Record& r)
+            {
+                auto& w = get_worker();
+                const auto& conf = w.configuration();
+
+                // the message is built in a buffer of the thread and copied into the queue slot
+                static thread_local std::string message;
+                message.clear();
+
+                message.push_back('<');
+                append_number(message, static_cast<unsigned>(conf.facility) * 8 + code(sev));
+                message.append(">1 ", 3);
+
+                char timestamp[nitro::detail::iso8601_max_size];
+                auto length = write_timestamp(timestamp, r.timestamp(),
+                                              nitro::detail::is_system_time_point<
+                                                  std::decay_t<decltype(r.timestamp())>>());
+                message.append(timestamp, length);
+                message.push_back(' ');
+
+                append_field(message, detail::cached_hostname(), 255);
+                append_field(message, conf.app_name, 48);
+                append_number(message, static_cast<unsigned>(detail::process_identity::pid()));
+                message.push_back(' ');
+                append_field(message, tag_of(r, has_tag<Record>()), 32);
+                message.append("- ", 2);
+
+                std::size_t size = formatted_record.size();
+                while (size > 0 && formatted_record.get()[size - 1] == '\n')
+                {
+                    --size;
+                }
+                message.append(formatted_record.get(), size);
+
+                w.push(message);
+            }
+
+            /**
+             * \brief blocks until every message written before this call is sent or dropped
+             */
+            static void flush()
+            {
+                get_worker().flush();
+            }
+
+            /**
+             * \brief the number of messages sent to the daemon
+             */
+            static std::uint64_t sent()
+            {
+                return get_worker().sent();
+            }
+
+            /**
+             * \brief the number of messages dropped, as the queue was full or the daemon did not
+             * take them
+             */
+            static std::uint64_t dropped()
+            {
+                return get_worker().dropped();
+            }
+
+        private:
+            static unsigned code(severity_level sev)
+            {
+                switch (sev)
+                {
+                case severity_level::fatal:
+                    return 2;
+                case severity_level::error:
+                    return 3;
+                case severity_level::warn:
+                    return 4;
+                case severity_level::info:
+                    return 6;
+                default:
+                    return 7;
+                }
+            }
+
+            static void append_number(std::string& s, unsigned value)
+            {
+                char buffer[nitro::detail::max_digits<unsigned>()];
+                char* end = buffer + sizeof(buffer);
+                char* begin = nitro::detail::format_decimal(end, value);
+                s.append(begin, static_cast<std::size_t>(end - begin));
+            }
+
+            // header fields are printable US-ASCII without spaces, "-" if empty
+            static void append_field(std::string& s, lang::string_ref value, std::size_t max_size)
+            {
+                const auto size = std::min(value.size(), max_size);
+                if (size == 0)
+                {
+                    s.append("- ", 2);
+                    return;
+                }
+
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    char c = value[i];
+                    s.push_back(c > ' ' && c < 127 ? c : '_');
+                }
+                s.push_back(' ');
+            }
+
+            template <typename TimePoint>
+            static std::size_t write_timestamp(char* buffer, const TimePoint& timestamp,
+                                               std::true_type)
+            {
+                return nitro::detail::format_iso8601(buffer, timestamp);
+            }
+
+            template <typename TimePoint>
+            static std::size_t write_timestamp(char* buffer, const TimePoint&, std::false_type)
+            {
+                return nitro::detail::format_iso8601(buffer, std::chrono::system_clock::now());
+            }
+
+            template <typename Record>
+            using has_tag = std::integral_constant<
+                bool, nitro::log::detail::has_attribute<tag_attribute, Record>::value ||
+                          nitro::log::detail::has_attribute<interned_tag_attribute, Record>::value>;
+
+            // refers to the tag in the record, so it is not copied
+            template <typename Record>
+            static lang::string_ref tag_of(const Record& r, std::true_type)
+            {
+                return r.tag();
+            }
+
+            template <typename Record>
+            static lang::string_ref tag_of(const Record&, std::false_type)
+            {
+                return "";
+            }
+        };
+    } // namespace sink
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_SINK_SYSLOG_DATAGRAM_HPP
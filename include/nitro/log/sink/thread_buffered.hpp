@@ -0,0 +1,405 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INCLUDE_NITRO_LOG_SINK_THREAD_BUFFERED_HPP
+#define INCLUDE_NITRO_LOG_SINK_THREAD_BUFFERED_HPP
+
+#include <nitro/log/severity.hpp>
+
+#include <nitro/lang/string_ref.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace nitro
+{
+namespace log
+{
+    namespace sink
+    {
+        struct thread_buffered_config
+        {
+            /// how long a record may stay in the buffer of its thread at most
+            std::chrono::milliseconds max_staleness{ 100 };
+
+            /// a thread, which buffered this many bytes, has its records written early
+            std::size_t buffer_size = 64 * 1024;
+
+            /// records with at least this severity are written before sink() returns
+            severity_level flush_severity = severity_level::error;
+        };
+
+        /**
+         * \brief Sink adapter, in which every thread buffers its records on its own
+         *
+         * Threads append their records to a buffer of their own, so they do not contend for a
+         * common lock like sink::stdout_mt does. A collector thread takes the records of all
+         * threads every config().max_staleness, orders them by the timestamp of their record
+         * and passes them to the wrapped Sink in one call. Records collected at the same time are
+         * in timestamp order, but a record may be collected only after later records of other
+         * threads, if its thread took a long time between taking the timestamp and handing the
+         * record to the sink.
+         *
+         * Records with config().flush_severity or higher, and records of a thread, which
+         * buffered config().buffer_size bytes, are written right away. All records are written at
+         * flush() and at exit.
+         *
+         * The configuration is read when the first record is written.
+         *
+         * \tparam Sink the sink that writes the records, it gets the highest severity of all
+         *              records it writes at once
+         */
+        template <typename Sink>
+        class thread_buffered
+        {
+            struct entry
+            {
+                std::int64_t timestamp;
+                severity_level severity;
+                std::size_t offset;
+                std::size_t size;
+            };
+
+            struct thread_buffer
+            {
+                std::mutex mutex;
+                std::string data;
+                std::vector<entry> entries;
+                bool closed = false;
+            };
+
+            // an entry of one of the batches being merged
+            struct merge_entry
+            {
+                std::int64_t timestamp;
+                const char* data;
+                std::size_t size;
+            };
+
+            class collector
+            {
+            public:
+                collector() : config_(config()), thread_([this]() { run(); })
+                {
+                    std::atexit(&thread_buffered::stop_at_exit);
+                }
+
+                // writes the remaining records, later records are written directly
+                void stop()
+                {
+                    // first, so records appended from now on are collected, see sink()
+                    stopped_.store(true);
+
+                    {
+                        std::lock_guard<std::mutex> lock(thread_mutex_);
+                        stop_ = true;
+                    }
+                    wakeup_.notify_one();
+
+                    {
+                        std::lock_guard<std::mutex> lock(join_mutex_);
+                        if (thread_.joinable())
+                        {
+                            thread_.join();
+                        }
+                    }
+
+                    collect();
+                }
+
+                const thread_buffered_config& configuration() const
+                {
+                    return config_;
+                }
+
+                std::shared_ptr<thread_buffer> add_thread()
+                {
+                    auto buffer = std::make_shared<thread_buffer>();
+
+                    std::lock_guard<std::mutex> lock(threads_mutex_);
+                    threads_.push_back(buffer);
+                    return buffer;
+                }
+
+                void wake()
+                {
+                    std::lock_guard<std::mutex> lock(thread_mutex_);
+                    wake_ = true;
+                    wakeup_.notify_one();
+                }
+
+                // collects the records of all threads and writes them
+                void collect()
+                {
+                    std::lock_guard<std::mutex> lock(collect_mutex_);
+
+                    {
+                        std::lock_guard<std::mutex> threads_lock(threads_mutex_);
+
+                        batches_.resize(std::max(batches_.size(), threads_.size()));
+                        batch_count_ = 0;
+
+                        for (auto it = threads_.begin(); it != threads_.end();)
+                        {
+                            auto& buffer = **it;
+                            auto& batch = batches_[batch_count_++];
+
+                            std::lock_guard<std::mutex> buffer_lock(buffer.mutex);
+                            batch.data.swap(buffer.data);
+                            batch.entries.swap(buffer.entries);
+
+                            if (buffer.closed)
+                            {
+                                it = threads_.erase(it);
+                            }
+                            else
+                            {
+                                ++it;
+                            }
+                        }
+                    }
+
+                    merged_.clear();
+                    auto severity = severity_level::trace;
+                    for (std::size_t i = 0; i < batch_count_; ++i)
+                    {
+                        for (const auto& e : batches_[i].entries)
+                        {
+                            merged_.push_back(
+                                { e.timestamp, batches_[i].data.data() + e.offset, e.size });
+                            severity = std::max(severity, e.severity);
+                        }
+                    }
+
+                    if (!merged_.empty())
+                    {
+                        // every batch is already ordered, which stable_sort makes use of
+                        std::stable_sort(merged_.begin(), merged_.end(),
+                                         [](const merge_entry& a, const merge_entry& b) {
+                                             return a.timestamp < b.timestamp;
+                                         });
+
+                        output_.clear();
+                        for (const auto& e : merged_)
+                        {
+                            output_.append(e.data, e.size);
+                        }
+
+                        try
+                        {
+                            sink_.sink(severity, output_);
+                        }
+                        catch (...)
+                        {
+                            // there is no one to report this to from here
+                        }
+
+                        if (!exit_handler_registered_)
+                        {
+                            // The wrapped sink may have created static objects on its first
+                            // call. Registering the handler again now makes it run before their
+                            // destructors, so the remaining records can still be written at exit.
+                            exit_handler_registered_ = true;
+                            std::atexit(&thread_buffered::stop_at_exit);
+                        }
+                    }
+
+                    for (std::size_t i = 0; i < batch_count_; ++i)
+                    {
+                        batches_[i].data.clear();
+                        batches_[i].entries.clear();
+                    }
+                }
+
+                // records written after the collector stopped, e.g. by static destructors
+                bool stopped() const
+                {
+                    return stopped_.load();
+                }
+
+                void write_directly(severity_level sev, lang::string_ref formatted_record)
+                {
+                    std::lock_guard<std::mutex> lock(collect_mutex_);
+                    sink_.sink(sev, formatted_record);
+                }
+
+            private:
+                struct batch
+                {
+                    std::string data;
+                    std::vector<entry> entries;
+                };
+
+                void run()
+                {
+                    std::unique_lock<std::mutex> lock(thread_mutex_);
+
+                    while (!stop_)
+                    {
+                        wakeup_.wait_for(lock, config_.max_staleness, [this]() {
+                            return stop_ || wake_;
+                        });
+                        if (stop_)
+                        {
+                            break;
+                        }
+                        wake_ = false;
+
+                        lock.unlock();
+                        collect();
+                        lock.lock();
+                    }
+                }
+
+                const thread_buffered_config config_;
+
+                std::mutex threads_mutex_;
+                std::vector<std::shared_ptr<thread_buffer>> threads_;
+
+                std::mutex collect_mutex_;
+                std::vector<batch> batches_;
+                std::size_t batch_count_ = 0;
+                std::vector<merge_entry> merged_;
+                std::string output_;
+                Sink sink_;
+                std::atomic<bool> stopped_{ false };
+                bool exit_handler_registered_ = false;
+
+                std::mutex join_mutex_;
+                std::mutex thread_mutex_;
+                std::condition_variable wakeup_;
+                bool stop_ = false;
+                bool wake_ = false;
+                std::thread thread_;
+            };
+
+            static collector& get_collector()
+            {
+                // never destroyed, so records of destructors of other statics find it stopped
+                static collector* collector_ = new collector();
+                return *collector_;
+            }
+
+            static void stop_at_exit()
+            {
+                get_collector().stop();
+            }
+
+            // registers the buffer of the calling thread and hands it over when the thread exits
+            class thread_registration
+            {
+            public:
+                thread_registration() : buffer(get_collector().add_thread())
+                {
+                }
+
+                ~thread_registration()
+                {
+                    // the remaining records are written with the next collection
+                    std::lock_guard<std::mutex> lock(buffer->mutex);
+                    buffer->closed = true;
+                }
+
+                std::shared_ptr<thread_buffer> buffer;
+            };
+
+            static thread_buffer& local_buffer()
+            {
+                static thread_local thread_registration registration;
+                return *registration.buffer;
+            }
+
+        public:
+            static thread_buffered_config& config()
+            {
+                static thread_buffered_config config_;
+                return config_;
+            }
+
+            template <typename Record>
+            void sink(severity_level sev, lang::string_ref formatted_record, const Record& r)
+            {
+                auto& collector = get_collector();
+                if (collector.stopped())
+                {
+                    collector.write_directly(sev, formatted_record);
+                    return;
+                }
+
+                const auto& conf = collector.configuration();
+                const auto timestamp =
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        r.timestamp().time_since_epoch())
+                        .count();
+
+                bool full;
+                {
+                    auto& buffer = local_buffer();
+                    std::lock_guard<std::mutex> lock(buffer.mutex);
+
+                    buffer.entries.push_back({ static_cast<std::int64_t>(timestamp), sev,
+                                               buffer.data.size(), formatted_record.size() });
+                    buffer.data.append(formatted_record.get(), formatted_record.size());
+
+                    full = buffer.data.size() >= conf.buffer_size;
+                }
+
+                // the collector may have stopped after the check above, with its final collection
+                // already done
+                if (sev >= conf.flush_severity || collector.stopped())
+                {
+                    collector.collect();
+                }
+                else if (full)
+                {
+                    collector.wake();
+                }
+            }
+
+            /**
+             * \brief writes the records of all threads
+             */
+            static void flush()
+            {
+                get_collector().collect();
+            }
+        };
+    } // namespace sink
+} // namespace log
+} // namespace nitro
+
+#endif // INCLUDE_NITRO_LOG_SINK_THREAD_BUFFERED_HPP
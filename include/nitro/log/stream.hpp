@@ -30,24 +30,29 @@
 #define INCLUDE_NITRO_LOG_STREAM_HPP
 
 #include <nitro/log/attribute/tag.hpp>
+#include <nitro/log/call_site.hpp>
 #include <nitro/log/detail/has_attribute.hpp>
 #include <nitro/log/detail/set_attribute.hpp>
+#include <nitro/log/detail/stream_buffer.hpp>
 #include <nitro/log/severity.hpp>
 
 #include <nitro/lang/string_ref.hpp>
 
-#include <nitro/meta/callable.hpp>
-
+#include <atomic>
 #include <chrono>
 #include <memory>
-#include <sstream>
+#include <new>
+#include <ostream>
 #include <type_traits>
+#include <utility>
 
 namespace nitro
 {
 namespace log
 {
     class tag_attribute;
+    class interned_tag_attribute;
+    class call_site_attribute;
 
     template <typename Record, template <typename> class Formatter, typename Sink,
               template <typename> class Filter>
@@ -58,7 +63,7 @@ namespace log
         template <typename Record>
         void set_timestamp(Record& r)
         {
-            r.timestamp() = r.timestamp_clock_get_time();
+            r.timestamp_clock_set_time();
         }
 
         template <typename Record, bool has_tag>
@@ -83,13 +88,132 @@ namespace log
             }
         };
 
+        template <typename Record, bool has_interned_tag>
+        class set_interned_tag_attribute
+        {
+        public:
+            void operator()(Record&, lang::string_ref)
+            {
+            }
+        };
+
+        template <typename Record>
+        class set_interned_tag_attribute<Record, true>
+        {
+        public:
+            void operator()(Record& r, lang::string_ref tag)
+            {
+                if (tag)
+                {
+                    r.set_tag(tag);
+                }
+            }
+        };
+
         template <typename Record>
         void set_tag(Record& r, lang::string_ref tag)
         {
             set_tag_attribute<Record, detail::has_attribute<tag_attribute, Record>::value>()(r,
                                                                                              tag);
+            set_interned_tag_attribute<
+                Record, detail::has_attribute<interned_tag_attribute, Record>::value>()(r, tag);
+        }
+
+        template <typename Record, bool has_call_site>
+        class set_call_site_attribute
+        {
+        public:
+            void operator()(Record&, const call_site*)
+            {
+            }
+        };
+
+        template <typename Record>
+        class set_call_site_attribute<Record, true>
+        {
+        public:
+            void operator()(Record& r, const call_site* site)
+            {
+                r.set_call_site(site);
+            }
+        };
+
+        template <typename Record>
+        void set_call_site(Record& r, const call_site* site)
+        {
+            set_call_site_attribute<Record,
+                                    detail::has_attribute<call_site_attribute, Record>::value>()(
+                r, site);
+        }
+
+        /**
+         * \brief Whether T is streamed lazily, i.e. a callable without arguments returning a value
+         *
+         * Such arguments are only called, if the log statement is not filtered.
+         */
+        template <typename T, typename = void>
+        struct is_lazy_argument : std::false_type
+        {
+        };
+
+        template <typename T>
+        struct is_lazy_argument<
+            T, std::enable_if_t<!std::is_void<decltype(std::declval<T&>()())>::value>>
+            : std::true_type
+        {
+        };
+
+        /**
+         * \brief Whether the Formatter encodes the streamed arguments itself
+         *
+         * Such formatters provide a type argument_encoder with a static
+         * encode(std::ostream&, const T&), which writes an argument into the message instead of
+         * operator<<, see formatter::binary_formatter.
+         */
+        template <typename Formatter, typename = void>
+        struct has_argument_encoder : std::false_type
+        {
+        };
+
+        template <typename Formatter>
+        struct has_argument_encoder<
+            Formatter, std::enable_if_t<std::is_class<typename Formatter::argument_encoder>::value>>
+            : std::true_type
+        {
+        };
+
+        template <typename Formatter, typename T>
+        std::enable_if_t<!has_argument_encoder<Formatter>::value> write_argument(std::ostream& s,
+                                                                                 const T& value)
+        {
+            s << value;
         }
 
+        template <typename Formatter, typename T>
+        std::enable_if_t<has_argument_encoder<Formatter>::value> write_argument(std::ostream& s,
+                                                                                const T& value)
+        {
+            Formatter::argument_encoder::encode(s, value);
+        }
+
+        /**
+         * \brief A statement of a call site, which passed its mode and the pre_filter already
+         *
+         * If enabled, the call site is enabled and the statement skips filter(Record&) as well.
+         */
+        struct checked_call_site
+        {
+            const call_site& site;
+            bool enabled;
+        };
+
+        /**
+         * \brief The stream returned for log statements, which are not filtered at compile-time
+         *
+         * The record is constructed in place and the message is written into a reused
+         * thread-local buffer, so an enabled log statement does not allocate once the buffers
+         * have grown to the size of the messages.
+         */
         template <typename Record, template <typename> class Formatter, typename Sink,
                   template <typename> class Filter, severity_level Severity>
         class smart_stream
@@ -97,65 +221,124 @@ namespace log
             typedef nitro::log::logger<Record, Formatter, Sink, Filter> logger;
 
         public:
-            smart_stream(lang::string_ref tag) : r(new Record), s()
+            smart_stream(lang::string_ref tag)
             {
-                detail::set_tag(*r, tag);
-                detail::set_severity<Record>()(*r, Severity);
+                if (logger::will_log(Severity, tag))
+                {
+                    start(tag, nullptr, false);
+                }
+            }
 
-                if (logger::will_log(*r))
+            smart_stream(lang::string_ref tag, const call_site& site)
+            {
+                auto mode = site.mode();
+                if (mode == call_site_mode::disabled)
                 {
-                    s.reset(new std::stringstream());
+                    return;
                 }
-                else
+
+                bool enabled = mode == call_site_mode::enabled;
+                if (enabled || logger::will_log(Severity, tag, site))
                 {
-                    r.reset();
+                    // the mode was loaded relaxed, this makes the function name of the site visible
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    start(tag, &site, enabled);
                 }
             }
 
-            smart_stream(smart_stream&& ss) : r(std::move(ss.r)), s(std::move(ss.s))
+            smart_stream(lang::string_ref tag, const checked_call_site& checked)
             {
+                // the mode was loaded relaxed, this makes the function name of the site visible
+                std::atomic_thread_fence(std::memory_order_acquire);
+                start(tag, &checked.site, checked.enabled);
             }
 
+            smart_stream(smart_stream&& ss) : lease_(std::move(ss.lease_))
+            {
+                if (lease_)
+                {
+                    new (&storage_) Record(std::move(ss.record()));
+                    ss.record().~Record();
+                }
+            }
+
+            smart_stream(const smart_stream&) = delete;
+            smart_stream& operator=(const smart_stream&) = delete;
+            smart_stream& operator=(smart_stream&&) = delete;
+
             ~smart_stream()
             {
-                if (r)
+                if (lease_)
                 {
-                    detail::set_timestamp(*r);
-                    r->message() = s->str();
-                    logger::log(Severity, *r);
+                    detail::set_timestamp(record());
+                    record().message() = lease_.buffer().str();
+
+                    lang::string_ref preceding = nullptr;
+                    bool passed = logger::will_log(record(), preceding);
+                    if (preceding)
+                    {
+                        auto message = record().message();
+                        record().message() = preceding;
+                        logger::log(Severity, record());
+                        record().message() = message;
+                    }
+
+                    if (passed)
+                    {
+                        logger::log(Severity, record());
+                    }
+
+                    record().~Record();
                 }
             }
 
             Record& record()
             {
-                return *r;
+                return *reinterpret_cast<Record*>(&storage_);
             }
 
-            std::stringstream& sstr()
+            std::ostream& sstr()
             {
-                return *s;
+                return lease_.stream();
             }
 
             operator bool() const
             {
-                return static_cast<bool>(s);
+                return static_cast<bool>(lease_);
             }
 
         private:
-            std::unique_ptr<Record> r;
-            std::unique_ptr<std::stringstream> s;
+            // enabled call sites skip the filter, but not the post_filter, see call_site_registry
+            void start(lang::string_ref tag, const call_site* site, bool enabled)
+            {
+                new (&storage_) Record();
+                detail::set_tag(record(), tag);
+                detail::set_call_site(record(), site);
+                detail::set_severity<Record>()(record(), Severity);
+
+                if (enabled || logger::will_log(record()))
+                {
+                    lease_ = stream_lease::acquire();
+                }
+                else
+                {
+                    record().~Record();
+                }
+            }
+
+            typename std::aligned_storage<sizeof(Record), alignof(Record)>::type storage_;
+            stream_lease lease_;
         };
 
         template <typename Record, template <typename> class Formatter, typename Sink,
                   template <typename> class Filter, typename T, severity_level Severity,
-                  typename std::enable_if<nitro::meta::is_callable<T, std::string()>::value,
-                                          int>::type = 0>
+                  typename std::enable_if<is_lazy_argument<T>::value, int>::type = 0>
         smart_stream<Record, Formatter, Sink, Filter, Severity>&
         operator<<(smart_stream<Record, Formatter, Sink, Filter, Severity>& s, T t)
         {
             if (s)
             {
-                s.sstr() << t();
+                write_argument<Formatter<Record>>(s.sstr(), t());
             }
 
             return s;
@@ -163,14 +346,13 @@ namespace log
 
         template <typename Record, template <typename> class Formatter, typename Sink,
                   template <typename> class Filter, typename T, severity_level Severity,
-                  typename std::enable_if<nitro::meta::is_callable<T, std::string()>::value,
-                                          int>::type = 0>
+                  typename std::enable_if<is_lazy_argument<T>::value, int>::type = 0>
         smart_stream<Record, Formatter, Sink, Filter, Severity>
         operator<<(smart_stream<Record, Formatter, Sink, Filter, Severity>&& s, T t)
         {
             if (s)
             {
-                s.sstr() << t();
+                write_argument<Formatter<Record>>(s.sstr(), t());
             }
 
             return std::move(s);
@@ -178,14 +360,13 @@ namespace log
 
         template <typename Record, template <typename> class Formatter, typename Sink,
                   template <typename> class Filter, typename T, severity_level Severity,
-                  typename std::enable_if<!nitro::meta::is_callable<T, std::string()>::value,
-                                          int>::type = 0>
+                  typename std::enable_if<!is_lazy_argument<T>::value, int>::type = 0>
         smart_stream<Record, Formatter, Sink, Filter, Severity>
         operator<<(smart_stream<Record, Formatter, Sink, Filter, Severity>&& s, const T& t)
         {
             if (s)
             {
-                s.sstr() << t;
+                write_argument<Formatter<Record>>(s.sstr(), t);
             }
 
             return std::move(s);
@@ -193,14 +374,13 @@ namespace log
 
         template <typename Record, template <typename> class Formatter, typename Sink,
                   template <typename> class Filter, typename T, severity_level Severity,
-                  typename std::enable_if<!nitro::meta::is_callable<T, std::string()>::value,
-                                          int>::type = 0>
+                  typename std::enable_if<!is_lazy_argument<T>::value, int>::type = 0>
         smart_stream<Record, Formatter, Sink, Filter, Severity>&
         operator<<(smart_stream<Record, Formatter, Sink, Filter, Severity>& s, const T& t)
         {
             if (s)
             {
-                s.sstr() << t;
+                write_argument<Formatter<Record>>(s.sstr(), t);
             }
 
             return s;
@@ -212,6 +392,14 @@ namespace log
             null_stream(lang::string_ref)
             {
             }
+
+            null_stream(lang::string_ref, const call_site&)
+            {
+            }
+
+            null_stream(lang::string_ref, const checked_call_site&)
+            {
+            }
         };
 
         template <typename T>
@@ -240,6 +428,92 @@ namespace log
             typedef null_stream type;
         };
 
+        /**
+         * \brief Decides whether a statement of NITRO_LOG_TAG is skipped, see call_site_registry
+         *
+         * Converts to true, if the statement is skipped. For statements of call sites, which are
+         * neither enabled nor disabled, this costs a relaxed load of the mode and the pre_filter
+         * of the logger. Otherwise, the statement is started with checked() and tag(), which
+         * neither load the mode nor call the pre_filter again.
+         *
+         * Tag is held by value if it is a temporary, e.g. a std::string, so it lives as long as
+         * the statement.
+         */
+        template <typename Logger, severity_level Severity, typename Tag>
+        class call_site_check
+        {
+        public:
+            call_site_check(call_site& site, const char* function, Tag&& tag)
+            : tag_(std::forward<Tag>(tag)), site_(site),
+              skip_(Severity < severity_level::NITRO_LOG_MIN_SEVERITY || skip(function))
+            {
+            }
+
+            call_site_check(call_site_check&&) = default;
+
+            explicit operator bool() const
+            {
+                return skip_;
+            }
+
+            checked_call_site checked() const
+            {
+                return { site_, enabled_ };
+            }
+
+            lang::string_ref tag() const
+            {
+                return tag_;
+            }
+
+        private:
+            bool skip(const char* function)
+            {
+                auto mode = call_site_state::load(site_);
+                if (mode == static_cast<unsigned char>(call_site_mode::filtered))
+                {
+                    return !Logger::will_log(Severity, tag(), site_);
+                }
+
+                return skip(mode, function);
+            }
+
+            // the call site is not registered yet, enabled or disabled
+            bool skip(unsigned char mode, const char* function)
+            {
+                if (mode == call_site_state::unregistered)
+                {
+                    call_site_registry::instance().add(site_, function);
+                    mode = call_site_state::load(site_);
+                }
+
+                switch (static_cast<call_site_mode>(mode))
+                {
+                case call_site_mode::enabled:
+                    enabled_ = true;
+                    return false;
+                case call_site_mode::disabled:
+                    return true;
+                default:
+                    return !Logger::will_log(Severity, tag(), site_);
+                }
+            }
+
+            Tag tag_;
+            call_site& site_;
+            bool enabled_ = false;
+            bool skip_;
+        };
+
+        /**
+         * \brief Creates the call_site_check of a statement, deducing the type of its tag
+         */
+        template <typename Logger, severity_level Severity, typename Tag>
+        call_site_check<Logger, Severity, Tag> check_call_site(call_site& site,
+                                                               const char* function, Tag&& tag)
+        {
+            return { site, function, std::forward<Tag>(tag) };
+        }
     } // namespace detail
 
     template <severity_level Severity, typename Record, template <typename> class Formatter,
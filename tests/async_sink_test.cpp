@@ -0,0 +1,227 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include <nitro/log/attribute/severity.hpp>
+#include <nitro/log/attribute/timestamp.hpp>
+#include <nitro/log/filter/null_filter.hpp>
+#include <nitro/log/log.hpp>
+#include <nitro/log/metrics.hpp>
+#include <nitro/log/sink/async.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace detail
+{
+
+typedef nitro::log::record<nitro::log::message_attribute, nitro::log::severity_attribute,
+                           nitro::log::timestamp_attribute>
+    record;
+
+template <typename Record>
+class message_formater
+{
+public:
+    std::string format(Record& r)
+    {
+        return r.message();
+    }
+};
+
+template <int N>
+class collecting_sink
+{
+public:
+    static std::vector<std::string>& records()
+    {
+        static std::vector<std::string> records_;
+        return records_;
+    }
+
+    static std::atomic<bool>& gate()
+    {
+        static std::atomic<bool> gate_{ true };
+        return gate_;
+    }
+
+    void sink(nitro::log::severity_level, nitro::lang::string_ref formatted_record)
+    {
+        while (!gate().load())
+        {
+            std::this_thread::yield();
+        }
+
+        records().push_back(formatted_record);
+    }
+};
+
+template <typename Sink>
+using logging =
+    nitro::log::logger<record, message_formater, Sink, nitro::log::filter::null_filter>;
+} // namespace detail
+
+using nitro::log::sink::async;
+using nitro::log::sink::overflow_policy;
+
+TEST_CASE("Async sink writes every record", "[log]")
+{
+    using sink = async<detail::collecting_sink<0>, overflow_policy::block, 16>;
+    using logging = detail::logging<sink>;
+
+    sink::config().name = "queue";
+
+    const int threads = 4;
+    const int per_thread = 1000;
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([t]() {
+            for (int i = 0; i < per_thread; ++i)
+            {
+                logging::info() << t << " " << i;
+            }
+        });
+    }
+
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    sink::flush();
+
+    const auto& records = detail::collecting_sink<0>::records();
+    REQUIRE(records.size() == threads * per_thread);
+    REQUIRE(sink::dropped() == 0);
+    REQUIRE(sink::queue_depth() == 0);
+
+    std::stringstream metrics;
+    nitro::log::write_metrics(metrics);
+    REQUIRE(metrics.str().find("queue: dropped 0 queue_depth 0\n") != std::string::npos);
+
+    SECTION("and keeps the order of each thread")
+    {
+        std::vector<int> next(threads, 0);
+        for (const auto& record : records)
+        {
+            auto space = record.find(' ');
+            int t = std::stoi(record.substr(0, space));
+            int i = std::stoi(record.substr(space + 1));
+
+            REQUIRE(i == next[t]);
+            ++next[t];
+        }
+    }
+}
+
+TEST_CASE("Async sink returns from fatal records only after they are written", "[log]")
+{
+    using sink = async<detail::collecting_sink<1>>;
+    using logging = detail::logging<sink>;
+
+    logging::info() << "info";
+    logging::fatal() << "fatal";
+
+    const auto& records = detail::collecting_sink<1>::records();
+    REQUIRE(records.size() == 2);
+    REQUIRE(records.back() == "fatal");
+}
+
+TEST_CASE("Async sink applies the overflow policy", "[log]")
+{
+    const int count = 100;
+
+    SECTION("drop newest keeps the oldest records")
+    {
+        using sink = async<detail::collecting_sink<2>, overflow_policy::drop_newest, 4>;
+        using logging = detail::logging<sink>;
+
+        detail::collecting_sink<2>::gate() = false;
+        for (int i = 0; i < count; ++i)
+        {
+            logging::info() << i;
+        }
+        detail::collecting_sink<2>::gate() = true;
+        sink::flush();
+
+        const auto& records = detail::collecting_sink<2>::records();
+        REQUIRE(sink::dropped() > 0);
+        REQUIRE(records.size() + sink::dropped() == count);
+        REQUIRE(records.front() == "0");
+    }
+
+    SECTION("drop oldest keeps the newest records")
+    {
+        using sink = async<detail::collecting_sink<3>, overflow_policy::drop_oldest, 4>;
+        using logging = detail::logging<sink>;
+
+        detail::collecting_sink<3>::gate() = false;
+        for (int i = 0; i < count; ++i)
+        {
+            logging::info() << i;
+        }
+        detail::collecting_sink<3>::gate() = true;
+        sink::flush();
+
+        const auto& records = detail::collecting_sink<3>::records();
+        REQUIRE(sink::dropped() > 0);
+        REQUIRE(records.size() + sink::dropped() == count);
+        REQUIRE(records.back() == std::to_string(count - 1));
+    }
+}
+
+TEST_CASE("Async sink never evicts a fatal record to make room", "[log]")
+{
+    using sink = async<detail::collecting_sink<4>, overflow_policy::drop_oldest, 4>;
+    using logging = detail::logging<sink>;
+
+    // the writer blocks on the first record, so the queue stays full
+    detail::collecting_sink<4>::gate() = false;
+    logging::info() << "first";
+    while (sink::queue_depth() != 0)
+    {
+        std::this_thread::yield();
+    }
+
+    for (int i = 0; i < 3; ++i)
+    {
+        logging::info() << "queued";
+    }
+
+    // the fatal record takes the last slot and waits to be written
+    std::thread fatal([]() { logging::fatal() << "fatal"; });
+    while (sink::queue_depth() != 4)
+    {
+        std::this_thread::yield();
+    }
+
+    // the first three evictions make the fatal record the oldest one
+    std::vector<std::thread> flooders;
+    for (int t = 0; t < 3; ++t)
+    {
+        flooders.emplace_back([]() {
+            for (int i = 0; i < 100; ++i)
+            {
+                logging::info() << "flood";
+            }
+        });
+    }
+    for (auto& flooder : flooders)
+    {
+        flooder.join();
+    }
+
+    detail::collecting_sink<4>::gate() = true;
+    fatal.join();
+    sink::flush();
+
+    const auto& records = detail::collecting_sink<4>::records();
+    REQUIRE(records.front() == "first");
+    REQUIRE(std::count(records.begin(), records.end(), "fatal") == 1);
+    REQUIRE(records.size() + sink::dropped() == 1 + 3 + 1 + 300);
+}
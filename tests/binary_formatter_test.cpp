@@ -0,0 +1,218 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include <nitro/log/attribute/severity.hpp>
+#include <nitro/log/attribute/timestamp.hpp>
+#include <nitro/log/filter/null_filter.hpp>
+#include <nitro/log/formatter/binary.hpp>
+#include <nitro/log/formatter/binary_decoder.hpp>
+#include <nitro/log/formatter/text.hpp>
+#include <nitro/log/log.hpp>
+#include <nitro/log/sink/binary_to_text.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace detail
+{
+
+typedef nitro::log::record<nitro::log::tag_attribute, nitro::log::message_attribute,
+                           nitro::log::severity_attribute,
+                           nitro::log::timestamp_clock_attribute<std::chrono::system_clock>>
+    record;
+
+class capturing_sink
+{
+public:
+    static std::vector<std::string>& records()
+    {
+        static std::vector<std::string> records_;
+        return records_;
+    }
+
+    void sink(nitro::log::severity_level, nitro::lang::string_ref formatted_record)
+    {
+        records().emplace_back(formatted_record);
+    }
+};
+
+struct point
+{
+    int x;
+    int y;
+};
+
+std::ostream& operator<<(std::ostream& s, const point& p)
+{
+    return s << '(' << p.x << ", " << p.y << ')';
+}
+
+std::string all_records()
+{
+    std::string result;
+    for (const auto& r : capturing_sink::records())
+    {
+        result += r;
+    }
+    return result;
+}
+
+std::string decode(const std::string& data)
+{
+    nitro::log::formatter::binary_decoder decoder;
+    decoder.define(data.data(), data.size());
+
+    std::stringstream text;
+    REQUIRE(decoder.decode(data.data(), data.size(), text) == data.size());
+    return text.str();
+}
+
+// the decoded message, without the attributes
+std::string message_of(const std::string& line)
+{
+    auto begin = line.find("]: ");
+    REQUIRE(begin != std::string::npos);
+    return line.substr(begin + 3);
+}
+} // namespace detail
+
+using logging = nitro::log::logger<detail::record, nitro::log::formatter::binary_formatter,
+                                   detail::capturing_sink, nitro::log::filter::null_filter>;
+
+using text_logging =
+    nitro::log::logger<detail::record, nitro::log::formatter::binary_formatter,
+                       nitro::log::sink::binary_to_text<detail::capturing_sink>,
+                       nitro::log::filter::null_filter>;
+
+TEST_CASE("Binary records decode to the text of the streamed arguments", "[log]")
+{
+    auto& records = detail::capturing_sink::records();
+    records.clear();
+
+    const char* c_string = "c string";
+    std::string string = "string";
+    char buffer[16] = "buffer";
+
+    logging::info() << "int " << -42 << ", unsigned " << 42u << ", char " << 'x' << ", double "
+                    << 3.25 << ", float " << 1.0f / 3 << ", bool " << true << ", " << c_string
+                    << ", " << string << ", " << buffer << ", " << detail::point{ 1, 2 }
+                    << ", " << []() { return 17; };
+
+    std::ostringstream expected;
+    expected << "int " << -42 << ", unsigned " << 42u << ", char " << 'x' << ", double " << 3.25
+             << ", float " << 1.0f / 3 << ", bool " << true << ", " << c_string << ", " << string
+             << ", " << buffer << ", " << detail::point{ 1, 2 } << ", " << 17 << '\n';
+
+    REQUIRE(records.size() == 1);
+    REQUIRE(detail::message_of(detail::decode(records[0])) == expected.str());
+}
+
+TEST_CASE("Binary records keep stream manipulators", "[log]")
+{
+    auto& records = detail::capturing_sink::records();
+    records.clear();
+
+    logging::info() << std::hex << 255 << ' ' << std::setw(6) << std::setfill('.') << 10
+                    << std::dec << ' ' << std::setprecision(3) << 3.14159 << ' ' << std::setw(4)
+                    << "ab";
+
+    std::ostringstream expected;
+    expected << std::hex << 255 << ' ' << std::setw(6) << std::setfill('.') << 10 << std::dec
+             << ' ' << std::setprecision(3) << 3.14159 << ' ' << std::setw(4) << "ab" << '\n';
+
+    REQUIRE(records.size() == 1);
+    REQUIRE(detail::message_of(detail::decode(records[0])) == expected.str());
+}
+
+TEST_CASE("Binary records carry the attributes of the record", "[log]")
+{
+    auto& records = detail::capturing_sink::records();
+    records.clear();
+
+    auto before = std::chrono::system_clock::now();
+    logging::warn("net") << "connected";
+
+    auto line = detail::decode(detail::all_records());
+
+    // same layout as the text formatter
+    REQUIRE(line.size() == 29 + std::string("[net][ WARN]: connected\n").size());
+    REQUIRE(line.substr(29) == "[net][ WARN]: connected\n");
+
+    char timestamp[nitro::detail::iso8601_max_size];
+    auto length = nitro::detail::format_iso8601(timestamp, before, 0);
+    // compare up to the minutes, the seconds may have changed in between
+    REQUIRE(line.substr(1, length - 4) == std::string(timestamp, length - 4));
+}
+
+TEST_CASE("Binary records store literals once", "[log]")
+{
+    auto& records = detail::capturing_sink::records();
+    records.clear();
+
+    for (int i = 0; i < 100; ++i)
+    {
+        logging::info() << "a rather long literal, which is only stored once: " << i;
+    }
+
+    auto data = detail::all_records();
+
+    std::string literal = "a rather long literal, which is only stored once: ";
+    std::size_t occurrences = 0;
+    for (auto pos = data.find(literal); pos != std::string::npos;
+         pos = data.find(literal, pos + 1))
+    {
+        ++occurrences;
+    }
+    REQUIRE(occurrences == 1);
+
+    REQUIRE(records.back().size() < literal.size());
+
+    auto text = detail::decode(data);
+    REQUIRE(detail::message_of(text.substr(text.rfind('['))) == literal + "99\n");
+}
+
+TEST_CASE("Binary decoder handles incomplete and undefined data", "[log]")
+{
+    auto& records = detail::capturing_sink::records();
+    records.clear();
+
+    logging::info() << "an undefined literal " << 1;
+    auto data = detail::all_records();
+
+    nitro::log::formatter::binary_decoder decoder;
+    std::stringstream text;
+
+    SECTION("incomplete frames are not read")
+    {
+        decoder.define(data.data(), data.size());
+        REQUIRE(decoder.decode(data.data(), data.size() - 1, text) < data.size() - 1);
+    }
+
+    SECTION("undefined literals are marked")
+    {
+        REQUIRE(decoder.decode(data.data(), data.size(), text) == data.size());
+        REQUIRE(detail::message_of(text.str()).find("<undefined #") == 0);
+    }
+
+    SECTION("or looked up in the tables of the process")
+    {
+        nitro::log::formatter::binary_decoder process_decoder(true);
+        REQUIRE(process_decoder.decode(data.data(), data.size(), text) == data.size());
+        REQUIRE(detail::message_of(text.str()) == "an undefined literal 1\n");
+    }
+}
+
+TEST_CASE("Binary records can be converted to text by a sink", "[log]")
+{
+    auto& records = detail::capturing_sink::records();
+    records.clear();
+
+    text_logging::error("db") << "query took " << 12.5 << " ms";
+
+    REQUIRE(records.size() == 1);
+    REQUIRE(records[0].substr(29) == "[db][ERROR]: query took 12.5 ms\n");
+}
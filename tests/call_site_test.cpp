@@ -0,0 +1,316 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include <nitro/log/attribute/call_site.hpp>
+#include <nitro/log/attribute/severity.hpp>
+#include <nitro/log/attribute/timestamp.hpp>
+#include <nitro/log/filter/null_filter.hpp>
+#include <nitro/log/filter/severity_filter.hpp>
+#include <nitro/log/formatter/text.hpp>
+#include <nitro/log/log.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <nitro/log/call_site_signal.hpp>
+
+#include <csignal>
+#endif
+
+namespace detail
+{
+
+typedef nitro::log::record<nitro::log::tag_attribute, nitro::log::message_attribute,
+                           nitro::log::severity_attribute, nitro::log::call_site_attribute,
+                           nitro::log::timestamp_attribute>
+    record;
+
+class capturing_sink
+{
+public:
+    static std::vector<const nitro::log::call_site*>& sites()
+    {
+        static std::vector<const nitro::log::call_site*> sites_;
+        return sites_;
+    }
+
+    static std::vector<std::string>& records()
+    {
+        static std::vector<std::string> records_;
+        return records_;
+    }
+
+    template <typename Record>
+    void sink(nitro::log::severity_level, nitro::lang::string_ref formatted_record,
+              const Record& r)
+    {
+        sites().push_back(r.call_site());
+        records().emplace_back(formatted_record);
+    }
+};
+
+template <typename Record>
+using log_filter = nitro::log::filter::null_filter<Record>;
+
+template <typename Record>
+using severity_filter = nitro::log::filter::severity_filter<Record>;
+
+// counts the calls of pre_filter
+template <typename Record>
+class counting_filter
+{
+public:
+    static int& pre_filtered()
+    {
+        static int pre_filtered_ = 0;
+        return pre_filtered_;
+    }
+
+    bool pre_filter(nitro::log::severity_level, nitro::lang::string_ref) const
+    {
+        ++pre_filtered();
+        return true;
+    }
+
+    bool filter(Record&) const
+    {
+        return true;
+    }
+};
+
+int tags_evaluated = 0;
+
+std::string tag(const std::string& name)
+{
+    ++tags_evaluated;
+    return name + "-tag";
+}
+
+const unsigned site_of_function_line = __LINE__ + 4;
+
+const nitro::log::call_site& site_of_function()
+{
+    return NITRO_LOG_CALL_SITE();
+}
+} // namespace detail
+
+using logging = nitro::log::logger<detail::record, nitro::log::formatter::text_formatter,
+                                   detail::capturing_sink, detail::log_filter>;
+
+using filtered = nitro::log::logger<detail::record, nitro::log::formatter::text_formatter,
+                                    detail::capturing_sink, detail::severity_filter>;
+
+using counted = nitro::log::logger<detail::record, nitro::log::formatter::text_formatter,
+                                   detail::capturing_sink, detail::counting_filter>;
+
+using nitro::log::call_site_mode;
+
+std::string location(unsigned line)
+{
+    return "call_site_test.cpp:" + std::to_string(line);
+}
+
+TEST_CASE("Call sites describe the location of the statement", "[log]")
+{
+    const auto& site = detail::site_of_function();
+
+    REQUIRE(std::string(site.file()).find("call_site_test.cpp") != std::string::npos);
+    REQUIRE(std::string(site.file_name()) == "call_site_test.cpp");
+    REQUIRE(site.line() == detail::site_of_function_line);
+    REQUIRE(std::string(site.function()) == "site_of_function");
+
+    // the same statement always has the same call site
+    REQUIRE(&detail::site_of_function() == &site);
+}
+
+TEST_CASE("NITRO_LOG stores the call site in the record", "[log]")
+{
+    auto& sites = detail::capturing_sink::sites();
+    auto& records = detail::capturing_sink::records();
+
+    for (int i = 0; i < 2; ++i)
+    {
+        NITRO_LOG(logging, info) << "first";
+        NITRO_LOG_TAG(logging, warn, "net") << "second";
+    }
+    logging::info() << "without call site";
+
+    REQUIRE(sites.size() == 5);
+    REQUIRE(sites[0] != nullptr);
+    REQUIRE(sites[1] != nullptr);
+    REQUIRE(sites[0] != sites[1]);
+    REQUIRE(sites[2] == sites[0]);
+    REQUIRE(sites[3] == sites[1]);
+    REQUIRE(sites[4] == nullptr);
+
+    REQUIRE(sites[0]->line() + 1 == sites[1]->line());
+    REQUIRE(std::string(sites[0]->function()) == __func__);
+
+    auto location = "[call_site_test.cpp:" + std::to_string(sites[1]->line()) + "]: second\n";
+    REQUIRE(records[1].find("[net][ WARN]" + location) != std::string::npos);
+    REQUIRE(records[4].find("[ INFO]: without call site\n") != std::string::npos);
+}
+
+TEST_CASE("NITRO_LOG_TAG evaluates the tag and calls the pre_filter once", "[log]")
+{
+    auto& records = detail::capturing_sink::records();
+    records.clear();
+
+    using filter = detail::counting_filter<detail::record>;
+    filter::pre_filtered() = 0;
+
+    for (int i = 0; i < 3; ++i)
+    {
+        // the tag is a temporary, which has to live until the record is written
+        NITRO_LOG_TAG(counted, info, detail::tag("net")) << "counted";
+    }
+
+    REQUIRE(detail::tags_evaluated == 3);
+    REQUIRE(filter::pre_filtered() == 3);
+    REQUIRE(records.size() == 3);
+    REQUIRE(records[2].find("[net-tag][ INFO]") != std::string::npos);
+}
+
+TEST_CASE("Call sites can be passed to the logger", "[log]")
+{
+    auto& sites = detail::capturing_sink::sites();
+    sites.clear();
+
+    const unsigned line = __LINE__ + 1;
+    logging::debug(NITRO_LOG_CALL_SITE(), "db") << "explicit";
+    logging::debug(detail::site_of_function()) << "from elsewhere";
+
+    REQUIRE(sites.size() == 2);
+    REQUIRE(sites[0]->line() == line);
+    REQUIRE(sites[1] == &detail::site_of_function());
+}
+
+TEST_CASE("Call sites can be enabled and disabled at runtime", "[log]")
+{
+    auto& registry = nitro::log::call_site_registry::instance();
+    auto& records = detail::capturing_sink::records();
+    detail::severity_filter<detail::record>::set_severity(nitro::log::severity_level::info);
+
+    int evaluated = 0;
+    auto count = [&evaluated]() { return ++evaluated; };
+
+    const unsigned debug_line = __LINE__ + 4;
+    const unsigned info_line = __LINE__ + 4;
+    auto log_both = [&count]() {
+        detail::capturing_sink::records().clear();
+        NITRO_LOG(filtered, debug) << "debug " << count;
+        NITRO_LOG(filtered, info) << "info " << count;
+    };
+
+    log_both();
+    REQUIRE(records.size() == 1);
+    REQUIRE(evaluated == 1);
+
+    SECTION("enabled statements are logged regardless of the filter")
+    {
+        registry.set_mode(location(debug_line), call_site_mode::enabled);
+        log_both();
+
+        REQUIRE(records.size() == 2);
+        REQUIRE(records[0].find("[DEBUG][call_site_test.cpp:") != std::string::npos);
+        REQUIRE(evaluated == 3);
+    }
+
+    SECTION("disabled statements are not logged and not evaluated")
+    {
+        registry.set_mode(location(info_line), call_site_mode::disabled);
+        log_both();
+
+        REQUIRE(records.empty());
+        REQUIRE(evaluated == 1);
+    }
+
+    SECTION("modes can be set for a whole file")
+    {
+        registry.configure("call_site_test.cpp=off");
+        log_both();
+        REQUIRE(records.empty());
+
+        registry.configure("tests/call_site_test.cpp = on");
+        log_both();
+        REQUIRE(records.size() == 2);
+
+        registry.configure("*=default");
+        log_both();
+        REQUIRE(records.size() == 1);
+    }
+
+    SECTION("modes apply to statements, which were not executed yet")
+    {
+        const unsigned line = __LINE__ + 5;
+        registry.set_mode(location(line), call_site_mode::enabled);
+
+        records.clear();
+        filtered::trace(NITRO_LOG_CALL_SITE()) << "not filtered at compile-time";
+        NITRO_LOG(filtered, debug) << "later";
+
+        REQUIRE(records.size() == 1);
+        REQUIRE(records[0].find("later") != std::string::npos);
+    }
+
+    registry.reset();
+    log_both();
+    REQUIRE(records.size() == 1);
+    detail::severity_filter<detail::record>::set_severity(nitro::log::severity_level::trace);
+}
+
+TEST_CASE("The call site configuration is checked before it is applied", "[log]")
+{
+    auto& registry = nitro::log::call_site_registry::instance();
+    const auto& site = detail::site_of_function();
+
+    REQUIRE_THROWS(registry.configure("call_site_test.cpp=off,net.cpp=maybe"));
+    REQUIRE_THROWS(registry.configure("=on"));
+    REQUIRE_THROWS(registry.configure("net.cpp"));
+    REQUIRE(site.mode() == call_site_mode::filtered);
+
+    registry.configure(" " + location(site.line()) + " = OFF , ");
+    REQUIRE(site.mode() == call_site_mode::disabled);
+
+    std::vector<const nitro::log::call_site*> sites;
+    registry.for_each([&sites](const nitro::log::call_site& s) { sites.push_back(&s); });
+    REQUIRE(std::find(sites.begin(), sites.end(), &site) != sites.end());
+
+    const char* path = "call_site_test.conf";
+    {
+        std::ofstream file(path);
+        file << "# enables the site\n\n" << location(site.line()) << "=on\n";
+    }
+    registry.configure_from_file(path);
+    REQUIRE(site.mode() == call_site_mode::enabled);
+
+    REQUIRE_THROWS(registry.configure_from_file("does/not/exist"));
+
+#ifndef _WIN32
+    {
+        std::ofstream file(path);
+        file << location(site.line()) << "=off\n";
+    }
+
+    nitro::log::reload_call_sites_on_signal(SIGUSR1, path);
+    auto& reloader = nitro::log::detail::call_site_reloader::instance();
+    std::raise(SIGUSR1);
+
+    for (int i = 0; i < 1000 && reloader.reloads() == 0; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    REQUIRE(reloader.reloads() == 1);
+    REQUIRE(reloader.last_result() == path);
+    REQUIRE(site.mode() == call_site_mode::disabled);
+#endif
+
+    std::remove(path);
+    registry.reset();
+}
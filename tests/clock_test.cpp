@@ -0,0 +1,112 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include <nitro/log/attribute/message.hpp>
+#include <nitro/log/attribute/timestamp.hpp>
+#include <nitro/log/clock/coarse.hpp>
+#include <nitro/log/clock/tsc.hpp>
+#include <nitro/log/filter/null_filter.hpp>
+#include <nitro/log/formatter/text.hpp>
+#include <nitro/log/log.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace detail
+{
+
+typedef nitro::log::record<nitro::log::message_attribute,
+                           nitro::log::timestamp_clock_attribute<nitro::log::clock::tsc_clock>>
+    tsc_record;
+
+class capturing_sink
+{
+public:
+    static std::vector<std::string>& records()
+    {
+        static std::vector<std::string> records_;
+        return records_;
+    }
+
+    void sink(nitro::log::severity_level, nitro::lang::string_ref formatted_record)
+    {
+        records().emplace_back(formatted_record);
+    }
+};
+
+using tsc_logging = nitro::log::logger<tsc_record, nitro::log::formatter::text_formatter,
+                                       capturing_sink, nitro::log::filter::null_filter>;
+
+template <typename TimePoint>
+std::int64_t milliseconds_between(TimePoint a, TimePoint b)
+{
+    auto diff = std::chrono::duration_cast<std::chrono::milliseconds>(a - b).count();
+    return diff < 0 ? -diff : diff;
+}
+
+// the first conversion calibrates, recalibrate often to test it
+void calibrate()
+{
+    nitro::log::clock::tsc_clock::config().recalibration_interval = std::chrono::milliseconds(5);
+    nitro::log::clock::tsc_clock::now();
+}
+} // namespace detail
+
+using nitro::log::clock::coarse_steady_clock;
+using nitro::log::clock::coarse_system_clock;
+using nitro::log::clock::tsc_clock;
+
+TEST_CASE("Coarse clocks are close to the precise ones", "[log]")
+{
+    REQUIRE(detail::milliseconds_between(coarse_system_clock::now(),
+                                         std::chrono::system_clock::now()) < 50);
+
+    auto before = coarse_steady_clock::now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    auto after = coarse_steady_clock::now();
+
+    REQUIRE(after > before);
+    REQUIRE(after - before >= std::chrono::milliseconds(10));
+}
+
+TEST_CASE("The tsc clock follows the system clock", "[log]")
+{
+    detail::calibrate();
+
+    for (int i = 0; i < 5; ++i)
+    {
+        REQUIRE(detail::milliseconds_between(tsc_clock::now(), std::chrono::system_clock::now()) <
+                5);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    auto first = tsc_clock::ticks();
+    auto second = tsc_clock::ticks();
+    REQUIRE(second >= first);
+}
+
+TEST_CASE("The tsc timestamp is converted when the record is formatted", "[log]")
+{
+    detail::calibrate();
+
+    nitro::log::timestamp_clock_attribute<tsc_clock> attribute;
+    attribute.timestamp_clock_set_time();
+    auto taken = std::chrono::system_clock::now();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+
+    // the ticks were stored, so the time is the one of the capture, not of the conversion
+    REQUIRE(detail::milliseconds_between(attribute.timestamp(), taken) < 5);
+
+    detail::capturing_sink::records().clear();
+    detail::tsc_logging::info() << "wall time";
+
+    auto& records = detail::capturing_sink::records();
+    REQUIRE(records.size() == 1);
+    // ISO-8601, as the ticks are converted to std::chrono::system_clock
+    REQUIRE(records[0].substr(0, 3) == "[20");
+    REQUIRE(records[0].find("]: wall time\n") != std::string::npos);
+}
@@ -0,0 +1,135 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "test_directory.hpp"
+
+#include <nitro/log/attribute/severity.hpp>
+#include <nitro/log/attribute/timestamp.hpp>
+#include <nitro/log/crash_handler.hpp>
+#include <nitro/log/filter/null_filter.hpp>
+#include <nitro/log/log.hpp>
+#include <nitro/log/sink/rotating_file.hpp>
+
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <regex>
+#include <string>
+
+extern "C"
+{
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+}
+
+namespace detail
+{
+
+typedef nitro::log::record<nitro::log::message_attribute, nitro::log::severity_attribute,
+                           nitro::log::timestamp_attribute>
+    record;
+
+template <typename Record>
+class line_formater
+{
+public:
+    std::string format(Record& r)
+    {
+        return r.message().str() + "\n";
+    }
+};
+
+template <unsigned N>
+using logging = nitro::log::logger<record, line_formater, nitro::log::sink::rotating_file<N>,
+                                   nitro::log::filter::null_filter>;
+
+// buffers records in a rotating_file, installs the handler and crashes by calling f
+template <unsigned N, typename F>
+int crash(const std::string& name, bool backtrace, F f)
+{
+    auto& config = nitro::log::sink::rotating_file<N>::config();
+    config.path = directory() + "/" + name + ".log";
+    config.flush_interval = std::chrono::milliseconds(0);
+    config.flush_severity = nitro::log::severity_level::fatal;
+
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        int fd = open((directory() + "/" + name + ".stderr").c_str(),
+                      O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+        // Catch reports crashes itself, the child only has to die with the signal
+        std::signal(SIGSEGV, SIG_DFL);
+        std::signal(SIGABRT, SIG_DFL);
+
+        nitro::log::crash_handler_config crash_config;
+        crash_config.fd = fd;
+        crash_config.backtrace = backtrace;
+        nitro::log::install_crash_handler(crash_config);
+
+        for (int i = 0; i < 3; ++i)
+        {
+            logging<N>::info() << "record " << i;
+        }
+
+        f();
+        _exit(0);
+    }
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return status;
+}
+
+const std::regex fatal_record(
+    "\\[[0-9]{4}-[0-9]{2}-[0-9]{2}T[0-9]{2}:[0-9]{2}:[0-9]{2}\\.[0-9]{6}Z\\]\\[FATAL\\]: "
+    "caught ([A-Z]+)( at address 0x[0-9a-f]+)?\n");
+} // namespace detail
+
+TEST_CASE("The crash handler writes buffered records and a final record", "[log]")
+{
+    auto status = detail::crash<0>("segv", false, []() {
+        volatile int* volatile address = nullptr;
+        *address = 42;
+    });
+
+    REQUIRE(WIFSIGNALED(status));
+    REQUIRE(WTERMSIG(status) == SIGSEGV);
+
+    const std::string buffered = "record 0\nrecord 1\nrecord 2\n";
+
+    auto log = detail::read(detail::directory() + "/segv.log");
+    REQUIRE(log.compare(0, buffered.size(), buffered) == 0);
+
+    auto final_record = log.substr(buffered.size());
+    REQUIRE(std::regex_match(final_record, detail::fatal_record));
+    REQUIRE(final_record.find("caught SIGSEGV at address 0x0\n") != std::string::npos);
+
+    REQUIRE(detail::read(detail::directory() + "/segv.stderr") == final_record);
+}
+
+TEST_CASE("The crash handler reports aborts with a backtrace", "[log]")
+{
+    auto status = detail::crash<1>("abort", true, []() { std::abort(); });
+
+    REQUIRE(WIFSIGNALED(status));
+    REQUIRE(WTERMSIG(status) == SIGABRT);
+
+    const std::string buffered = "record 0\nrecord 1\nrecord 2\n";
+
+    auto log = detail::read(detail::directory() + "/abort.log");
+    REQUIRE(log.compare(0, buffered.size(), buffered) == 0);
+
+    auto final_record = log.substr(buffered.size());
+    REQUIRE(std::regex_match(final_record, detail::fatal_record));
+    REQUIRE(final_record.find("caught SIGABRT\n") != std::string::npos);
+
+    auto stderr_output = detail::read(detail::directory() + "/abort.stderr");
+    REQUIRE(stderr_output.compare(0, final_record.size(), final_record) == 0);
+#if defined(__GLIBC__)
+    // the backtrace follows the record
+    REQUIRE(stderr_output.size() > final_record.size());
+#endif
+}
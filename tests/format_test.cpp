@@ -4,7 +4,10 @@
 #include <nitro/except/raise.hpp>
 #include <nitro/format/format.hpp>
 
+#include <chrono>
+#include <limits>
 #include <sstream>
+#include <string>
 
 TEST_CASE("Simple format strings", "[format]")
 {
@@ -155,3 +158,197 @@ TEST_CASE("Format can be used in exptions and raise")
             "This is an exception formatted with nitro::format");
     }
 }
+
+namespace
+{
+struct point
+{
+    int x, y;
+};
+
+std::ostream& operator<<(std::ostream& s, const point& p)
+{
+    return s << '(' << p.x << ", " << p.y << ')';
+}
+} // namespace
+
+TEST_CASE("Arguments are rendered like an ostream would", "[format]")
+{
+    SECTION("integers")
+    {
+        std::string out = "{} {} {} {}"_nf % 0 % -17 % std::numeric_limits<long long>::min() %
+                          std::numeric_limits<unsigned long>::max();
+
+        std::stringstream ref;
+        ref << 0 << ' ' << -17 << ' ' << std::numeric_limits<long long>::min() << ' '
+            << std::numeric_limits<unsigned long>::max();
+
+        REQUIRE(out == ref.str());
+    }
+
+    SECTION("floating point numbers")
+    {
+        std::string out = "{} {} {} {}"_nf % 0.5 % 1e100 % -3.0f % 123456789.0;
+
+        REQUIRE(out == "0.5 1e+100 -3 1.23457e+08");
+    }
+
+    SECTION("characters, bools and strings")
+    {
+        std::string world = "World";
+        std::string out = "{}{} {} {}"_nf % 'H' % "ello" % world % true;
+
+        REQUIRE(out == "Hello World 1");
+    }
+
+    SECTION("user types with an operator<<")
+    {
+        std::string out = "p = {}"_nf % point{ 1, 2 };
+
+        REQUIRE(out == "p = (1, 2)");
+    }
+
+    SECTION("wide format strings")
+    {
+        std::wstring out = L"{} {}"_nf % L"answer" % 42;
+
+        REQUIRE(out == L"answer 42");
+    }
+}
+
+TEST_CASE("Format strings are parsed in a single pass", "[format]")
+{
+    SECTION("runtime format strings are owned by the formatter")
+    {
+        auto fmt = [] {
+            std::string format_str = "Hello {}";
+            return nitro::format(format_str);
+        }();
+
+        fmt % "World";
+
+        REQUIRE(fmt.str() == "Hello World");
+    }
+
+    SECTION("formatters can be copied halfway through")
+    {
+        auto fmt = "{} + {}"_nf % 1;
+        auto copy = fmt;
+
+        fmt % 2;
+        copy % 3;
+
+        REQUIRE(fmt.str() == "1 + 2");
+        REQUIRE(copy.str() == "1 + 3");
+    }
+
+    SECTION("str() can be called repeatedly")
+    {
+        auto fmt = "{} {}!"_nf % "Hello" % "World";
+
+        REQUIRE(fmt.str() == "Hello World!");
+        REQUIRE(fmt.str() == "Hello World!");
+    }
+
+    SECTION("printing to an ostream checks the arguments")
+    {
+        std::stringstream s;
+
+        REQUIRE_THROWS(s << ("{} {}"_nf % 1));
+    }
+}
+
+TEST_CASE("Placeholders are counted at compile time", "[format]")
+{
+    static_assert(nitro::detail::count_placeholders("no placeholders") == 0, "");
+    static_assert(nitro::detail::count_placeholders("{ {}, {}, {} }") == 3, "");
+    static_assert(nitro::detail::count_placeholders("{}}") == 1, "");
+
+    SECTION("NITRO_FORMAT formats like nitro::format")
+    {
+        std::string out = NITRO_FORMAT("Hello {} {}, the answer is {}!", 8, "world", 42);
+
+        REQUIRE(out == "Hello 8 world, the answer is 42!");
+    }
+
+    SECTION("NITRO_FORMAT works without arguments")
+    {
+        std::string out = NITRO_FORMAT("Hello World");
+
+        REQUIRE(out == "Hello World");
+    }
+}
+
+TEST_CASE("Format specifications", "[format]")
+{
+    SECTION("integers can be printed in other bases")
+    {
+        std::string out = "{:x} {:X} {:o} {:b} {:d}"_nf % 255 % 255u % 8 % 5 % -3;
+
+        REQUIRE(out == "ff FF 10 101 -3");
+    }
+
+    SECTION("floating point numbers take a precision and a type")
+    {
+        std::string out = "{:.3f} {:.2e} {:.3} {:f}"_nf % 3.14159 % 1234.5 % (2.0 / 3) % 0.5;
+
+        REQUIRE(out == "3.142 1.23e+03 0.667 0.500000");
+    }
+
+    SECTION("r gives the shortest representation which parses back to the same value")
+    {
+        std::string out = "{:r} {:r} {:r}"_nf % 0.1 % (0.1 + 0.2) % 2.5f;
+
+        REQUIRE(out == "0.1 0.30000000000000004 2.5");
+    }
+
+    SECTION("width, fill and alignment")
+    {
+        std::string out = "[{:>5}][{:5}][{:<4}][{:^7}][{:*^6}][{:0>4x}]"_nf % "ab" % 42 % 7 % "mid" %
+                          "x" % 10;
+
+        REQUIRE(out == "[   ab][   42][7   ][  mid  ][**x***][000a]");
+    }
+
+    SECTION("precision truncates strings")
+    {
+        std::string out = "{:.3}"_nf % "abcdef";
+
+        REQUIRE(out == "abc");
+    }
+
+    SECTION("system_clock time points are ISO-8601 timestamps")
+    {
+        using std::chrono::system_clock;
+
+        system_clock::time_point leap_day(std::chrono::seconds(951782400));
+        auto time_point = system_clock::time_point(std::chrono::seconds(1700000000)) +
+                          std::chrono::duration_cast<system_clock::duration>(
+                              std::chrono::milliseconds(123));
+
+        std::string out = "{} {:.3} {:.0}"_nf % leap_day % time_point % time_point;
+
+        REQUIRE(out == "2000-02-29T00:00:00.000000Z 2023-11-14T22:13:20.123Z "
+                       "2023-11-14T22:13:20Z");
+
+        REQUIRE(("{:.0}"_nf % system_clock::time_point(std::chrono::seconds(-1))).str() ==
+                "1969-12-31T23:59:59Z");
+    }
+
+    SECTION("invalid specifications throw")
+    {
+        REQUIRE_THROWS(nitro::format("{:q}") % 1);
+        REQUIRE_THROWS(nitro::format("{:x}") % "string");
+        REQUIRE_THROWS(nitro::format("{:.}") % 1.0);
+        REQUIRE_THROWS(nitro::format("{:5.3fx}") % 1.0);
+    }
+
+    SECTION("braces without a closing brace are literals")
+    {
+        std::string out = "{:x {}"_nf % 1;
+
+        REQUIRE(out == "{:x 1");
+    }
+
+    static_assert(nitro::detail::count_placeholders("{:x} {:>8} {} {:") == 3, "");
+}
@@ -0,0 +1,130 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include <nitro/log/attribute/interned_tag.hpp>
+#include <nitro/log/attribute/severity.hpp>
+#include <nitro/log/attribute/timestamp.hpp>
+#include <nitro/log/filter/tag_severity_filter.hpp>
+#include <nitro/log/formatter/binary.hpp>
+#include <nitro/log/formatter/binary_decoder.hpp>
+#include <nitro/log/formatter/text.hpp>
+#include <nitro/log/log.hpp>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace detail
+{
+
+typedef nitro::log::record<nitro::log::interned_tag_attribute, nitro::log::message_attribute,
+                           nitro::log::severity_attribute,
+                           nitro::log::timestamp_clock_attribute<std::chrono::steady_clock>>
+    record;
+
+template <unsigned N>
+class capturing_sink
+{
+public:
+    static std::vector<std::string>& records()
+    {
+        static std::vector<std::string> records_;
+        return records_;
+    }
+
+    void sink(nitro::log::severity_level, nitro::lang::string_ref formatted_record)
+    {
+        records().emplace_back(formatted_record);
+    }
+};
+
+template <typename Record>
+using log_filter = nitro::log::filter::tag_severity_filter<Record>;
+} // namespace detail
+
+using text_logging = nitro::log::logger<detail::record, nitro::log::formatter::text_formatter,
+                                        detail::capturing_sink<0>, detail::log_filter>;
+
+using binary_logging =
+    nitro::log::logger<detail::record, nitro::log::formatter::binary_formatter,
+                       detail::capturing_sink<1>, detail::log_filter>;
+
+using filter = detail::log_filter<detail::record>;
+using nitro::log::severity_level;
+
+TEST_CASE("Interned tags keep only the id of the tag", "[log]")
+{
+    nitro::log::interned_tag_attribute first;
+    nitro::log::interned_tag_attribute second;
+
+    REQUIRE(first.interned_tag() == nitro::log::invalid_tag_id);
+    REQUIRE(first.tag().empty());
+
+    first.set_tag("interned");
+    second.set_tag(std::string("interned"));
+
+    REQUIRE(first.interned_tag() != nitro::log::invalid_tag_id);
+    REQUIRE(first.interned_tag() == second.interned_tag());
+    REQUIRE(first.tag() == "interned");
+    // both refer to the string in the tag table
+    REQUIRE(&first.tag() == &second.tag());
+}
+
+TEST_CASE("Interned tags are formatted as text", "[log]")
+{
+    auto& records = detail::capturing_sink<0>::records();
+    records.clear();
+
+    text_logging::info("net") << "with tag";
+    text_logging::info() << "without tag";
+
+    REQUIRE(records.size() == 2);
+    REQUIRE(records[0].find("][net][ INFO]: with tag\n") != std::string::npos);
+    REQUIRE(records[1].find("][ INFO]: without tag\n") != std::string::npos);
+}
+
+TEST_CASE("Interned tags are filtered by their id", "[log]")
+{
+    auto& records = detail::capturing_sink<0>::records();
+    records.clear();
+
+    filter::configure("warn,db=debug");
+
+    REQUIRE(filter::min_severity(nitro::log::intern_tag("db")) == severity_level::debug);
+    REQUIRE(filter::min_severity(nitro::log::invalid_tag_id) == severity_level::warn);
+
+    text_logging::debug("db") << "passes";
+    text_logging::debug("net") << "filtered";
+    text_logging::debug() << "filtered";
+
+    // the record filter sees the interned tag, even if the pre_filter is bypassed
+    detail::record r;
+    r.set_tag("db");
+    r.severity() = severity_level::debug;
+    REQUIRE(filter().filter(r));
+    r.set_tag("net");
+    REQUIRE(!filter().filter(r));
+
+    filter::configure("trace");
+
+    REQUIRE(records.size() == 1);
+    REQUIRE(records[0].find("[db][DEBUG]: passes") != std::string::npos);
+}
+
+TEST_CASE("Interned tags are written as id by the binary formatter", "[log]")
+{
+    auto& records = detail::capturing_sink<1>::records();
+    records.clear();
+
+    binary_logging::warn("binary") << "tagged";
+
+    REQUIRE(records.size() == 1);
+
+    nitro::log::formatter::binary_decoder decoder;
+    decoder.define(records[0].data(), records[0].size());
+
+    std::ostringstream text;
+    decoder.decode(records[0].data(), records[0].size(), text);
+
+    REQUIRE(text.str().find("[binary][ WARN]: tagged\n") != std::string::npos);
+}
@@ -0,0 +1,167 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include <nitro/log/attribute/call_site.hpp>
+#include <nitro/log/attribute/severity.hpp>
+#include <nitro/log/attribute/timestamp.hpp>
+#include <nitro/log/filter/null_filter.hpp>
+#include <nitro/log/formatter/json.hpp>
+#include <nitro/log/log.hpp>
+
+#include <chrono>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace detail
+{
+
+class job_attribute
+{
+public:
+    int& job()
+    {
+        return job_;
+    }
+
+    int job() const
+    {
+        return job_;
+    }
+
+private:
+    int job_ = 0;
+};
+
+typedef nitro::log::record<nitro::log::timestamp_clock_attribute<std::chrono::system_clock>,
+                           nitro::log::severity_attribute, nitro::log::tag_attribute,
+                           nitro::log::message_attribute>
+    record;
+
+typedef nitro::log::record<nitro::log::message_attribute, job_attribute,
+                           nitro::log::timestamp_clock_attribute<std::chrono::steady_clock>>
+    job_record;
+
+typedef nitro::log::record<nitro::log::severity_attribute, nitro::log::call_site_attribute,
+                           nitro::log::message_attribute,
+                           nitro::log::timestamp_clock_attribute<std::chrono::system_clock>>
+    call_site_record;
+
+class capturing_sink
+{
+public:
+    static std::vector<std::string>& records()
+    {
+        static std::vector<std::string> records_;
+        return records_;
+    }
+
+    void sink(nitro::log::severity_level, nitro::lang::string_ref formatted_record)
+    {
+        records().emplace_back(formatted_record);
+    }
+};
+
+template <typename Record>
+std::string format(Record& r)
+{
+    std::stringstream s;
+    nitro::log::formatter::json_formatter<Record>().format(r, s);
+    return s.str();
+}
+} // namespace detail
+
+namespace nitro
+{
+namespace log
+{
+    namespace formatter
+    {
+        template <>
+        struct json_attribute<::detail::job_attribute>
+        {
+            template <typename Record>
+            static void write(const Record& r, json_writer& w)
+            {
+                w.key(",\"job\":");
+                w.number(r.job());
+            }
+        };
+    } // namespace formatter
+} // namespace log
+} // namespace nitro
+
+using logging = nitro::log::logger<detail::call_site_record, nitro::log::formatter::json_formatter,
+                                   detail::capturing_sink, nitro::log::filter::null_filter>;
+
+TEST_CASE("The JSON formatter", "[log]")
+{
+    SECTION("writes the attributes in the order of the record")
+    {
+        detail::record r;
+        r.timestamp() = std::chrono::system_clock::time_point(std::chrono::seconds(1700000000));
+        r.severity() = nitro::log::severity_level::warn;
+        r.tag() = "net";
+        r.message() = "Hello World";
+
+        REQUIRE(detail::format(r) == "{\"timestamp\":\"2023-11-14T22:13:20.000000Z\","
+                                     "\"severity\":\"warn\",\"tag\":\"net\","
+                                     "\"message\":\"Hello World\"}\n");
+    }
+
+    SECTION("leaves out empty tags")
+    {
+        detail::record r;
+        r.timestamp() = std::chrono::system_clock::time_point(std::chrono::seconds(1700000000));
+        r.severity() = nitro::log::severity_level::fatal;
+        r.message() = "Hello World";
+
+        REQUIRE(detail::format(r) == "{\"timestamp\":\"2023-11-14T22:13:20.000000Z\","
+                                     "\"severity\":\"fatal\",\"message\":\"Hello World\"}\n");
+    }
+
+    SECTION("escapes strings")
+    {
+        detail::record r;
+        r.severity() = nitro::log::severity_level::info;
+        r.tag() = "a\"b";
+        const auto message = std::string("quote \" backslash \\ newline \n tab \t bell ") +
+                             "\x07 nul " + '\0' + " \xc3\xa4";
+        r.message() = message;
+
+        auto json = detail::format(r);
+
+        REQUIRE(json.find("\"tag\":\"a\\\"b\"") != std::string::npos);
+        REQUIRE(json.find("\"message\":\"quote \\\" backslash \\\\ newline \\n tab \\t bell "
+                          "\\u0007 nul \\u0000 \xc3\xa4\"}\n") != std::string::npos);
+        REQUIRE(json.find('\n') == json.size() - 1);
+    }
+
+    SECTION("writes the ticks of other clocks and attributes with a json_attribute")
+    {
+        detail::job_record r;
+        r.message() = "";
+        r.job() = -12;
+        r.timestamp() =
+            std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(42));
+
+        REQUIRE(detail::format(r) == "{\"message\":\"\",\"job\":-12,\"timestamp\":42}\n");
+    }
+
+    SECTION("can be used with a logger")
+    {
+        auto& records = detail::capturing_sink::records();
+        records.clear();
+
+        NITRO_LOG_TAG(logging, error, "") << "value " << 42;
+
+        REQUIRE(records.size() == 1);
+        REQUIRE(std::regex_match(
+            records[0],
+            std::regex("\\{\"severity\":\"error\",\"file\":\"[^\"]*json_formatter_test\\.cpp\","
+                       "\"line\":[0-9]+,\"function\":\"C_A_T_C_H_T_E_S_T_[0-9]+\","
+                       "\"message\":\"value 42\","
+                       "\"timestamp\":\"[0-9]{4}-[0-9]{2}-[0-9]{2}T[0-9:.]+Z\"\\}\n")));
+    }
+}
@@ -0,0 +1,186 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include <nitro/log/attribute/severity.hpp>
+#include <nitro/log/attribute/timestamp.hpp>
+#include <nitro/log/filter/severity_filter.hpp>
+#include <nitro/log/log.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// GCC does not see that the replaced operator new below uses malloc() and warns about the free()
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+namespace
+{
+std::atomic<std::size_t> allocations{ 0 };
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace detail
+{
+
+typedef nitro::log::record<nitro::log::tag_attribute, nitro::log::message_attribute,
+                           nitro::log::severity_attribute, nitro::log::timestamp_attribute>
+    record;
+
+template <typename Record>
+class stream_formater
+{
+public:
+    void format(Record& r, std::ostream& s)
+    {
+        s << '[' << r.timestamp().time_since_epoch().count() << "][" << r.tag() << "]["
+          << r.severity() << "]: " << r.message() << '\n';
+    }
+};
+
+class counting_sink
+{
+public:
+    static std::size_t& bytes()
+    {
+        static std::size_t bytes_ = 0;
+        return bytes_;
+    }
+
+    void sink(nitro::log::severity_level, nitro::lang::string_ref formatted_record)
+    {
+        bytes() += formatted_record.size();
+    }
+};
+
+template <typename Record>
+class message_formater
+{
+public:
+    std::string format(Record& r)
+    {
+        return r.message();
+    }
+};
+
+class capturing_sink
+{
+public:
+    static std::vector<std::string>& records()
+    {
+        static std::vector<std::string> records_;
+        return records_;
+    }
+
+    void sink(nitro::log::severity_level, nitro::lang::string_ref formatted_record)
+    {
+        records().emplace_back(formatted_record);
+    }
+};
+
+template <typename Record>
+using log_filter = nitro::log::filter::severity_filter<Record>;
+} // namespace detail
+
+using logging =
+    nitro::log::logger<detail::record, detail::stream_formater, detail::counting_sink,
+                       detail::log_filter>;
+
+using capturing =
+    nitro::log::logger<detail::record, detail::message_formater, detail::capturing_sink,
+                       detail::log_filter>;
+
+template <typename F>
+std::size_t count_allocations(F f)
+{
+    auto before = allocations.load();
+    f();
+    return allocations.load() - before;
+}
+
+TEST_CASE("Enabled log statements do not allocate in steady state", "[log]")
+{
+    const std::string long_message(4000, 'x');
+
+    auto log_some = [&long_message]() {
+        for (int i = 0; i < 100; ++i)
+        {
+            logging::info("tag") << "value " << i << " of " << 3.5 << ' ' << std::hex << i;
+            logging::warn() << long_message;
+        }
+    };
+
+    // let the thread-local buffers grow to their final size
+    log_some();
+
+    REQUIRE(count_allocations(log_some) == 0);
+    REQUIRE(detail::counting_sink::bytes() > 0);
+}
+
+TEST_CASE("Filtered log statements do not allocate", "[log]")
+{
+    detail::log_filter<detail::record>::set_severity(nitro::log::severity_level::error);
+
+    REQUIRE(count_allocations([]() {
+                for (int i = 0; i < 100; ++i)
+                {
+                    logging::info("tag") << "value " << i;
+                }
+            }) == 0);
+
+    detail::log_filter<detail::record>::set_severity(nitro::log::severity_level::trace);
+}
+
+TEST_CASE("Nested log statements get their own buffers", "[log]")
+{
+    auto& records = detail::capturing_sink::records();
+    records.clear();
+
+    {
+        auto outer = capturing::info();
+        outer << "outer " << [&]() {
+            capturing::info() << "inner";
+            return std::string("done");
+        };
+    }
+
+    REQUIRE(records.size() == 2);
+    REQUIRE(records[0] == "inner");
+    REQUIRE(records[1] == "outer done");
+}
+
+TEST_CASE("Stream state does not leak into the next log statement", "[log]")
+{
+    auto& records = detail::capturing_sink::records();
+    records.clear();
+
+    capturing::info() << std::hex << 255;
+    capturing::info() << 255;
+
+    REQUIRE(records.size() == 2);
+    REQUIRE(records[0] == "ff");
+    REQUIRE(records[1] == "255");
+}
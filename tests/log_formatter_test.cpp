@@ -0,0 +1,88 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include <nitro/log/attribute/severity.hpp>
+#include <nitro/log/attribute/timestamp.hpp>
+#include <nitro/log/filter/null_filter.hpp>
+#include <nitro/log/formatter/text.hpp>
+#include <nitro/log/log.hpp>
+
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace detail
+{
+
+typedef nitro::log::record<nitro::log::tag_attribute, nitro::log::message_attribute,
+                           nitro::log::severity_attribute,
+                           nitro::log::timestamp_clock_attribute<std::chrono::system_clock>>
+    record;
+
+typedef nitro::log::record<nitro::log::message_attribute,
+                           nitro::log::timestamp_clock_attribute<std::chrono::steady_clock>>
+    steady_record;
+
+class capturing_sink
+{
+public:
+    static std::vector<std::string>& records()
+    {
+        static std::vector<std::string> records_;
+        return records_;
+    }
+
+    void sink(nitro::log::severity_level, nitro::lang::string_ref formatted_record)
+    {
+        records().emplace_back(formatted_record);
+    }
+};
+} // namespace detail
+
+using logging = nitro::log::logger<detail::record, nitro::log::formatter::text_formatter,
+                                   detail::capturing_sink, nitro::log::filter::null_filter>;
+
+TEST_CASE("The text formatter", "[log]")
+{
+    SECTION("prints all attributes of a record")
+    {
+        detail::record r;
+        r.timestamp() = std::chrono::system_clock::time_point(std::chrono::seconds(1700000000));
+        r.tag() = "net";
+        r.severity() = nitro::log::severity_level::warn;
+        r.message() = "Hello World";
+
+        std::stringstream s;
+        nitro::log::formatter::text_formatter<detail::record>().format(r, s);
+
+        REQUIRE(s.str() == "[2023-11-14T22:13:20.000000Z][net][ WARN]: Hello World\n");
+    }
+
+    SECTION("leaves out empty tags and missing attributes")
+    {
+        detail::steady_record r;
+        r.timestamp() =
+            std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(42));
+        r.message() = "Hello World";
+
+        std::stringstream s;
+        nitro::log::formatter::text_formatter<detail::steady_record>().format(r, s);
+
+        REQUIRE(s.str() == "[42]: Hello World\n");
+    }
+
+    SECTION("can be used with a logger")
+    {
+        auto& records = detail::capturing_sink::records();
+        records.clear();
+
+        logging::error() << "value " << 42;
+
+        REQUIRE(records.size() == 1);
+        // the timestamp is "[YYYY-MM-DDTHH:MM:SS.ffffffZ]"
+        REQUIRE(records[0].size() == 29 + 18);
+        REQUIRE(records[0][11] == 'T');
+        REQUIRE(records[0].substr(29) == "[ERROR]: value 42\n");
+    }
+}
@@ -243,6 +243,48 @@ TEST_CASE("Logging lambdas works", "[log]")
     }
 }
 
+TEST_CASE("Lazy arguments and NITRO_LOG work", "[log]")
+{
+    int evaluated = 0;
+    auto count = [&evaluated]() { return ++evaluated; };
+
+    SECTION("Callables returning any value are lazy")
+    {
+        logging::info() << count;
+        logging::debug() << count;
+
+        CHECK(evaluated == 1);
+    }
+
+    SECTION("NITRO_LOG does not evaluate the arguments of filtered statements")
+    {
+        NITRO_LOG(logging, info) << "test 43 " << count();
+        NITRO_LOG(logging, debug) << "test 44 " << count();
+        NITRO_LOG_TAG(logging, warn, "test tag") << "test 45 " << count();
+
+        CHECK(evaluated == 2);
+
+        detail::log_filter<detail::record>::set_severity(nitro::log::severity_level::error);
+
+        NITRO_LOG(logging, warn) << "test 46 " << count();
+        NITRO_LOG(logging, error) << "test 47 " << count();
+
+        detail::log_filter<detail::record>::set_severity(nitro::log::severity_level::trace);
+
+        CHECK(evaluated == 3);
+    }
+
+    SECTION("NITRO_LOG can be used as the body of an if statement")
+    {
+        if (evaluated == 0)
+            NITRO_LOG(logging, info) << "test 48 " << count();
+        else
+            ++evaluated;
+
+        CHECK(evaluated == 1);
+    }
+}
+
 int main(int argc, char** argv)
 {
     nitro::log::sink::Logfile::log_file() = "test_log.txt";
@@ -0,0 +1,256 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include <nitro/log/attribute/severity.hpp>
+#include <nitro/log/attribute/timestamp.hpp>
+#include <nitro/log/filter/dedupe.hpp>
+#include <nitro/log/filter/metered.hpp>
+#include <nitro/log/filter/severity_filter.hpp>
+#include <nitro/log/formatter/metered.hpp>
+#include <nitro/log/log.hpp>
+#include <nitro/log/metrics.hpp>
+#include <nitro/log/sink/metered.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace detail
+{
+
+typedef nitro::log::record<nitro::log::tag_attribute, nitro::log::message_attribute,
+                           nitro::log::severity_attribute, nitro::log::timestamp_attribute>
+    record;
+
+template <typename Record>
+class stream_formater
+{
+public:
+    void format(Record& r, std::ostream& s)
+    {
+        s << r.message();
+    }
+};
+
+template <typename Record>
+class string_formater
+{
+public:
+    std::string format(Record& r)
+    {
+        return r.tag() + ":" + r.message().str();
+    }
+};
+
+class capturing_sink
+{
+public:
+    static std::vector<std::string>& records()
+    {
+        static std::vector<std::string> records_;
+        return records_;
+    }
+
+    void sink(nitro::log::severity_level, nitro::lang::string_ref formatted_record)
+    {
+        records().emplace_back(formatted_record);
+    }
+};
+
+template <typename Record>
+using log_filter = nitro::log::filter::severity_filter<Record>;
+
+using metered_filter = nitro::log::filter::metered<log_filter>;
+using metered_formatter = nitro::log::formatter::metered<stream_formater>;
+using metered_sink = nitro::log::sink::metered<capturing_sink>;
+
+using logging =
+    nitro::log::logger<record, metered_formatter::type, metered_sink, metered_filter::type>;
+
+using reporting = nitro::log::logger<record, string_formater, capturing_sink, log_filter>;
+
+template <typename Record>
+using dedupe_filter = nitro::log::filter::dedupe<Record, 1>;
+
+using metered_dedupe = nitro::log::filter::metered<dedupe_filter>;
+
+using dedupe_logging =
+    nitro::log::logger<record, stream_formater, capturing_sink, metered_dedupe::type>;
+
+struct domain;
+} // namespace detail
+
+using nitro::log::severity_level;
+
+TEST_CASE("Latency histogram buckets have a relative width of 1/16", "[log]")
+{
+    using histogram = nitro::log::latency_histogram;
+    const std::size_t bucket_count = histogram::bucket_count;
+
+    std::size_t last = 0;
+    for (std::uint64_t ns = 0; ns < 100000; ns += 7)
+    {
+        auto bucket = histogram::bucket_of(ns);
+        REQUIRE(bucket >= last);
+        REQUIRE(bucket < bucket_count);
+        REQUIRE(histogram::bucket_max(bucket) >= ns);
+        REQUIRE(histogram::bucket_max(bucket) - ns <= ns / 16);
+        last = bucket;
+    }
+
+    REQUIRE(histogram::bucket_of(31) == 31);
+    REQUIRE(histogram::bucket_max(histogram::bucket_of(1000)) == 1023);
+    REQUIRE(histogram::bucket_of(static_cast<std::uint64_t>(-1)) == bucket_count - 1);
+
+    std::array<std::uint64_t, histogram::bucket_count> buckets = {};
+    buckets[histogram::bucket_of(10)] = 98;
+    buckets[histogram::bucket_of(1000)] = 2;
+    histogram h(buckets, 98 * 10 + 2 * 1000);
+
+    REQUIRE(h.count() == 100);
+    REQUIRE(h.mean().count() == 29);
+    REQUIRE(h.percentile(0.5).count() == 10);
+    REQUIRE(h.percentile(0.99).count() == 1023);
+    REQUIRE(h.max().count() == 1023);
+    REQUIRE(histogram().percentile(0.5).count() == 0);
+}
+
+TEST_CASE("Sharded counters sum the counters of all threads", "[log]")
+{
+    using counters = nitro::log::detail::sharded_counters<detail::domain, 2>;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([]() {
+            for (int i = 0; i < 1000; ++i)
+            {
+                counters::add(0);
+                counters::add(1, 2);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    counters::add(0);
+
+    auto values = counters::values();
+    REQUIRE(values[0] == 4001);
+    REQUIRE(values[1] == 8000);
+}
+
+TEST_CASE("Metered adapters count records, bytes and latencies", "[log]")
+{
+    detail::metered_filter::config().name = "records";
+    detail::metered_formatter::config().name = "format";
+    detail::metered_sink::config().name = "capture";
+    detail::log_filter<detail::record>::set_severity(severity_level::info);
+
+    using filter = detail::metered_filter::type<detail::record>;
+
+    for (int i = 0; i < 10; ++i)
+    {
+        detail::logging::debug("net") << "debug " << i;
+        detail::logging::info("net") << "info " << i;
+        detail::logging::warn("io") << "warn " << i;
+    }
+    detail::logging::error() << "error";
+
+    REQUIRE(detail::capturing_sink::records().size() == 21);
+
+    REQUIRE(filter::written(severity_level::debug) == 0);
+    REQUIRE(filter::written(severity_level::info) == 10);
+    REQUIRE(filter::written(severity_level::warn) == 10);
+    REQUIRE(filter::written(severity_level::error) == 1);
+    REQUIRE(filter::rejected(severity_level::debug) == 10);
+    REQUIRE(filter::rejected(severity_level::info) == 0);
+
+    auto tags = filter::written_by_tag();
+    REQUIRE(tags.size() == 2);
+    REQUIRE(tags[0].first == "net");
+    REQUIRE(tags[0].second == 10);
+    REQUIRE(tags[1].first == "io");
+    REQUIRE(tags[1].second == 10);
+
+    REQUIRE(detail::metered_formatter::latency().count() == 21);
+    REQUIRE(detail::metered_sink::records() == 21);
+    // "info 0" to "info 9", "warn 0" to "warn 9" and "error"
+    REQUIRE(detail::metered_sink::bytes() == 20 * 6 + 5);
+    REQUIRE(detail::metered_sink::latency().count() == 21);
+
+    std::stringstream metrics;
+    nitro::log::write_metrics(metrics);
+
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(metrics, line);)
+    {
+        lines.push_back(line);
+    }
+
+    // in the order the logger constructs its sink, formatter and filter
+    REQUIRE(lines.size() == 3);
+    REQUIRE(lines[0].compare(0, 43, "capture: records 21 bytes 125 latency count") == 0);
+    REQUIRE(lines[1].compare(0, 17, "format: count 21 ") == 0);
+    REQUIRE(lines[2] == "records: written trace 0 debug 0 info 10 warn 10 error 1 fatal 0 "
+                        "rejected trace 0 debug 10 info 0 warn 0 error 0 fatal 0 "
+                        "tags net 10 io 10");
+
+    detail::capturing_sink::records().clear();
+    nitro::log::metrics_reporter<detail::reporting>::report();
+
+    auto& reported = detail::capturing_sink::records();
+    REQUIRE(reported.size() == 3);
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        REQUIRE(reported[i] == "nitro.metrics:" + lines[i]);
+    }
+}
+
+TEST_CASE("Metrics reporter logs the metrics once more when destroyed", "[log]")
+{
+    // constructs the metered adapters, if this test runs alone
+    detail::logging::instance();
+    detail::capturing_sink::records().clear();
+
+    {
+        nitro::log::metrics_reporter<detail::reporting> reporter(std::chrono::hours(1));
+    }
+
+    auto& reported = detail::capturing_sink::records();
+    REQUIRE(reported.size() == 3);
+    REQUIRE(reported[0].compare(0, 23, "nitro.metrics:capture: ") == 0);
+}
+
+TEST_CASE("Metered filter counts the records written before others on their own", "[log]")
+{
+    detail::metered_dedupe::config().name = "dedupe";
+    detail::capturing_sink::records().clear();
+
+    using filter = detail::metered_dedupe::type<detail::record>;
+
+    detail::dedupe_logging::warn("net") << "again";
+    detail::dedupe_logging::warn("net") << "again";
+    detail::dedupe_logging::warn("net") << "again";
+    detail::dedupe_logging::info("io") << "other";
+
+    REQUIRE(detail::capturing_sink::records() ==
+            std::vector<std::string>{ "again", "last message repeated 2 times", "other" });
+
+    REQUIRE(filter::written(severity_level::warn) == 1);
+    REQUIRE(filter::rejected(severity_level::warn) == 2);
+    REQUIRE(filter::written(severity_level::info) == 1);
+    REQUIRE(filter::preceding() == 1);
+
+    auto tags = filter::written_by_tag();
+    REQUIRE(tags.size() == 2);
+    REQUIRE(tags[0].second == 1);
+    REQUIRE(tags[1].second == 1);
+}
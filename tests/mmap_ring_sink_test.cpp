@@ -0,0 +1,213 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "test_directory.hpp"
+
+#include <nitro/log/attribute/severity.hpp>
+#include <nitro/log/attribute/timestamp.hpp>
+#include <nitro/log/filter/null_filter.hpp>
+#include <nitro/log/formatter/binary.hpp>
+#include <nitro/log/formatter/binary_decoder.hpp>
+#include <nitro/log/log.hpp>
+#include <nitro/log/sink/mmap_ring.hpp>
+#include <nitro/log/sink/mmap_ring_reader.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+extern "C"
+{
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+}
+
+namespace detail
+{
+
+typedef nitro::log::record<nitro::log::message_attribute, nitro::log::severity_attribute,
+                           nitro::log::timestamp_attribute>
+    record;
+
+template <typename Record>
+class line_formater
+{
+public:
+    std::string format(Record& r)
+    {
+        return r.message().str() + "\n";
+    }
+};
+
+template <unsigned N>
+using logging = nitro::log::logger<record, line_formater, nitro::log::sink::mmap_ring<N>,
+                                   nitro::log::filter::null_filter>;
+
+template <unsigned N>
+using binary_logging =
+    nitro::log::logger<record, nitro::log::formatter::binary_formatter,
+                       nitro::log::sink::mmap_ring<N>, nitro::log::filter::null_filter>;
+
+// runs f in a child process and returns how the child ended
+template <typename F>
+int in_child(F f)
+{
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        f();
+        _exit(0);
+    }
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return status;
+}
+} // namespace detail
+
+using nitro::log::sink::mmap_ring;
+using nitro::log::sink::mmap_ring_reader;
+
+TEST_CASE("Ring buffer sink keeps records in order", "[log]")
+{
+    mmap_ring<0>::config().path = detail::directory() + "/ordered.ring";
+
+    for (int i = 0; i < 10; ++i)
+    {
+        detail::logging<0>::info() << "record " << i;
+    }
+
+    mmap_ring_reader reader(mmap_ring<0>::config().path);
+    auto records = reader.records();
+
+    REQUIRE(records.size() == 10);
+    for (int i = 0; i < 10; ++i)
+    {
+        REQUIRE(records[i] == "record " + std::to_string(i) + "\n");
+    }
+    REQUIRE(reader.wraps() == 0);
+}
+
+TEST_CASE("Ring buffer sink overwrites the oldest records", "[log]")
+{
+    auto& config = mmap_ring<1>::config();
+    config.path = detail::directory() + "/wrapped.ring";
+    config.capacity = 4096;
+
+    const int count = 1000;
+    for (int i = 0; i < count; ++i)
+    {
+        // every 17th record is long, so frames do not line up with the end of the buffer
+        detail::logging<1>::info() << "record " << i << std::string(i % 17 == 0 ? 100 : 0, '.');
+    }
+
+    mmap_ring_reader reader(config.path);
+    REQUIRE(reader.capacity() == 4096);
+    REQUIRE(reader.wraps() > 0);
+
+    auto records = reader.records();
+    REQUIRE(records.size() > 50);
+    REQUIRE(records.size() < 4096 / 16);
+
+    // the newest records form an unbroken sequence
+    const int first = count - static_cast<int>(records.size());
+    for (std::size_t i = 0; i < records.size(); ++i)
+    {
+        int n = first + static_cast<int>(i);
+        REQUIRE(records[i] ==
+                "record " + std::to_string(n) + std::string(n % 17 == 0 ? 100 : 0, '.') + "\n");
+    }
+}
+
+TEST_CASE("Ring buffer sink keeps records of killed processes", "[log]")
+{
+    auto& config = mmap_ring<2>::config();
+    config.path = detail::directory() + "/killed.ring";
+
+    int status = detail::in_child([]() {
+        detail::logging<2>::info() << "before the crash";
+        kill(getpid(), SIGKILL);
+    });
+    REQUIRE(WIFSIGNALED(status));
+    REQUIRE(WTERMSIG(status) == SIGKILL);
+
+    // a restarted process continues the ring
+    detail::in_child([]() { detail::logging<2>::info() << "after the restart"; });
+
+    auto records = mmap_ring_reader(config.path).records();
+    REQUIRE(records == std::vector<std::string>{ "before the crash\n", "after the restart\n" });
+}
+
+TEST_CASE("Ring buffer sink keeps binary records decodable after wrapping", "[log]")
+{
+    auto& config = mmap_ring<4>::config();
+    config.path = detail::directory() + "/binary.ring";
+    config.capacity = 4096;
+
+    const int count = 1000;
+    for (int i = 0; i < count; ++i)
+    {
+        detail::binary_logging<4>::info() << "binary record " << i << " of the ring";
+    }
+
+    mmap_ring_reader reader(config.path);
+    REQUIRE(reader.wraps() > 2);
+
+    std::string data;
+    for (const auto& record : reader.records())
+    {
+        data += record;
+    }
+
+    nitro::log::formatter::binary_decoder decoder;
+    decoder.define(data.data(), data.size());
+
+    std::stringstream text;
+    REQUIRE(decoder.decode(data.data(), data.size(), text) == data.size());
+
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(text, line);)
+    {
+        REQUIRE(line.find("<undefined") == std::string::npos);
+        lines.push_back(line);
+    }
+    REQUIRE(lines.size() > 50);
+    REQUIRE(lines.back().substr(lines.back().find("]: ") + 3) ==
+            "binary record " + std::to_string(count - 1) + " of the ring");
+}
+
+TEST_CASE("Ring buffer reader skips incomplete records", "[log]")
+{
+    auto& config = mmap_ring<3>::config();
+    config.path = detail::directory() + "/torn.ring";
+
+    detail::logging<3>::info() << "first";
+    detail::logging<3>::info() << "second";
+    detail::logging<3>::info() << "third";
+
+    {
+        // clear the magic of the second frame, like a write interrupted by a crash
+        std::fstream file(config.path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(nitro::log::detail::mmap_ring_header_size +
+                   nitro::log::detail::mmap_ring_frame_size(6));
+        std::uint32_t zero = 0;
+        file.write(reinterpret_cast<const char*>(&zero), sizeof(zero));
+    }
+
+    auto records = mmap_ring_reader(config.path).records();
+    REQUIRE(records == std::vector<std::string>{ "first\n", "third\n" });
+}
+
+TEST_CASE("Ring buffer reader rejects other files", "[log]")
+{
+    auto path = detail::directory() + "/other.txt";
+    std::ofstream(path) << "this is not a ring buffer, but it is longer than its header would be";
+
+    REQUIRE_THROWS(mmap_ring_reader(path));
+    REQUIRE_THROWS(mmap_ring_reader(detail::directory() + "/missing.ring"));
+}
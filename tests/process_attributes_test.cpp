@@ -0,0 +1,70 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include <nitro/env/hostname.hpp>
+#include <nitro/env/process.hpp>
+#include <nitro/log/attribute/hostname.hpp>
+#include <nitro/log/attribute/pid.hpp>
+
+#include <thread>
+
+extern "C"
+{
+#include <sys/wait.h>
+#include <unistd.h>
+}
+
+TEST_CASE("pid_attribute has the ids of the creating thread", "[log]")
+{
+    nitro::log::pid_attribute main_attribute;
+
+    REQUIRE(main_attribute.pid() == nitro::env::get_pid());
+    REQUIRE(main_attribute.tid() == nitro::env::get_tid());
+
+    int other_pid = 0;
+    int other_tid = 0;
+    int other_env_tid = 0;
+    std::thread([&]() {
+        nitro::log::pid_attribute attribute;
+        other_pid = attribute.pid();
+        other_tid = attribute.tid();
+        other_env_tid = nitro::env::get_tid();
+    })
+        .join();
+
+    REQUIRE(other_pid == main_attribute.pid());
+    REQUIRE(other_tid == other_env_tid);
+#ifdef __linux__
+    REQUIRE(other_tid != main_attribute.tid());
+#endif
+}
+
+TEST_CASE("pid_attribute has the ids of the child after a fork", "[log]")
+{
+    nitro::log::pid_attribute parent;
+
+    auto child = fork();
+    REQUIRE(child != -1);
+
+    if (child == 0)
+    {
+        nitro::log::pid_attribute attribute;
+        bool ok = attribute.pid() == getpid() && attribute.pid() != parent.pid() &&
+                  attribute.tid() == nitro::env::get_tid();
+        _exit(ok ? 0 : 1);
+    }
+
+    int status;
+    REQUIRE(waitpid(child, &status, 0) == child);
+    REQUIRE(WIFEXITED(status));
+    REQUIRE(WEXITSTATUS(status) == 0);
+}
+
+TEST_CASE("hostname_attribute refers to the same cached name", "[log]")
+{
+    nitro::log::hostname_attribute first;
+    nitro::log::hostname_attribute second;
+
+    REQUIRE(first.hostname() == nitro::env::hostname());
+    REQUIRE(&first.hostname() == &second.hostname());
+}
@@ -0,0 +1,186 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "test_directory.hpp"
+
+#include <nitro/log/attribute/rank.hpp>
+#include <nitro/log/attribute/severity.hpp>
+#include <nitro/log/attribute/timestamp.hpp>
+#include <nitro/log/filter/null_filter.hpp>
+#include <nitro/log/log.hpp>
+#include <nitro/log/sink/rank_file.hpp>
+#include <nitro/log/sink/rank_file_merge.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+extern "C"
+{
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+}
+
+namespace detail
+{
+
+typedef nitro::log::record<nitro::log::message_attribute, nitro::log::severity_attribute,
+                           nitro::log::rank_attribute,
+                           nitro::log::timestamp_clock_attribute<std::chrono::system_clock>>
+    record;
+
+template <typename Record>
+class message_formater
+{
+public:
+    std::string format(Record& r)
+    {
+        return r.message().str() + "\n";
+    }
+};
+
+using logging = nitro::log::logger<record, message_formater, nitro::log::sink::rank_file<>,
+                                   nitro::log::filter::null_filter>;
+
+std::vector<std::string> lines(const std::string& path)
+{
+    std::ifstream file(path);
+    std::vector<std::string> result;
+    for (std::string line; std::getline(file, line);)
+    {
+        result.push_back(line);
+    }
+    return result;
+}
+
+std::string write_file(const std::string& name, const std::string& content)
+{
+    auto path = directory() + "/" + name;
+    std::ofstream(path) << content;
+    return path;
+}
+
+std::string merge(const std::vector<std::string>& paths, bool collapse,
+                  std::chrono::nanoseconds window = std::chrono::seconds(1))
+{
+    nitro::log::sink::rank_file_merge merge(paths);
+    if (collapse)
+    {
+        merge.collapse(window);
+    }
+
+    std::stringstream s;
+    merge.write(s);
+    return s.str();
+}
+} // namespace detail
+
+TEST_CASE("The rank file sink writes one file per rank", "[log]")
+{
+    nitro::log::sink::rank_file<>::config().path = detail::directory() + "/log.{rank}.txt";
+
+    for (int rank = 0; rank < 3; ++rank)
+    {
+        pid_t pid = fork();
+        if (pid == 0)
+        {
+            nitro::log::rank_attribute::initialize(rank);
+
+            detail::logging::info() << "hello from " << rank;
+            detail::logging::info() << "done";
+            nitro::log::sink::rank_file<>::flush();
+            _exit(0);
+        }
+
+        int status = 0;
+        waitpid(pid, &status, 0);
+        REQUIRE(WIFEXITED(status));
+        REQUIRE(WEXITSTATUS(status) == 0);
+    }
+
+    std::vector<std::string> paths;
+    for (int rank = 0; rank < 3; ++rank)
+    {
+        paths.push_back(nitro::log::sink::rank_file<>::path(rank));
+
+        auto lines = detail::lines(paths.back());
+        REQUIRE(lines.size() == 2);
+
+        const std::regex prefix(
+            "[0-9]{4}-[0-9]{2}-[0-9]{2}T[0-9]{2}:[0-9]{2}:[0-9]{2}\\.[0-9]{9}Z " +
+            std::to_string(rank) + " ");
+        REQUIRE(std::regex_search(lines[0], prefix));
+        REQUIRE(lines[0].substr(lines[0].size() - 12) == "hello from " + std::to_string(rank));
+        REQUIRE(lines[1].substr(lines[1].size() - 5) == " done");
+    }
+
+    auto merged = detail::merge(paths, false);
+    REQUIRE(std::count(merged.begin(), merged.end(), '\n') == 6);
+    REQUIRE(merged.compare(0, 4, "[0] ") == 0);
+
+    auto collapsed = detail::merge(paths, true);
+    REQUIRE(std::count(collapsed.begin(), collapsed.end(), '\n') == 4);
+    REQUIRE(std::regex_search(collapsed, std::regex("\\[0-2\\] [^ ]+ done\n")));
+}
+
+TEST_CASE("The rank file merge orders the records by their timestamps", "[log]")
+{
+    auto first = detail::write_file("merge.0.txt", "2026-10-18T08:00:00.000000001Z 0 a\n"
+                                                   "2026-10-18T08:00:00.000000003Z 0 c\n"
+                                                   "continued\n"
+                                                   "2026-10-18T08:00:01.000000000Z 0 e\n");
+    auto second = detail::write_file("merge.1.txt", "2026-10-18T08:00:00.000000002Z 1 b\n"
+                                                    "2026-10-18T08:00:00.000000003Z 1 d\n"
+                                                    "2026-10-18T08:00:02.000000000Z 1 f\n");
+
+    REQUIRE(detail::merge({ first, second }, false) ==
+            "[0] 2026-10-18T08:00:00.000000001Z a\n"
+            "[1] 2026-10-18T08:00:00.000000002Z b\n"
+            "[0] 2026-10-18T08:00:00.000000003Z c\n"
+            "continued\n"
+            "[1] 2026-10-18T08:00:00.000000003Z d\n"
+            "[0] 2026-10-18T08:00:01.000000000Z e\n"
+            "[1] 2026-10-18T08:00:02.000000000Z f\n");
+}
+
+TEST_CASE("The rank file merge collapses identical records of different ranks", "[log]")
+{
+    std::vector<std::string> paths;
+    for (int rank = 0; rank < 6; ++rank)
+    {
+        if (rank == 4)
+        {
+            continue;
+        }
+
+        auto r = std::to_string(rank);
+        paths.push_back(detail::write_file(
+            "collapse." + r + ".txt", "2026-10-18T08:00:00.00000000" + r + "Z " + r + " step\n" +
+                                          "2026-10-18T08:00:00.10000000" + r + "Z " + r +
+                                          " step\n" + "2026-10-18T08:00:00.20000000" + r + "Z " +
+                                          r + " only " + r + "\n" +
+                                          "2026-10-18T08:00:05.00000000" + r + "Z " + r +
+                                          " step\n"));
+    }
+
+    REQUIRE(detail::merge(paths, true) == "[0-3,5] 2026-10-18T08:00:00.000000000Z step\n"
+                                          "[0-3,5] 2026-10-18T08:00:00.100000000Z step\n"
+                                          "[0] 2026-10-18T08:00:00.200000000Z only 0\n"
+                                          "[1] 2026-10-18T08:00:00.200000001Z only 1\n"
+                                          "[2] 2026-10-18T08:00:00.200000002Z only 2\n"
+                                          "[3] 2026-10-18T08:00:00.200000003Z only 3\n"
+                                          "[5] 2026-10-18T08:00:00.200000005Z only 5\n"
+                                          "[0-3,5] 2026-10-18T08:00:05.000000000Z step\n");
+
+    // outside of the window, records are not collapsed
+    auto separate = detail::merge(paths, true, std::chrono::nanoseconds(2));
+    const std::string separated = "[0-2] 2026-10-18T08:00:00.000000000Z step\n"
+                                  "[3,5] 2026-10-18T08:00:00.000000003Z step\n";
+    REQUIRE(separate.compare(0, separated.size(), separated) == 0);
+}
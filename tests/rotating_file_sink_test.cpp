@@ -0,0 +1,305 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "test_directory.hpp"
+
+#include <nitro/log/attribute/severity.hpp>
+#include <nitro/log/attribute/timestamp.hpp>
+#include <nitro/log/filter/null_filter.hpp>
+#include <nitro/log/log.hpp>
+#include <nitro/log/sink/rotating_file.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+extern "C"
+{
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+}
+
+namespace detail
+{
+
+typedef nitro::log::record<nitro::log::message_attribute, nitro::log::severity_attribute,
+                           nitro::log::timestamp_attribute>
+    record;
+
+template <typename Record>
+class line_formater
+{
+public:
+    std::string format(Record& r)
+    {
+        return r.message().str() + "\n";
+    }
+};
+
+template <unsigned N>
+using logging = nitro::log::logger<record, line_formater, nitro::log::sink::rotating_file<N>,
+                                   nitro::log::filter::null_filter>;
+
+std::vector<std::string> files_starting_with(const std::string& prefix)
+{
+    std::vector<std::string> result;
+
+    if (DIR* dir = opendir(directory().c_str()))
+    {
+        while (dirent* entry = readdir(dir))
+        {
+            std::string name = entry->d_name;
+            if (name.compare(0, prefix.size(), prefix) == 0)
+            {
+                result.push_back(directory() + "/" + name);
+            }
+        }
+        closedir(dir);
+    }
+
+    return result;
+}
+
+std::size_t size_of(const std::string& path)
+{
+    struct stat info;
+    return stat(path.c_str(), &info) == 0 ? static_cast<std::size_t>(info.st_size) : 0;
+}
+
+// the children of this process running command, which exited but were not waited for
+int zombie_children(const std::string& command)
+{
+    int zombies = 0;
+
+    if (DIR* dir = opendir("/proc"))
+    {
+        while (dirent* entry = readdir(dir))
+        {
+            // only the directories of processes
+            if (entry->d_name[0] < '0' || entry->d_name[0] > '9')
+            {
+                continue;
+            }
+
+            std::string stat = read(std::string("/proc/") + entry->d_name + "/stat");
+            auto end_of_name = stat.rfind(')');
+            if (end_of_name == std::string::npos ||
+                stat.compare(0, end_of_name + 1, entry->d_name + (" (" + command + ")")) != 0)
+            {
+                continue;
+            }
+
+            // "<pid> (<name>) <state> <parent pid> ..."
+            std::istringstream fields(stat.substr(end_of_name + 1));
+            char state;
+            pid_t parent;
+            fields >> state >> parent;
+            if (state == 'Z' && parent == getpid())
+            {
+                ++zombies;
+            }
+        }
+        closedir(dir);
+    }
+
+    return zombies;
+}
+
+template <typename Predicate>
+bool eventually(Predicate p)
+{
+    for (int i = 0; i < 500; ++i)
+    {
+        if (p())
+        {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+}
+} // namespace detail
+
+using nitro::log::severity_level;
+using nitro::log::sink::rotating_file;
+
+TEST_CASE("Rotating file sink buffers records", "[log]")
+{
+    auto& config = rotating_file<0>::config();
+    config.path = detail::directory() + "/buffered.log";
+    config.flush_interval = std::chrono::milliseconds(0);
+    config.flush_severity = severity_level::fatal;
+
+    for (int i = 0; i < 10; ++i)
+    {
+        detail::logging<0>::info() << "record " << i;
+    }
+
+    REQUIRE(detail::size_of(config.path) == 0);
+
+    detail::logging<0>::fatal() << "fatal";
+
+    std::string expected;
+    for (int i = 0; i < 10; ++i)
+    {
+        expected += "record " + std::to_string(i) + "\n";
+    }
+    expected += "fatal\n";
+
+    REQUIRE(detail::read(config.path) == expected);
+}
+
+TEST_CASE("Rotating file sink keeps the order of records larger than its buffer", "[log]")
+{
+    auto& config = rotating_file<4>::config();
+    config.path = detail::directory() + "/small_buffer.log";
+    config.buffer_size = 16;
+    config.flush_interval = std::chrono::milliseconds(0);
+    config.flush_severity = severity_level::fatal;
+
+    const std::string large(40, 'x');
+
+    detail::logging<4>::info() << "first";
+    detail::logging<4>::info() << "second";
+    detail::logging<4>::info() << "third";
+    detail::logging<4>::info() << large;
+    detail::logging<4>::info() << "last";
+    rotating_file<4>::flush();
+
+    REQUIRE(detail::read(config.path) == "first\nsecond\nthird\n" + large + "\nlast\n");
+}
+
+TEST_CASE("Rotating file sink flushes in the background", "[log]")
+{
+    auto& config = rotating_file<1>::config();
+    config.path = detail::directory() + "/background.log";
+    config.flush_interval = std::chrono::milliseconds(10);
+    config.flush_severity = severity_level::fatal;
+
+    detail::logging<1>::info() << "in the background";
+
+    REQUIRE(detail::eventually(
+        [&config]() { return detail::read(config.path) == "in the background\n"; }));
+}
+
+TEST_CASE("Rotating file sink rotates by size", "[log]")
+{
+    auto& config = rotating_file<2>::config();
+    config.path = detail::directory() + "/sized.log";
+    config.flush_interval = std::chrono::milliseconds(0);
+    config.flush_severity = severity_level::trace;
+    config.max_file_size = 100;
+
+    const int count = 30;
+    for (int i = 0; i < count; ++i)
+    {
+        detail::logging<2>::info() << "record number " << i;
+    }
+    rotating_file<2>::flush();
+
+    auto files = detail::files_starting_with("sized.log");
+    REQUIRE(files.size() > 1);
+
+    int lines = 0;
+    for (const auto& file : files)
+    {
+        REQUIRE(detail::size_of(file) <= 100);
+
+        auto content = detail::read(file);
+        for (auto c : content)
+        {
+            lines += c == '\n';
+        }
+
+        // records are never split between files
+        REQUIRE(content.back() == '\n');
+    }
+
+    REQUIRE(lines == count);
+}
+
+TEST_CASE("Rotating file sink compresses rotated segments", "[log]")
+{
+    if (std::system("gzip --version > /dev/null 2>&1") != 0)
+    {
+        WARN("gzip is not available, skipping");
+        return;
+    }
+
+    auto& config = rotating_file<3>::config();
+    config.path = detail::directory() + "/compressed.log";
+    config.flush_interval = std::chrono::milliseconds(0);
+    config.compress_command = { "gzip" };
+
+    detail::logging<3>::info() << "compress me";
+    rotating_file<3>::rotate();
+
+    REQUIRE(detail::eventually([]() {
+        for (const auto& file : detail::files_starting_with("compressed.log."))
+        {
+            if (file.size() > 3 && file.compare(file.size() - 3, 3, ".gz") == 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }));
+
+    detail::logging<3>::info() << "new file";
+    rotating_file<3>::flush();
+
+    REQUIRE(detail::read(config.path) == "new file\n");
+}
+
+TEST_CASE("Rotating file sink reaps compressions without the flush thread", "[log]")
+{
+    auto& config = rotating_file<5>::config();
+    config.path = detail::directory() + "/reaped.log";
+    config.flush_interval = std::chrono::milliseconds(0);
+    config.compress_command = { "true" };
+
+    // every rotation reaps the compressions, which finished before
+    for (int i = 0; i < 3; ++i)
+    {
+        detail::logging<5>::info() << "rotated " << i;
+        rotating_file<5>::rotate();
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    REQUIRE(detail::zombie_children("true") <= 1);
+}
+
+TEST_CASE("Rotating file sink writes records logged at exit", "[log]")
+{
+    auto& config = rotating_file<6>::config();
+    config.path = detail::directory() + "/exit.log";
+    config.flush_interval = std::chrono::milliseconds(0);
+
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        // destroyed after the sink stopped, as it is constructed before
+        struct late
+        {
+            ~late()
+            {
+                detail::logging<6>::info() << "late";
+            }
+        };
+        static late late_;
+
+        detail::logging<6>::info() << "buffered";
+        std::exit(0);
+    }
+
+    int status;
+    REQUIRE(waitpid(pid, &status, 0) == pid);
+    REQUIRE(WIFEXITED(status));
+    REQUIRE(detail::read(config.path) == "buffered\nlate\n");
+}
@@ -0,0 +1,218 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include <nitro/log/attribute/severity.hpp>
+#include <nitro/log/attribute/timestamp.hpp>
+#include <nitro/log/filter/null_filter.hpp>
+#include <nitro/log/filter/severity_filter.hpp>
+#include <nitro/log/filter/static_severity_filter.hpp>
+#include <nitro/log/log.hpp>
+#include <nitro/log/sink/async.hpp>
+#include <nitro/log/sink/router.hpp>
+
+#include <atomic>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace detail
+{
+
+typedef nitro::log::record<nitro::log::message_attribute, nitro::log::severity_attribute,
+                           nitro::log::timestamp_attribute>
+    record;
+
+template <typename Record>
+class message_formater
+{
+public:
+    void format(Record& r, std::ostream& s)
+    {
+        s << r.message();
+    }
+};
+
+template <typename Record>
+class severity_formater
+{
+public:
+    void format(Record& r, std::ostream& s)
+    {
+        s << r.severity() << ": " << r.message();
+    }
+};
+
+template <typename Record>
+class counting_formater
+{
+public:
+    static std::size_t& calls()
+    {
+        static std::size_t calls_ = 0;
+        return calls_;
+    }
+
+    std::string format(Record& r)
+    {
+        ++calls();
+        return "#" + std::string(r.message());
+    }
+};
+
+// the sinks in the order they were written
+std::vector<int>& order()
+{
+    static std::vector<int> order_;
+    return order_;
+}
+
+template <int N>
+class collecting_sink
+{
+public:
+    static std::vector<std::string>& records()
+    {
+        static std::vector<std::string> records_;
+        return records_;
+    }
+
+    static std::atomic<bool>& gate()
+    {
+        static std::atomic<bool> gate_{ true };
+        return gate_;
+    }
+
+    void sink(nitro::log::severity_level, nitro::lang::string_ref formatted_record)
+    {
+        while (!gate().load())
+        {
+            std::this_thread::yield();
+        }
+
+        records().push_back(formatted_record);
+        order().push_back(N);
+    }
+};
+
+template <typename Record>
+using route_filter = nitro::log::filter::severity_filter<Record, 1>;
+
+using records = std::vector<std::string>;
+
+using router = nitro::log::sink::router<
+    nitro::log::sink::route<collecting_sink<0>>,
+    nitro::log::sink::route<
+        collecting_sink<1>,
+        nitro::log::filter::static_severity<nitro::log::severity_level::error>::type,
+        severity_formater>,
+    nitro::log::sink::route<collecting_sink<2>, route_filter, counting_formater>,
+    nitro::log::sink::route<collecting_sink<3>, nitro::log::filter::null_filter,
+                            counting_formater>>;
+
+using async_router = nitro::log::sink::router<
+    nitro::log::sink::route<nitro::log::sink::async<
+        collecting_sink<4>, nitro::log::sink::overflow_policy::drop_newest>>,
+    nitro::log::sink::route<collecting_sink<5>>>;
+
+template <typename Sink>
+using logging = nitro::log::logger<record, message_formater, Sink, nitro::log::filter::null_filter>;
+
+void clear()
+{
+    collecting_sink<0>::records().clear();
+    collecting_sink<1>::records().clear();
+    collecting_sink<2>::records().clear();
+    collecting_sink<3>::records().clear();
+    order().clear();
+    counting_formater<record>::calls() = 0;
+}
+} // namespace detail
+
+TEST_CASE("Router sink", "[log]")
+{
+    SECTION("writes records to the routes, which accept them")
+    {
+        detail::clear();
+
+        detail::logging<detail::router>::info() << "Hello";
+        detail::logging<detail::router>::error() << "World";
+
+        REQUIRE(detail::collecting_sink<0>::records() == detail::records{ "Hello", "World" });
+        REQUIRE(detail::collecting_sink<1>::records() == detail::records{ "ERROR: World" });
+        REQUIRE(detail::collecting_sink<2>::records() == detail::records{ "#Hello", "#World" });
+        REQUIRE(detail::collecting_sink<3>::records() == detail::records{ "#Hello", "#World" });
+    }
+
+    SECTION("formats a record once per formatter")
+    {
+        detail::clear();
+
+        detail::logging<detail::router>::warn() << "Hello";
+
+        REQUIRE(detail::counting_formater<detail::record>::calls() == 1);
+        REQUIRE(detail::collecting_sink<2>::records().size() == 1);
+        REQUIRE(detail::collecting_sink<3>::records().size() == 1);
+    }
+
+    SECTION("writes the routes in the order of the first route of every formatter")
+    {
+        detail::clear();
+
+        detail::logging<detail::router>::error() << "Hello";
+
+        REQUIRE(detail::order() == std::vector<int>{ 0, 1, 2, 3 });
+    }
+
+    SECTION("applies runtime filters per route")
+    {
+        detail::clear();
+
+        detail::route_filter<detail::record>::set_severity(nitro::log::severity_level::warn);
+
+        detail::logging<detail::router>::info() << "Hello";
+        detail::logging<detail::router>::warn() << "World";
+
+        detail::route_filter<detail::record>::set_severity(nitro::log::severity_level::trace);
+
+        REQUIRE(detail::collecting_sink<0>::records().size() == 2);
+        REQUIRE(detail::collecting_sink<2>::records() == detail::records{ "#World" });
+        REQUIRE(detail::collecting_sink<3>::records() == detail::records{ "#Hello", "#World" });
+        REQUIRE(detail::counting_formater<detail::record>::calls() == 2);
+    }
+
+    SECTION("does not format for routes, which reject the record")
+    {
+        detail::clear();
+
+        detail::route_filter<detail::record>::set_severity(nitro::log::severity_level::fatal);
+        detail::logging<nitro::log::sink::router<nitro::log::sink::route<
+            detail::collecting_sink<2>, detail::route_filter, detail::counting_formater>>>::info()
+            << "Hello";
+        detail::route_filter<detail::record>::set_severity(nitro::log::severity_level::trace);
+
+        REQUIRE(detail::collecting_sink<2>::records().empty());
+        REQUIRE(detail::counting_formater<detail::record>::calls() == 0);
+    }
+}
+
+TEST_CASE("A blocked asynchronous route does not stall the other routes", "[log]")
+{
+    using async_sink = nitro::log::sink::async<detail::collecting_sink<4>,
+                                               nitro::log::sink::overflow_policy::drop_newest>;
+
+    detail::collecting_sink<4>::gate() = false;
+
+    for (int i = 0; i < 3; ++i)
+    {
+        detail::logging<detail::async_router>::info() << "record " << i;
+    }
+
+    REQUIRE(detail::collecting_sink<5>::records().size() == 3);
+
+    detail::collecting_sink<4>::gate() = true;
+    async_sink::flush();
+
+    REQUIRE(detail::collecting_sink<4>::records() ==
+            detail::records{ "record 0", "record 1", "record 2" });
+}
@@ -0,0 +1,193 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include <nitro/log/attribute/call_site.hpp>
+#include <nitro/log/attribute/severity.hpp>
+#include <nitro/log/attribute/timestamp.hpp>
+#include <nitro/log/filter/sampling_filter.hpp>
+#include <nitro/log/log.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace detail
+{
+
+typedef nitro::log::record<nitro::log::tag_attribute, nitro::log::message_attribute,
+                           nitro::log::severity_attribute, nitro::log::timestamp_attribute>
+    record;
+
+typedef nitro::log::record<nitro::log::tag_attribute, nitro::log::message_attribute,
+                           nitro::log::severity_attribute, nitro::log::timestamp_attribute,
+                           nitro::log::call_site_attribute>
+    site_record;
+
+template <typename Record>
+class message_formater
+{
+public:
+    std::string format(Record& r)
+    {
+        return r.message();
+    }
+};
+
+template <unsigned N>
+class counting_sink
+{
+public:
+    static std::vector<std::string>& records()
+    {
+        static std::vector<std::string> records_;
+        return records_;
+    }
+
+    void sink(nitro::log::severity_level, nitro::lang::string_ref formatted_record)
+    {
+        records().emplace_back(formatted_record);
+    }
+};
+
+template <typename Record>
+using one_in = nitro::log::filter::sampling_filter<Record>;
+
+template <typename Record>
+using fraction = nitro::log::filter::sampling_filter<Record, 1>;
+
+template <unsigned N, template <typename> class Filter>
+using logging = nitro::log::logger<record, message_formater, counting_sink<N>, Filter>;
+
+template <unsigned N, template <typename> class Filter>
+using site_logging =
+    nitro::log::logger<site_record, message_formater, counting_sink<N>, Filter>;
+
+int evaluated = 0;
+} // namespace detail
+
+using nitro::log::severity_level;
+
+TEST_CASE("Sampling filter keeps every n-th record of each tag", "[log]")
+{
+    using filter = detail::one_in<detail::record>;
+    using logging = detail::logging<0, detail::one_in>;
+    auto& records = detail::counting_sink<0>::records();
+
+    filter::keep_one_in(10);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        logging::debug("loop") << "loop " << i;
+        logging::debug("other") << "other " << i;
+        logging::debug() << "untagged " << [i]() {
+            ++detail::evaluated;
+            return i;
+        };
+        // above the maximum severity of the sampling
+        logging::info("loop") << "info " << i;
+    }
+
+    REQUIRE(records.size() == 130);
+    REQUIRE(records[0] == "loop 0");
+    REQUIRE(records[1] == "other 0");
+    REQUIRE(records[2] == "untagged 0");
+    REQUIRE(records[3] == "info 0");
+    REQUIRE(records[4] == "info 1");
+
+    // dropped records do not call their lazy arguments
+    REQUIRE(detail::evaluated == 10);
+
+    REQUIRE(filter::kept() == 30);
+    REQUIRE(filter::dropped() == 270);
+
+    REQUIRE_THROWS(filter::keep_one_in(0));
+}
+
+TEST_CASE("Sampling filter keeps every n-th record of each statement with a call site", "[log]")
+{
+    using filter = detail::one_in<detail::site_record>;
+    using logging = detail::site_logging<2, detail::one_in>;
+    auto& records = detail::counting_sink<2>::records();
+
+    filter::keep_one_in(3);
+
+    for (int i = 0; i < 9; ++i)
+    {
+        NITRO_LOG_TAG(logging, debug, "loop") << "first " << i;
+        NITRO_LOG_TAG(logging, debug, "loop") << "second " << i;
+    }
+
+    REQUIRE(records == std::vector<std::string>{ "first 0", "second 0", "first 3", "second 3",
+                                                 "first 6", "second 6" });
+    REQUIRE(filter::dropped() == 12);
+}
+
+TEST_CASE("Sampling filter counts every thread on its own", "[log]")
+{
+    using filter = detail::one_in<detail::record>;
+    using logging = detail::logging<0, detail::one_in>;
+    auto& records = detail::counting_sink<0>::records();
+    records.clear();
+
+    filter::keep_one_in(4);
+    auto kept = filter::kept();
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([]() {
+            for (int i = 0; i < 100; ++i)
+            {
+                logging::debug("threads") << "record";
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    REQUIRE(records.size() == 100);
+    REQUIRE(filter::kept() - kept == 100);
+}
+
+TEST_CASE("Sampling filter keeps a random fraction", "[log]")
+{
+    using filter = detail::fraction<detail::record>;
+    using logging = detail::logging<1, detail::fraction>;
+    auto& records = detail::counting_sink<1>::records();
+
+    filter::set_max_severity(severity_level::info);
+
+    filter::keep_fraction(0.25);
+    for (int i = 0; i < 10000; ++i)
+    {
+        logging::info() << "sampled";
+    }
+
+    REQUIRE(records.size() > 2000);
+    REQUIRE(records.size() < 3000);
+    REQUIRE(filter::kept() + filter::dropped() == 10000);
+
+    records.clear();
+    filter::keep_fraction(0);
+    logging::info() << "never";
+    filter::keep_fraction(1);
+    logging::info() << "always";
+
+    REQUIRE(records == std::vector<std::string>{ "always" });
+
+    REQUIRE_THROWS(filter::keep_fraction(1.5));
+}
+
+TEST_CASE("Sampling filter decides before the record is constructed", "[log]")
+{
+    using filter = detail::one_in<detail::record>;
+    using logging = detail::logging<0, detail::one_in>;
+
+    filter::keep_one_in(2);
+
+    REQUIRE(logging::will_log(severity_level::debug, "before"));
+    REQUIRE(!logging::will_log(severity_level::debug, "before"));
+    REQUIRE(logging::will_log(severity_level::debug, "before"));
+}
@@ -0,0 +1,238 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include <nitro/log/attribute/severity.hpp>
+#include <nitro/log/attribute/timestamp.hpp>
+#include <nitro/log/filter/null_filter.hpp>
+#include <nitro/log/log.hpp>
+#include <nitro/log/sink/shm_ring.hpp>
+#include <nitro/log/sink/shm_ring_collector.hpp>
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+extern "C"
+{
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+}
+
+namespace detail
+{
+
+typedef nitro::log::record<nitro::log::message_attribute, nitro::log::severity_attribute,
+                           nitro::log::timestamp_attribute>
+    record;
+
+template <typename Record>
+class line_formater
+{
+public:
+    std::string format(Record& r)
+    {
+        return r.message().str() + "\n";
+    }
+};
+
+template <unsigned N>
+using logging = nitro::log::logger<record, line_formater, nitro::log::sink::shm_ring<N>,
+                                   nitro::log::filter::null_filter>;
+
+class capturing_sink
+{
+public:
+    void sink(nitro::log::severity_level sev, nitro::lang::string_ref formatted_record)
+    {
+        records.emplace_back(formatted_record);
+        severities.push_back(sev);
+    }
+
+    std::vector<std::string> records;
+    std::vector<nitro::log::severity_level> severities;
+};
+
+// reads the records as C strings, like sink::Syslog does
+class c_string_sink
+{
+public:
+    void sink(nitro::log::severity_level, nitro::lang::string_ref formatted_record)
+    {
+        records.emplace_back(formatted_record.get(), std::strlen(formatted_record.get()));
+    }
+
+    std::vector<std::string> records;
+};
+
+// a prefix no other test run uses
+std::string prefix(const std::string& name)
+{
+    return "nitro-test-" + std::to_string(getpid()) + "-" + name;
+}
+
+bool segment_exists(const std::string& name)
+{
+    struct stat info;
+    return stat(("/dev/shm" + name).c_str(), &info) == 0;
+}
+} // namespace detail
+
+TEST_CASE("The shm ring sink hands records to the collector", "[log]")
+{
+    nitro::log::sink::shm_ring<0>::config().prefix = detail::prefix("own");
+
+    detail::logging<0>::info() << "Hello";
+    detail::logging<0>::warn() << "World";
+    detail::logging<0>::error() << "!";
+
+    nitro::log::sink::shm_ring_collector collector(detail::prefix("own"));
+    detail::capturing_sink sink;
+
+    REQUIRE(collector.collect(sink) == 3);
+    REQUIRE(collector.rings() == 1);
+    REQUIRE(sink.records == std::vector<std::string>{ "Hello\n", "World\n", "!\n" });
+    REQUIRE(sink.severities[1] == nitro::log::severity_level::warn);
+
+    REQUIRE(collector.collect(sink) == 0);
+
+    detail::logging<0>::info() << "again";
+    REQUIRE(collector.collect(sink) == 1);
+    REQUIRE(sink.records.back() == "again\n");
+
+    nitro::log::detail::shm_ring::open(nitro::log::sink::shm_ring<0>::name()).unlink();
+}
+
+TEST_CASE("The shm ring collector merges the rings by timestamp", "[log]")
+{
+    const auto prefix = detail::prefix("merge");
+
+    auto first = nitro::log::detail::shm_ring::create("/" + prefix + ".1", 4096);
+    auto second = nitro::log::detail::shm_ring::create("/" + prefix + ".2", 4096);
+
+    first.push(10, nitro::log::severity_level::info, "a");
+    second.push(20, nitro::log::severity_level::info, "b");
+    first.push(30, nitro::log::severity_level::info, "c");
+    second.push(30, nitro::log::severity_level::info, "d");
+    second.push(40, nitro::log::severity_level::info, "e");
+
+    nitro::log::sink::shm_ring_collector collector(prefix);
+    detail::capturing_sink sink;
+
+    REQUIRE(collector.collect(sink) == 5);
+    REQUIRE(collector.rings() == 2);
+    REQUIRE(sink.records == std::vector<std::string>{ "a", "b", "c", "d", "e" });
+
+    first.unlink();
+    second.unlink();
+}
+
+TEST_CASE("The shm ring collector passes every record terminated by '\\0'", "[log]")
+{
+    const auto prefix = detail::prefix("terminated");
+
+    auto ring = nitro::log::detail::shm_ring::create("/" + prefix + ".1", 4096);
+
+    ring.push(10, nitro::log::severity_level::info, "first");
+    ring.push(20, nitro::log::severity_level::info, "second");
+
+    nitro::log::sink::shm_ring_collector collector(prefix);
+    detail::c_string_sink sink;
+
+    REQUIRE(collector.collect(sink) == 2);
+    REQUIRE(sink.records == std::vector<std::string>{ "first", "second" });
+
+    ring.unlink();
+}
+
+TEST_CASE("The shm ring drops records if it is full", "[log]")
+{
+    const auto prefix = detail::prefix("full");
+
+    auto ring = nitro::log::detail::shm_ring::create("/" + prefix + ".1", 4096);
+    const std::string record(200, 'x');
+
+    std::size_t pushed = 0;
+    while (ring.push(0, nitro::log::severity_level::info, record))
+    {
+        ++pushed;
+    }
+
+    REQUIRE(pushed == 4096 / 256);
+    REQUIRE(ring.dropped() == 1);
+
+    nitro::log::sink::shm_ring_collector collector(prefix);
+    detail::capturing_sink sink;
+
+    REQUIRE(collector.collect(sink) == pushed);
+    REQUIRE(collector.dropped() == 1);
+    REQUIRE(sink.records.back() == record);
+
+    // the space is free again, and records now wrap around the end of the ring
+    const std::string wrapping(300, 'y');
+    for (int i = 0; i < 20; ++i)
+    {
+        REQUIRE(ring.push(i, nitro::log::severity_level::info, wrapping));
+        REQUIRE(collector.collect(sink) == 1);
+        REQUIRE(sink.records.back() == wrapping);
+    }
+
+    ring.unlink();
+}
+
+TEST_CASE("The shm ring collector removes the rings of exited processes", "[log]")
+{
+    const auto prefix = detail::prefix("exited");
+    nitro::log::sink::shm_ring<1>::config().prefix = prefix;
+
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        for (int i = 0; i < 100; ++i)
+        {
+            detail::logging<1>::info() << "child " << i;
+        }
+        _exit(0);
+    }
+
+    int status;
+    REQUIRE(waitpid(pid, &status, 0) == pid);
+    REQUIRE(WIFEXITED(status));
+    REQUIRE(WEXITSTATUS(status) == 0);
+
+    const auto name = "/" + prefix + "." + std::to_string(pid) + ".1";
+    REQUIRE(detail::segment_exists(name));
+
+    nitro::log::sink::shm_ring_collector collector(prefix);
+    detail::capturing_sink sink;
+
+    REQUIRE(collector.collect(sink) == 100);
+    REQUIRE(sink.records.front() == "child 0\n");
+    REQUIRE(sink.records.back() == "child 99\n");
+    REQUIRE(collector.rings() == 0);
+    REQUIRE(!detail::segment_exists(name));
+}
+
+TEST_CASE("The shm ring sinks of one process write to separate segments", "[log]")
+{
+    const auto prefix = detail::prefix("separate");
+    nitro::log::sink::shm_ring<2>::config().prefix = prefix;
+    nitro::log::sink::shm_ring<3>::config().prefix = prefix;
+
+    detail::logging<2>::info() << "second";
+    detail::logging<3>::info() << "third";
+
+    REQUIRE(nitro::log::sink::shm_ring<2>::name() != nitro::log::sink::shm_ring<3>::name());
+
+    nitro::log::sink::shm_ring_collector collector(prefix);
+    detail::capturing_sink sink;
+
+    REQUIRE(collector.collect(sink) == 2);
+    REQUIRE(collector.rings() == 2);
+    REQUIRE(sink.records == std::vector<std::string>{ "second\n", "third\n" });
+
+    nitro::log::detail::shm_ring::open(nitro::log::sink::shm_ring<2>::name()).unlink();
+    nitro::log::detail::shm_ring::open(nitro::log::sink::shm_ring<3>::name()).unlink();
+}
@@ -0,0 +1,258 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include <nitro/log/attribute/call_site.hpp>
+#include <nitro/log/attribute/severity.hpp>
+#include <nitro/log/attribute/timestamp.hpp>
+#include <nitro/log/filter/and_filter.hpp>
+#include <nitro/log/filter/dedupe.hpp>
+#include <nitro/log/filter/rate_limit.hpp>
+#include <nitro/log/filter/severity_filter.hpp>
+#include <nitro/log/log.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace detail
+{
+
+typedef nitro::log::record<nitro::log::tag_attribute, nitro::log::message_attribute,
+                           nitro::log::severity_attribute, nitro::log::timestamp_attribute>
+    record;
+
+typedef nitro::log::record<nitro::log::tag_attribute, nitro::log::message_attribute,
+                           nitro::log::severity_attribute, nitro::log::timestamp_attribute,
+                           nitro::log::call_site_attribute>
+    site_record;
+
+template <typename Record>
+class message_formater
+{
+public:
+    std::string format(Record& r)
+    {
+        return r.message();
+    }
+};
+
+template <unsigned N>
+class capturing_sink
+{
+public:
+    static std::mutex& mutex()
+    {
+        static std::mutex mutex_;
+        return mutex_;
+    }
+
+    static std::vector<std::string>& records()
+    {
+        static std::vector<std::string> records_;
+        return records_;
+    }
+
+    void sink(nitro::log::severity_level, nitro::lang::string_ref formatted_record)
+    {
+        std::lock_guard<std::mutex> lock(mutex());
+        records().emplace_back(formatted_record);
+    }
+};
+
+template <typename Record>
+using rate_limit = nitro::log::filter::rate_limit<Record>;
+
+template <typename Record>
+using threaded_rate_limit = nitro::log::filter::rate_limit<Record, 1>;
+
+template <typename Record>
+using dedupe = nitro::log::filter::dedupe<Record>;
+
+template <typename Record>
+using dedupe_then_limit =
+    nitro::log::filter::and_filter<nitro::log::filter::dedupe<Record, 1>,
+                                   nitro::log::filter::rate_limit<Record, 2>>;
+
+template <typename Record>
+using limited_dedupe =
+    nitro::log::filter::and_filter<nitro::log::filter::severity_filter<Record>,
+                                   dedupe_then_limit<Record>>;
+
+template <unsigned N, template <typename> class Filter>
+using logging = nitro::log::logger<record, message_formater, capturing_sink<N>, Filter>;
+
+template <unsigned N, template <typename> class Filter>
+using site_logging =
+    nitro::log::logger<site_record, message_formater, capturing_sink<N>, Filter>;
+
+int evaluated = 0;
+
+int evaluate(int i)
+{
+    ++evaluated;
+    return i;
+}
+} // namespace detail
+
+using nitro::log::severity_level;
+
+TEST_CASE("Rate limit lets a burst of records of each tag pass", "[log]")
+{
+    using filter = detail::rate_limit<detail::record>;
+    using logging = detail::logging<0, detail::rate_limit>;
+    auto& records = detail::capturing_sink<0>::records();
+
+    // slow enough that no token is added during the test
+    filter::set_limit(0.01, 5);
+
+    detail::evaluated = 0;
+    for (int i = 0; i < 100; ++i)
+    {
+        logging::error("db") << "db down " << [i]() { return detail::evaluate(i); };
+        logging::error("net") << "net down " << [i]() { return detail::evaluate(i); };
+        logging::error() << "untagged " << [i]() { return detail::evaluate(i); };
+    }
+
+    REQUIRE(records.size() == 15);
+    REQUIRE(records[0] == "db down 0");
+    REQUIRE(records[14] == "untagged 4");
+    REQUIRE(filter::suppressed() == 285);
+
+    // suppressed statements do not call their lazy arguments
+    REQUIRE(detail::evaluated == 15);
+
+    REQUIRE_THROWS(filter::set_limit(0, 1));
+    REQUIRE_THROWS(filter::set_limit(1, 0));
+}
+
+TEST_CASE("Rate limit has a bucket for every statement with a call site", "[log]")
+{
+    using filter = detail::rate_limit<detail::site_record>;
+    using logging = detail::site_logging<5, detail::rate_limit>;
+    auto& records = detail::capturing_sink<5>::records();
+
+    filter::set_limit(0.01, 2);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        NITRO_LOG_TAG(logging, error, "db") << "first " << i;
+        NITRO_LOG_TAG(logging, error, "db") << "second " << i;
+        // without a call site, keyed by its tag
+        logging::error("db") << "no site " << i;
+        logging::error("db") << "other no site " << i;
+    }
+
+    REQUIRE(records == std::vector<std::string>{ "first 0", "second 0", "no site 0",
+                                                 "other no site 0", "first 1", "second 1" });
+    REQUIRE(filter::suppressed() == 34);
+}
+
+TEST_CASE("Rate limit adds tokens over time", "[log]")
+{
+    using filter = detail::rate_limit<detail::record>;
+    using logging = detail::logging<0, detail::rate_limit>;
+    auto& records = detail::capturing_sink<0>::records();
+    records.clear();
+
+    filter::set_limit(20, 1);
+
+    auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(500);
+    while (std::chrono::steady_clock::now() < end)
+    {
+        logging::info("refill") << "tick";
+    }
+
+    // 10 plus the first one, give or take the resolution of the coarse clock
+    REQUIRE(records.size() >= 6);
+    REQUIRE(records.size() <= 16);
+}
+
+TEST_CASE("Rate limit holds across threads", "[log]")
+{
+    using filter = detail::threaded_rate_limit<detail::record>;
+    using logging = detail::logging<1, detail::threaded_rate_limit>;
+    auto& records = detail::capturing_sink<1>::records();
+
+    filter::set_limit(0.01, 50);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([]() {
+            for (int i = 0; i < 1000; ++i)
+            {
+                logging::warn("shared") << "flood";
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    REQUIRE(records.size() == 50);
+    REQUIRE(filter::suppressed() == 4000 - 50);
+}
+
+TEST_CASE("Dedupe collapses identical consecutive messages", "[log]")
+{
+    using logging = detail::logging<2, detail::dedupe>;
+    auto& records = detail::capturing_sink<2>::records();
+
+    for (const char* message : { "a", "a", "a", "b", "b", "c" })
+    {
+        logging::error() << message;
+    }
+    logging::warn() << "c";
+
+    REQUIRE(records == std::vector<std::string>{ "a", "last message repeated 2 times", "b",
+                                                 "last message repeated 1 time", "c", "c" });
+    REQUIRE(detail::dedupe<detail::record>::suppressed() == 3);
+}
+
+TEST_CASE("Dedupe reports ongoing repetitions", "[log]")
+{
+    using filter = detail::dedupe<detail::record>;
+    using logging = detail::logging<3, detail::dedupe>;
+    auto& records = detail::capturing_sink<3>::records();
+
+    filter::set_report_interval(std::chrono::milliseconds(20));
+
+    auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(200);
+    while (std::chrono::steady_clock::now() < end)
+    {
+        logging::error() << "stuck";
+    }
+
+    filter::set_report_interval(std::chrono::seconds(10));
+
+    REQUIRE(records.size() >= 3);
+    REQUIRE(records[0] == "stuck");
+    for (std::size_t i = 1; i < records.size(); ++i)
+    {
+        REQUIRE(records[i].find("last message repeated ") == 0);
+    }
+}
+
+TEST_CASE("Rate limit and dedupe compose with and_filter", "[log]")
+{
+    using logging = detail::logging<4, detail::limited_dedupe>;
+    auto& records = detail::capturing_sink<4>::records();
+
+    nitro::log::filter::severity_filter<detail::record>::set_severity(severity_level::info);
+    nitro::log::filter::rate_limit<detail::record, 2>::set_limit(0.01, 3);
+
+    logging::debug() << "filtered by severity";
+    logging::info() << "one";
+    logging::info() << "one";
+    logging::info() << "two";
+    logging::info() << "three";
+    logging::info() << "four";
+
+    nitro::log::filter::severity_filter<detail::record>::set_severity(severity_level::trace);
+
+    REQUIRE(records == std::vector<std::string>{ "one", "last message repeated 1 time", "two" });
+}
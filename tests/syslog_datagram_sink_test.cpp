@@ -0,0 +1,171 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include <nitro/log/attribute/severity.hpp>
+#include <nitro/log/attribute/timestamp.hpp>
+#include <nitro/log/filter/null_filter.hpp>
+#include <nitro/log/log.hpp>
+#include <nitro/log/sink/syslog_datagram.hpp>
+
+#include <cstdlib>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace detail
+{
+
+typedef nitro::log::record<nitro::log::tag_attribute, nitro::log::message_attribute,
+                           nitro::log::severity_attribute, nitro::log::timestamp_attribute>
+    record;
+
+template <typename Record>
+class message_formater
+{
+public:
+    std::string format(Record& r)
+    {
+        return std::string(r.message()) + "\n";
+    }
+};
+
+template <typename Record>
+using log_filter = nitro::log::filter::null_filter<Record>;
+
+// stands in for the syslog daemon
+class listener
+{
+public:
+    listener() : path_("/tmp/nitro_syslog_test_" + std::to_string(::getpid()) + ".sock")
+    {
+        ::unlink(path_.c_str());
+
+        socket_ = ::socket(AF_UNIX, SOCK_DGRAM, 0);
+        REQUIRE(socket_ >= 0);
+
+        sockaddr_un address = {};
+        address.sun_family = AF_UNIX;
+        path_.copy(address.sun_path, sizeof(address.sun_path) - 1);
+        REQUIRE(::bind(socket_, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) ==
+                0);
+    }
+
+    ~listener()
+    {
+        ::close(socket_);
+        ::unlink(path_.c_str());
+    }
+
+    const std::string& path() const
+    {
+        return path_;
+    }
+
+    std::vector<std::string> receive()
+    {
+        std::vector<std::string> messages;
+        char buffer[4096];
+
+        while (true)
+        {
+            auto size = ::recv(socket_, buffer, sizeof(buffer), MSG_DONTWAIT);
+            if (size < 0)
+            {
+                return messages;
+            }
+            messages.emplace_back(buffer, static_cast<std::size_t>(size));
+        }
+    }
+
+private:
+    std::string path_;
+    int socket_;
+};
+} // namespace detail
+
+using sink = nitro::log::sink::syslog_datagram;
+
+using logging = nitro::log::logger<detail::record, detail::message_formater, sink,
+                                   detail::log_filter>;
+
+// runs first, so the child process creates the sink
+TEST_CASE("The syslog datagram sink sends the messages left at exit", "[log]")
+{
+    detail::listener daemon;
+
+    pid_t pid = ::fork();
+    if (pid == 0)
+    {
+        sink::config().path = daemon.path();
+
+        // destroyed after the sink stopped, as it is constructed before
+        struct late
+        {
+            ~late()
+            {
+                logging::info() << "late";
+            }
+        };
+        static late late_;
+
+        for (int i = 0; i < 5; ++i)
+        {
+            logging::info() << "queued " << i;
+        }
+        std::exit(0);
+    }
+
+    int status;
+    REQUIRE(::waitpid(pid, &status, 0) == pid);
+    REQUIRE(WIFEXITED(status));
+
+    auto messages = daemon.receive();
+    REQUIRE(messages.size() == 6);
+    REQUIRE(messages.back().substr(messages.back().size() - 7) == " - late");
+}
+
+TEST_CASE("The syslog datagram sink sends RFC 5424 messages and drops on overload", "[log]")
+{
+    detail::listener daemon;
+
+    sink::config().path = daemon.path();
+    sink::config().app_name = "nitro test";
+    sink::config().queue_size = 64;
+    sink::config().send_timeout = std::chrono::milliseconds(10);
+
+    logging::info("net") << "connected";
+    logging::error() << "failed";
+    sink::flush();
+
+    auto messages = daemon.receive();
+    REQUIRE(messages.size() == 2);
+
+    const std::string pid = std::to_string(::getpid());
+    const std::string timestamp = "\\d{4}-\\d\\d-\\d\\dT\\d\\d:\\d\\d:\\d\\d\\.\\d{6}Z";
+
+    REQUIRE(std::regex_match(messages[0], std::regex("<14>1 " + timestamp +
+                                                     " \\S+ nitro_test " + pid +
+                                                     " net - connected")));
+    REQUIRE(std::regex_match(messages[1], std::regex("<11>1 " + timestamp +
+                                                     " \\S+ nitro_test " + pid + " - - failed")));
+
+    REQUIRE(sink::sent() == 2);
+    REQUIRE(sink::dropped() == 0);
+
+    // the daemon does not receive anything, until its socket buffer and the queue are full
+    for (int i = 0; i < 5000; ++i)
+    {
+        logging::info() << "message " << i;
+    }
+    sink::flush();
+
+    REQUIRE(sink::dropped() > 0);
+    REQUIRE(sink::sent() + sink::dropped() == 5002);
+    REQUIRE(daemon.receive().size() == sink::sent() - 2);
+}
@@ -0,0 +1,215 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include <nitro/log/attribute/severity.hpp>
+#include <nitro/log/attribute/timestamp.hpp>
+#include <nitro/log/filter/tag_severity_filter.hpp>
+#include <nitro/log/log.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace detail
+{
+
+// counts how many records are constructed
+class counting_attribute
+{
+public:
+    static int& constructed()
+    {
+        static int constructed_ = 0;
+        return constructed_;
+    }
+
+    counting_attribute()
+    {
+        ++constructed();
+    }
+};
+
+typedef nitro::log::record<nitro::log::tag_attribute, nitro::log::message_attribute,
+                           nitro::log::severity_attribute, nitro::log::timestamp_attribute,
+                           counting_attribute>
+    record;
+
+template <typename Record>
+class message_formater
+{
+public:
+    std::string format(Record& r)
+    {
+        return r.message();
+    }
+};
+
+class capturing_sink
+{
+public:
+    static std::vector<std::string>& records()
+    {
+        static std::vector<std::string> records_;
+        return records_;
+    }
+
+    void sink(nitro::log::severity_level, nitro::lang::string_ref formatted_record)
+    {
+        records().emplace_back(formatted_record);
+    }
+};
+
+template <typename Record>
+using log_filter = nitro::log::filter::tag_severity_filter<Record>;
+} // namespace detail
+
+using logging = nitro::log::logger<detail::record, detail::message_formater,
+                                   detail::capturing_sink, detail::log_filter>;
+
+using filter = detail::log_filter<detail::record>;
+using nitro::log::severity_level;
+
+TEST_CASE("Tag severity filter", "[log]")
+{
+    auto& records = detail::capturing_sink::records();
+    records.clear();
+
+    filter::set_severity(severity_level::info);
+
+    SECTION("uses the default severity for tags without their own")
+    {
+        logging::debug("other") << "dropped";
+        logging::info("other") << "kept";
+        logging::debug() << "dropped";
+
+        REQUIRE(records == std::vector<std::string>{ "kept" });
+    }
+
+    SECTION("uses the severity of the tag")
+    {
+        filter::set_severity("net", severity_level::debug);
+        filter::set_severity("db", severity_level::error);
+
+        logging::debug("net") << "net debug";
+        logging::trace("net") << "dropped";
+        logging::warn("db") << "dropped";
+        logging::error("db") << "db error";
+
+        REQUIRE(records == std::vector<std::string>{ "net debug", "db error" });
+        REQUIRE(filter::min_severity("net") == severity_level::debug);
+
+        filter::reset_severity("net");
+        filter::reset_severity("db");
+
+        REQUIRE(filter::min_severity("net") == severity_level::info);
+    }
+
+    SECTION("uses the severity of the tag for statements with a call site")
+    {
+        filter::set_severity("net", severity_level::debug);
+        filter::set_severity("db", severity_level::error);
+
+        // one statement, whose tag changes in place, so the cached tag has to be compared
+        for (const char* name : { "net", "db", "net", "cat", "db" })
+        {
+            std::string tag = name;
+            NITRO_LOG_TAG(logging, debug, tag) << name;
+        }
+
+        REQUIRE(records == std::vector<std::string>{ "net", "net" });
+
+        // tags without a severity of their own are not interned
+        REQUIRE(nitro::log::detail::tag_table::instance().find("cat") ==
+                nitro::log::invalid_tag_id);
+
+        filter::reset_severity("net");
+        filter::reset_severity("db");
+    }
+
+    SECTION("rejects statements before their record is constructed")
+    {
+        auto before = detail::counting_attribute::constructed();
+
+        logging::debug("a tag which is too long for the small string optimization") << "dropped";
+
+        REQUIRE(detail::counting_attribute::constructed() == before);
+
+        logging::info("a tag which is too long for the small string optimization") << "kept";
+
+        REQUIRE(detail::counting_attribute::constructed() == before + 1);
+    }
+
+    SECTION("can be configured with a string")
+    {
+        filter::configure(" warn, net = trace ,db=ERROR");
+
+        REQUIRE(filter::min_severity() == severity_level::warn);
+        REQUIRE(filter::min_severity("net") == severity_level::trace);
+        REQUIRE(filter::min_severity("db") == severity_level::error);
+
+        filter::reset_severity("net");
+        filter::reset_severity("db");
+    }
+
+    SECTION("does not apply broken configurations")
+    {
+        REQUIRE_THROWS(filter::configure("net=debug,db=loud"));
+        REQUIRE_THROWS(filter::configure("=debug"));
+
+        REQUIRE(filter::min_severity("net") == severity_level::info);
+    }
+
+    SECTION("can be configured from the environment")
+    {
+#ifdef _WIN32
+        _putenv_s("NITRO_LOG_TEST", "error,env=debug");
+#else
+        setenv("NITRO_LOG_TEST", "error,env=debug", 1);
+#endif
+        filter::configure_from_env("NITRO_LOG_TEST");
+
+        REQUIRE(filter::min_severity() == severity_level::error);
+        REQUIRE(filter::min_severity("env") == severity_level::debug);
+
+        filter::reset_severity("env");
+    }
+
+    SECTION("can be changed while other threads log")
+    {
+        std::atomic<bool> done{ false };
+
+        std::thread changer([&done]() {
+            for (int i = 0; i < 1000; ++i)
+            {
+                filter::set_severity("threaded",
+                                     i % 2 ? severity_level::trace : severity_level::fatal);
+            }
+            done = true;
+        });
+
+        while (!done)
+        {
+            logging::debug("threaded") << "maybe";
+        }
+        changer.join();
+
+        for (const auto& record : records)
+        {
+            REQUIRE(record == "maybe");
+        }
+
+        filter::reset_severity("threaded");
+    }
+}
+
+TEST_CASE("Tags are interned", "[log]")
+{
+    auto id = nitro::log::intern_tag("interned");
+
+    REQUIRE(id != nitro::log::invalid_tag_id);
+    REQUIRE(nitro::log::intern_tag(std::string("interned")) == id);
+    REQUIRE(nitro::log::detail::tag_table::instance().name(id) == "interned");
+    REQUIRE(nitro::log::intern_tag("") == nitro::log::invalid_tag_id);
+}
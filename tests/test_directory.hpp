@@ -0,0 +1,66 @@
+#ifndef NITRO_TESTS_TEST_DIRECTORY_HPP
+#define NITRO_TESTS_TEST_DIRECTORY_HPP
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+extern "C"
+{
+#include <ftw.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+}
+
+namespace detail
+{
+
+inline void remove_directory_at_exit();
+
+// the process, which created the directory
+inline pid_t directory_owner()
+{
+    static pid_t owner = getpid();
+    return owner;
+}
+
+// a directory under /tmp for the files of a test, it is removed with its content at exit
+inline const std::string& directory()
+{
+    // never destroyed, so it is still known when the directory is removed
+    static const std::string* directory_ = []() {
+        char name[] = "/tmp/nitro_test_XXXXXX";
+        auto path = new std::string(mkdtemp(name));
+
+        directory_owner();
+        std::atexit(&remove_directory_at_exit);
+        return path;
+    }();
+    return *directory_;
+}
+
+inline int remove_entry(const char* path, const struct stat*, int, struct FTW*)
+{
+    return std::remove(path);
+}
+
+inline void remove_directory_at_exit()
+{
+    // forked children of the tests exit as well, but must not remove it
+    if (getpid() == directory_owner())
+    {
+        nftw(directory().c_str(), &remove_entry, 16, FTW_DEPTH | FTW_PHYS);
+    }
+}
+
+inline std::string read(const std::string& path)
+{
+    std::ifstream file(path);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+} // namespace detail
+
+#endif // NITRO_TESTS_TEST_DIRECTORY_HPP
@@ -0,0 +1,183 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include <nitro/log/attribute/severity.hpp>
+#include <nitro/log/attribute/timestamp.hpp>
+#include <nitro/log/filter/null_filter.hpp>
+#include <nitro/log/log.hpp>
+#include <nitro/log/sink/sequence.hpp>
+#include <nitro/log/sink/thread_buffered.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace detail
+{
+
+typedef nitro::log::record<nitro::log::message_attribute, nitro::log::severity_attribute,
+                           nitro::log::timestamp_clock_attribute<std::chrono::steady_clock>>
+    record;
+
+// "<timestamp> <message>\n"
+template <typename Record>
+class timestamp_formater
+{
+public:
+    std::string format(Record& r)
+    {
+        return std::to_string(r.timestamp().time_since_epoch().count()) + " " +
+               r.message().str() + "\n";
+    }
+};
+
+template <unsigned N>
+class collecting_sink
+{
+public:
+    static std::mutex& mutex()
+    {
+        static std::mutex mutex_;
+        return mutex_;
+    }
+
+    static std::vector<std::string>& writes()
+    {
+        static std::vector<std::string> writes_;
+        return writes_;
+    }
+
+    static std::vector<std::string> lines()
+    {
+        std::lock_guard<std::mutex> lock(mutex());
+
+        std::vector<std::string> result;
+        for (const auto& write : writes())
+        {
+            std::istringstream s(write);
+            for (std::string line; std::getline(s, line);)
+            {
+                result.push_back(line);
+            }
+        }
+        return result;
+    }
+
+    void sink(nitro::log::severity_level, nitro::lang::string_ref formatted_record)
+    {
+        std::lock_guard<std::mutex> lock(mutex());
+        writes().emplace_back(formatted_record);
+    }
+};
+
+template <unsigned N>
+using buffered = nitro::log::sink::thread_buffered<collecting_sink<N>>;
+
+template <typename Sink>
+using logging =
+    nitro::log::logger<record, timestamp_formater, Sink, nitro::log::filter::null_filter>;
+
+std::int64_t timestamp_of(const std::string& line)
+{
+    return std::stoll(line.substr(0, line.find(' ')));
+}
+
+template <typename Predicate>
+bool eventually(Predicate p)
+{
+    for (int i = 0; i < 500; ++i)
+    {
+        if (p())
+        {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+}
+} // namespace detail
+
+using nitro::log::severity_level;
+
+TEST_CASE("Thread buffered sink merges the records of all threads by timestamp", "[log]")
+{
+    using sink = detail::buffered<0>;
+    sink::config().max_staleness = std::chrono::hours(1);
+    sink::config().buffer_size = 1 << 30;
+
+    const int thread_count = 8;
+    const int records = 200;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_count; ++t)
+    {
+        threads.emplace_back([t]() {
+            for (int i = 0; i < records; ++i)
+            {
+                detail::logging<sink>::info() << "thread " << t << " record " << i;
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    // nothing was written yet, as all records are below the flush severity
+    REQUIRE(detail::collecting_sink<0>::lines().empty());
+
+    sink::flush();
+
+    // written at once, although the threads are gone already
+    REQUIRE(detail::collecting_sink<0>::writes().size() == 1);
+
+    auto lines = detail::collecting_sink<0>::lines();
+    REQUIRE(lines.size() == thread_count * records);
+
+    for (std::size_t i = 1; i < lines.size(); ++i)
+    {
+        REQUIRE(detail::timestamp_of(lines[i - 1]) <= detail::timestamp_of(lines[i]));
+    }
+}
+
+TEST_CASE("Thread buffered sink writes severe records right away", "[log]")
+{
+    using sink = detail::buffered<1>;
+    sink::config().max_staleness = std::chrono::hours(1);
+
+    detail::logging<sink>::info() << "first";
+    detail::logging<sink>::error() << "second";
+
+    auto lines = detail::collecting_sink<1>::lines();
+    REQUIRE(lines.size() == 2);
+    REQUIRE(lines[0].substr(lines[0].find(' ')) == " first");
+    REQUIRE(lines[1].substr(lines[1].find(' ')) == " second");
+}
+
+TEST_CASE("Thread buffered sink writes records after the maximum staleness", "[log]")
+{
+    using sink = detail::buffered<2>;
+    sink::config().max_staleness = std::chrono::milliseconds(10);
+
+    detail::logging<sink>::info() << "eventually";
+
+    REQUIRE(detail::eventually([]() { return detail::collecting_sink<2>::lines().size() == 1; }));
+}
+
+TEST_CASE("Thread buffered sink gets the record through a sequence", "[log]")
+{
+    using sink = detail::buffered<3>;
+    sink::config().max_staleness = std::chrono::hours(1);
+
+    detail::logging<nitro::log::sink::sequence<sink, detail::collecting_sink<4>>>::info()
+        << "both";
+
+    REQUIRE(detail::collecting_sink<4>::lines().size() == 1);
+
+    sink::flush();
+    REQUIRE(detail::collecting_sink<3>::lines().size() == 1);
+}
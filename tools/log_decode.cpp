@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Prints a binary log written with nitro::log::formatter::binary_formatter as text. With --ring,
+ * the file is a ring buffer written by nitro::log::sink::mmap_ring.
+ *
+ * usage: nitro-log-decode [--ring] <file>
+ */
+
+#include <nitro/log/formatter/binary_decoder.hpp>
+#include <nitro/log/sink/mmap_ring_reader.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+int main(int argc, char** argv)
+{
+    bool ring = argc == 3 && std::strcmp(argv[1], "--ring") == 0;
+
+    if (argc != 2 && !ring)
+    {
+        std::fprintf(stderr, "usage: %s [--ring] <file>\n", argv[0]);
+        return 2;
+    }
+
+    const std::string path = argv[argc - 1];
+
+    try
+    {
+        std::string data;
+
+        if (ring)
+        {
+            nitro::log::sink::mmap_ring_reader reader(path);
+            reader.for_each([&data](const std::string& record) { data += record; });
+        }
+        else
+        {
+            std::ifstream file(path, std::ios::binary);
+            if (!file)
+            {
+                std::fprintf(stderr, "%s: cannot open %s\n", argv[0], path.c_str());
+                return 1;
+            }
+            data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+
+        nitro::log::formatter::binary_decoder decoder;
+        decoder.define(data.data(), data.size());
+
+        auto read = decoder.decode(data.data(), data.size(), std::cout);
+        if (read != data.size())
+        {
+            std::fprintf(stderr, "%s: ignored %zu bytes of an incomplete record at the end\n",
+                         argv[0], data.size() - read);
+        }
+    }
+    catch (std::exception& e)
+    {
+        std::fprintf(stderr, "%s: %s\n", argv[0], e.what());
+        return 1;
+    }
+
+    return 0;
+}
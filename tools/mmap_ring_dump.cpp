@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Prints the records of a ring buffer file written by nitro::log::sink::mmap_ring in the order
+ * they were written.
+ *
+ * usage: nitro-mmap-ring-dump [--info] <file>
+ */
+
+#include <nitro/log/sink/mmap_ring_reader.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <string>
+
+int main(int argc, char** argv)
+{
+    bool info = argc == 3 && std::strcmp(argv[1], "--info") == 0;
+
+    if (argc != 2 && !info)
+    {
+        std::fprintf(stderr, "usage: %s [--info] <file>\n", argv[0]);
+        return 2;
+    }
+
+    try
+    {
+        nitro::log::sink::mmap_ring_reader reader(argv[argc - 1]);
+
+        if (info)
+        {
+            std::printf("capacity:       %llu\n",
+                        static_cast<unsigned long long>(reader.capacity()));
+            std::printf("write position: %llu\n",
+                        static_cast<unsigned long long>(reader.write_position()));
+            std::printf("wraps:          %llu\n",
+                        static_cast<unsigned long long>(reader.wraps()));
+            std::printf("records:        %zu\n", reader.records().size());
+            return 0;
+        }
+
+        reader.for_each([](const std::string& record) {
+            std::fwrite(record.data(), 1, record.size(), stdout);
+            if (!record.empty() && record.back() != '\n')
+            {
+                std::fputc('\n', stdout);
+            }
+        });
+    }
+    catch (std::exception& e)
+    {
+        std::fprintf(stderr, "%s: %s\n", argv[0], e.what());
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Merges the per-rank files written by nitro::log::sink::rank_file into one time-ordered view,
+ * where every record is prefixed with its rank. With --collapse, records with the same text of
+ * different ranks within --window milliseconds are printed once, with all their ranks.
+ *
+ * usage: nitro-rank-merge [--collapse] [--window <ms>] <file>...
+ */
+
+#include <nitro/log/sink/rank_file_merge.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char** argv)
+{
+    bool collapse = false;
+    long window = 1000;
+    std::vector<std::string> paths;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--collapse") == 0)
+        {
+            collapse = true;
+        }
+        else if (std::strcmp(argv[i], "--window") == 0 && i + 1 < argc)
+        {
+            window = std::strtol(argv[++i], nullptr, 10);
+        }
+        else
+        {
+            paths.emplace_back(argv[i]);
+        }
+    }
+
+    if (paths.empty() || window < 0)
+    {
+        std::fprintf(stderr, "usage: %s [--collapse] [--window <ms>] <file>...\n", argv[0]);
+        return 2;
+    }
+
+    try
+    {
+        nitro::log::sink::rank_file_merge merge(paths);
+        if (collapse)
+        {
+            merge.collapse(std::chrono::milliseconds(window));
+        }
+
+        std::ios::sync_with_stdio(false);
+        merge.write(std::cout);
+    }
+    catch (std::exception& e)
+    {
+        std::fprintf(stderr, "%s: %s\n", argv[0], e.what());
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2026, Technische Universität Dresden, Germany
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Collects the records of all processes on this host, which log with
+ * nitro::log::sink::shm_ring, and appends them to one file, ordered by their timestamps. Runs
+ * until it gets SIGINT or SIGTERM, then collects a last time.
+ *
+ * usage: nitro-shm-ring-collector [--prefix <prefix>] [--interval <ms>] <file>
+ */
+
+#include <nitro/log/sink/shm_ring_collector.hpp>
+
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <string>
+#include <thread>
+
+namespace
+{
+volatile std::sig_atomic_t stop = 0;
+
+void handle_signal(int)
+{
+    stop = 1;
+}
+
+class file_sink
+{
+public:
+    explicit file_sink(std::FILE* file) : file_(file)
+    {
+    }
+
+    void sink(nitro::log::severity_level, nitro::lang::string_ref formatted_record)
+    {
+        std::fwrite(formatted_record.get(), 1, formatted_record.size(), file_);
+    }
+
+private:
+    std::FILE* file_;
+};
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::string prefix = "nitro-log";
+    long interval = 100;
+    const char* path = nullptr;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--prefix") == 0 && i + 1 < argc)
+        {
+            prefix = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--interval") == 0 && i + 1 < argc)
+        {
+            interval = std::strtol(argv[++i], nullptr, 10);
+        }
+        else if (path == nullptr && argv[i][0] != '-')
+        {
+            path = argv[i];
+        }
+        else
+        {
+            path = nullptr;
+            break;
+        }
+    }
+
+    if (path == nullptr || interval <= 0)
+    {
+        std::fprintf(stderr, "usage: %s [--prefix <prefix>] [--interval <ms>] <file>\n",
+                     argv[0]);
+        return 2;
+    }
+
+    std::FILE* file = std::fopen(path, "a");
+    if (file == nullptr)
+    {
+        std::fprintf(stderr, "%s: cannot open %s: %s\n", argv[0], path, std::strerror(errno));
+        return 1;
+    }
+
+    std::signal(SIGINT, handle_signal);
+    std::signal(SIGTERM, handle_signal);
+
+    try
+    {
+        nitro::log::sink::shm_ring_collector collector(prefix);
+        file_sink sink(file);
+
+        while (!stop)
+        {
+            if (collector.collect(sink) > 0)
+            {
+                std::fflush(file);
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(interval));
+        }
+
+        collector.collect(sink);
+
+        if (collector.dropped() > 0)
+        {
+            std::fprintf(stderr, "%s: the processes dropped %llu records\n", argv[0],
+                         static_cast<unsigned long long>(collector.dropped()));
+        }
+    }
+    catch (std::exception& e)
+    {
+        std::fprintf(stderr, "%s: %s\n", argv[0], e.what());
+        std::fclose(file);
+        return 1;
+    }
+
+    std::fclose(file);
+    return 0;
+}